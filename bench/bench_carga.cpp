@@ -0,0 +1,134 @@
+/**
+ * Benchmark da leitura da entrada (fase de carga)
+ *
+ * Gera um arquivo de endereços no formato da entrada e mede a vazão (MB/s):
+ *   - leitura crua do arquivo com read() em blocos: o teto da carga;
+ *   - getline + trim + dividirString + trim por campo (carga original);
+ *   - LeitorEntrada + interpretarEndereco (visões, sem cópia por linha).
+ * Todos interpretam os mesmos campos (IdLog, nome, latitude e longitude).
+ *
+ * Uso: bin/bench_carga.out [linhas]
+ */
+
+#include "leitor_entrada.hpp"
+#include "utils.hpp"
+#include "cronometro.hpp"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+static const char* CAMINHO_ENTRADA = "/tmp/bench_carga.csv";
+
+static void gerarEntrada(int numLinhas) {
+    srand(11);
+    std::ofstream saida(CAMINHO_ENTRADA);
+    const char* tipos[] = {"RUA", "AVENIDA", "TRAVESSA", "BECO"};
+    const char* nomes[] = {"AFONSO PENA", "DE GOIAS", "SAO JOSE", "MARIA DA SILVA"};
+    for (int i = 0; i < numLinhas; i++) {
+        int idLog = 1 + rand() % (numLinhas / 4 + 1);
+        char linha[256];
+        std::snprintf(linha, sizeof(linha), "%d;%d;%s;%s W%d;%d;BAIRRO;REGIAO;%d;%.6f;%.6f\n",
+                      i, idLog, tipos[idLog % 4], nomes[idLog % 4], idLog, rand() % 3000,
+                      30000000 + rand() % 9999999,
+                      -20.0 + (rand() % 1000000) / 1e6, -44.0 + (rand() % 1000000) / 1e6);
+        saida << linha;
+    }
+}
+
+static long long tamanhoArquivo() {
+    std::ifstream entrada(CAMINHO_ENTRADA, std::ios::binary | std::ios::ate);
+    return static_cast<long long>(entrada.tellg());
+}
+
+static double lerCru() {
+    Cronometro cronometro;
+    int descritor = open(CAMINHO_ENTRADA, O_RDONLY);
+    char* buffer = new char[TAMANHO_BLOCO_LEITURA];
+    long long soma = 0;
+    ssize_t lidos;
+    while ((lidos = read(descritor, buffer, TAMANHO_BLOCO_LEITURA)) > 0) {
+        soma += buffer[lidos - 1];
+    }
+    naoOtimizar(soma);
+    delete[] buffer;
+    close(descritor);
+    return cronometro.decorridoNs();
+}
+
+static double lerOriginal() {
+    Cronometro cronometro;
+    std::ifstream entrada(CAMINHO_ENTRADA);
+    std::string linha;
+    double soma = 0.0;
+    while (std::getline(entrada, linha)) {
+        linha = trim(linha);
+        int numCampos = 0;
+        std::string* campos = dividirString(linha, ';', numCampos);
+        if (numCampos == 10) {
+            std::string idLog = trim(campos[1]);
+            std::string nome = trim(campos[3]);
+            soma += stringParaDouble(trim(campos[8])) + stringParaDouble(trim(campos[9]));
+            soma += idLog.size() + nome.size();
+        }
+        delete[] campos;
+    }
+    naoOtimizar(soma);
+    return cronometro.decorridoNs();
+}
+
+static double lerVisoes() {
+    Cronometro cronometro;
+    int descritor = open(CAMINHO_ENTRADA, O_RDONLY);
+    double soma = 0.0;
+    {
+        LeitorEntrada leitor(descritor);
+        VisaoTexto linha;
+        CamposEndereco endereco;
+        while (leitor.proximaLinha(linha)) {
+            if (interpretarEndereco(linha, endereco)) {
+                soma += endereco.lat + endereco.lon;
+                soma += endereco.idLog.tamanho + endereco.nome.tamanho;
+            }
+        }
+    }
+    naoOtimizar(soma);
+    close(descritor);
+    return cronometro.decorridoNs();
+}
+
+static void reportar(const char* nome, double (*medir)(), long long bytes) {
+    double tempos[5];
+    for (int r = 0; r < 5; r++) {
+        tempos[r] = medir();
+    }
+    double ns = mediana(tempos, 5);
+    std::cout << "leitor=" << nome << " ms=" << ns / 1e6
+              << " MB/s=" << (bytes / 1e6) / (ns / 1e9) << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    int numLinhas = 1000000;
+    if (argc > 2 || (argc == 2 && (!converterInteiro(argv[1], static_cast<int>(std::strlen(argv[1])),
+                                                     numLinhas) || numLinhas <= 0))) {
+        std::cerr << "Uso: " << argv[0] << " [linhas]" << std::endl;
+        return 1;
+    }
+    gerarEntrada(numLinhas);
+    long long bytes = tamanhoArquivo();
+    std::cout << "linhas=" << numLinhas << " bytes=" << bytes << std::endl;
+
+    // Primeira leitura só para o arquivo estar no cache de páginas
+    lerCru();
+
+    reportar("cru", lerCru, bytes);
+    reportar("original", lerOriginal, bytes);
+    reportar("visoes", lerVisoes, bytes);
+
+    std::remove(CAMINHO_ENTRADA);
+    return 0;
+}
\ No newline at end of file
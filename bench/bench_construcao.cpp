@@ -0,0 +1,123 @@
+/**
+ * Benchmark da construção do índice invertido
+ *
+ * Compara a construção incremental (inserção ordenada em ListaInteiros a cada
+ * ocorrência) com a construção em lote (coleta de pares + radix sort + CSR).
+ * Simula palavras muito frequentes ("RUA", "DE"), cujas listas são longas.
+ * Também reporta a memória das listas comprimidas do índice congelado e o
+ * tempo de destruição do índice e de um Mapa<std::string, int> com uma chave
+ * por logradouro (como o agrupamento de main).
+ *
+ * Uso: bin/bench_construcao.out
+ */
+
+#include "palavra.hpp"
+#include "logradouro.hpp"
+#include "tabela_logradouros.hpp"
+#include "mapa.hpp"
+#include "cronometro.hpp"
+#include <iostream>
+#include <string>
+#include <cstdlib>
+
+static const char* PALAVRAS[] = {"RUA", "DE", "DA", "SAO", "JOSE", "MARIA", "PENA", "AFONSO"};
+
+static double construir(ModoConstrucao modo, BackendDicionario backend, int numLinhas,
+                        int numLogradouros, TabelaLogradouros* tabela,
+                        long long& memoriaPostings, double& msDestruicao) {
+    srand(7);
+    Cronometro cronometro;
+    Palavra* indice = new Palavra(modo, backend);
+    for (int i = 0; i < numLinhas; i++) {
+        int idLog = 1 + rand() % numLogradouros;
+        // Três palavras por linha, com viés para as primeiras (mais frequentes);
+        // um sufixo raro por linha povoa o dicionário com muitos termos
+        for (int p = 0; p < 3; p++) {
+            int w = (rand() % 8) * (rand() % 8) / 8;
+            indice->adicionarLogradouro(PALAVRAS[w], idLog);
+        }
+        indice->adicionarLogradouro("W" + std::to_string(idLog), idLog);
+    }
+    indice->congelar(tabela);
+    double ms = cronometro.decorridoNs() / 1e6;
+    memoriaPostings = indice->getMemoriaPostings();
+    naoOtimizar(*indice);
+
+    Cronometro cronometroDestruicao;
+    delete indice;
+    msDestruicao = cronometroDestruicao.decorridoNs() / 1e6;
+    return ms;
+}
+
+static double construirMapa(int numChaves, double& msBusca, double& msDestruicao) {
+    Cronometro cronometro;
+    Mapa<std::string, int>* mapa = new Mapa<std::string, int>();
+    for (int i = 0; i < numChaves; i++) {
+        mapa->inserir(std::to_string((i * 7919) % numChaves + 1), i);
+    }
+    double ms = cronometro.decorridoNs() / 1e6;
+
+    // Uma busca por chave, na ordem em que as linhas da entrada as repetem
+    Cronometro cronometroBusca;
+    long long soma = 0;
+    for (int i = 0; i < numChaves; i++) {
+        const int* valor = mapa->buscar(std::to_string((i * 104729LL) % numChaves + 1));
+        soma += valor != nullptr ? *valor : 0;
+    }
+    msBusca = cronometroBusca.decorridoNs() / 1e6;
+    naoOtimizar(soma);
+
+    Cronometro cronometroDestruicao;
+    delete mapa;
+    msDestruicao = cronometroDestruicao.decorridoNs() / 1e6;
+    return ms;
+}
+
+int main() {
+    const int linhas[] = {2000, 8000, 32000, 128000, 512000};
+
+    for (int c = 0; c < 5; c++) {
+        int numLinhas = linhas[c];
+        int numLogradouros = numLinhas / 4;
+
+        Logradouro** logradouros = new Logradouro*[numLogradouros];
+        for (int i = 0; i < numLogradouros; i++) {
+            logradouros[i] = new Logradouro(std::to_string(i + 1), "RUA", 0.0, 0.0, 1);
+        }
+        TabelaLogradouros tabela(logradouros, numLogradouros);
+
+        long long memoria = 0;
+        double destruicao = 0.0;
+        double lote = construir(CONSTRUCAO_EM_LOTE, DICIONARIO_HASH, numLinhas, numLogradouros,
+                                &tabela, memoria, destruicao);
+        std::cout << "linhas=" << numLinhas << " modo=lote ms=" << lote
+                  << " bytes_postings=" << memoria
+                  << " ms_destruicao=" << destruicao << std::endl;
+
+        double loteAvl = construir(CONSTRUCAO_EM_LOTE, DICIONARIO_AVL, numLinhas, numLogradouros,
+                                   &tabela, memoria, destruicao);
+        std::cout << "linhas=" << numLinhas << " modo=lote_avl ms=" << loteAvl
+                  << " ms_destruicao=" << destruicao << std::endl;
+
+        // O modo incremental é quadrático: só é medido nas entradas menores
+        if (numLinhas <= 32000) {
+            double incremental = construir(CONSTRUCAO_INCREMENTAL, DICIONARIO_HASH, numLinhas,
+                                           numLogradouros, &tabela, memoria, destruicao);
+            std::cout << "linhas=" << numLinhas << " modo=incremental ms=" << incremental
+                      << " ms_destruicao=" << destruicao << std::endl;
+        }
+
+        double busca = 0.0;
+        double mapa = construirMapa(numLogradouros, busca, destruicao);
+        std::cout << "linhas=" << numLinhas << " mapa chaves=" << numLogradouros
+                  << " ms=" << mapa << " ms_busca=" << busca
+                  << " ms_destruicao=" << destruicao << std::endl;
+
+        for (int i = 0; i < numLogradouros; i++) {
+            delete logradouros[i];
+        }
+        delete[] logradouros;
+    }
+
+    return 0;
+}
\ No newline at end of file
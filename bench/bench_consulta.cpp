@@ -0,0 +1,93 @@
+/**
+ * Benchmark da fase de consulta (Consulta::executar)
+ *
+ * Varia o número total de logradouros e o número de candidatos da consulta
+ * de forma independente. Com a tabela densa de logradouros o custo por
+ * consulta deve acompanhar o número de candidatos, e não o total.
+ *
+ * A consulta "ALVO COMUM" combina a palavra rara com uma que ocorre em todos
+ * os logradouros, como "RUA": a interseção deve ser conduzida pela lista rara.
+ * A consulta "COMUM" casa com todos os logradouros: com a grade espacial, o
+ * custo deve depender de R e não do número de logradouros.
+ * Os últimos casos fixam os candidatos e aumentam R.
+ *
+ * Uso: bin/bench_consulta.out
+ */
+
+#include "consulta.hpp"
+#include "palavra.hpp"
+#include "logradouro.hpp"
+#include "tabela_logradouros.hpp"
+#include "cronometro.hpp"
+#include <iostream>
+#include <string>
+#include <cstdlib>
+
+static void executarCaso(int numLogradouros, int numCandidatos, int maxRespostas) {
+    srand(42);
+
+    Logradouro** logradouros = new Logradouro*[numLogradouros];
+    for (int i = 0; i < numLogradouros; i++) {
+        double lat = -20.0 + (rand() % 100000) / 100000.0;
+        double lon = -44.0 + (rand() % 100000) / 100000.0;
+        logradouros[i] = new Logradouro(std::to_string(i + 1), "RUA " + std::to_string(i + 1),
+                                        lat, lon, 1);
+    }
+
+    // A palavra ALVO ocorre em numCandidatos logradouros espalhados pela faixa de ids
+    // e a palavra COMUM ocorre em todos
+    Palavra indice(CONSTRUCAO_EM_LOTE);
+    int passo = numLogradouros / numCandidatos;
+    for (int c = numCandidatos - 1; c >= 0; c--) {
+        indice.adicionarLogradouro("ALVO", c * passo + 1);
+    }
+    for (int i = 0; i < numLogradouros; i++) {
+        indice.adicionarLogradouro("COMUM", i + 1);
+    }
+
+    TabelaLogradouros tabela(logradouros, numLogradouros);
+    indice.congelar(&tabela);
+    AreaTrabalhoConsulta area;
+
+    const char* textos[] = {"ALVO", "ALVO COMUM", "COMUM"};
+    for (int q = 0; q < 3; q++) {
+        Consulta consulta(0, textos[q], -19.5, -43.5, maxRespostas);
+
+        double ns = medirNsPorChamada([&]() {
+            int tamanho = 0;
+            const Candidato* resultado = consulta.executar(&indice, &tabela, -19.5, -43.5,
+                                                           tamanho, area);
+            naoOtimizar(resultado);
+        }, 20);
+
+        std::cout << "consulta=\"" << textos[q] << "\""
+                  << " logradouros=" << numLogradouros
+                  << " candidatos=" << numCandidatos
+                  << " R=" << maxRespostas
+                  << " us_por_consulta=" << ns / 1000.0 << std::endl;
+    }
+
+    for (int i = 0; i < numLogradouros; i++) {
+        delete logradouros[i];
+    }
+    delete[] logradouros;
+}
+
+int main() {
+    const int totais[] = {10000, 100000, 1000000};
+    const int candidatos[] = {16, 256, 4096};
+
+    for (int t = 0; t < 3; t++) {
+        for (int c = 0; c < 3; c++) {
+            executarCaso(totais[t], candidatos[c], 10);
+        }
+    }
+
+    // R grande: o custo passa a ser dominado pela seleção dos R melhores
+    const int respostas[] = {100, 1000, 4000};
+    for (int r = 0; r < 3; r++) {
+        executarCaso(100000, 4096, respostas[r]);
+    }
+
+    return 0;
+}
\ No newline at end of file
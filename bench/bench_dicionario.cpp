@@ -0,0 +1,112 @@
+/**
+ * Micro-benchmark do dicionário de termos: AVL x tabela de dispersão
+ *
+ * Mede a latência de busca (Palavra::buscarIdTermo) com cada backend sobre
+ * o vocabulário real, extraído de um arquivo de entrada no formato do
+ * programa principal. Sem arquivo, usa um vocabulário sintético.
+ *
+ * Uso: bin/bench_dicionario.out [arquivo_de_entrada]
+ */
+
+#include "palavra.hpp"
+#include "utils.hpp"
+#include "cronometro.hpp"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstdlib>
+
+/**
+ * Lê as palavras dos nomes de logradouros (quarto campo) do arquivo de entrada
+ */
+static void lerVocabulario(const char* caminho, DinamicoArray<std::string>& palavras) {
+    std::ifstream arquivo(caminho);
+    int n = 0;
+    arquivo >> n;
+    arquivo.ignore();
+
+    std::string linha;
+    for (int i = 0; i < n && std::getline(arquivo, linha); i++) {
+        int numCampos = 0;
+        std::string* campos = dividirString(trim(linha), ';', numCampos);
+        if (campos == nullptr) {
+            continue;
+        }
+        if (numCampos == 10) {
+            int numPalavras = 0;
+            std::string* nome = dividirString(trim(campos[3]), ' ', numPalavras);
+            for (int j = 0; nome != nullptr && j < numPalavras; j++) {
+                std::string palavra = trim(nome[j]);
+                if (!palavra.empty()) {
+                    palavras.push_back(palavra);
+                }
+            }
+            delete[] nome;
+        }
+        delete[] campos;
+    }
+}
+
+static void gerarVocabulario(int numTermos, DinamicoArray<std::string>& palavras) {
+    srand(3);
+    for (int i = 0; i < numTermos; i++) {
+        std::string palavra;
+        int tamanho = 3 + rand() % 9;
+        for (int c = 0; c < tamanho; c++) {
+            palavra += static_cast<char>('A' + rand() % 26);
+        }
+        palavras.push_back(palavra);
+    }
+}
+
+static void medir(const char* nome, BackendDicionario backend,
+                  const DinamicoArray<std::string>& palavras,
+                  const DinamicoArray<std::string>& consultas) {
+    Cronometro construcao;
+    Palavra indice(CONSTRUCAO_EM_LOTE, backend);
+    for (int i = 0; i < palavras.size(); i++) {
+        indice.adicionarLogradouro(palavras[i], i);
+    }
+    double msConstrucao = construcao.decorridoNs() / 1e6;
+
+    int idx = 0;
+    double ns = medirNsPorChamada([&]() {
+        int id = indice.buscarIdTermo(consultas[idx]);
+        naoOtimizar(id);
+        idx = idx + 1 == consultas.size() ? 0 : idx + 1;
+    }, consultas.size());
+
+    std::cout << "backend=" << nome
+              << " termos=" << indice.getNumPalavras()
+              << " ms_construcao=" << msConstrucao
+              << " ns_por_busca=" << ns << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    DinamicoArray<std::string> palavras;
+    if (argc > 1) {
+        lerVocabulario(argv[1], palavras);
+    } else {
+        gerarVocabulario(200000, palavras);
+    }
+
+    if (palavras.empty()) {
+        std::cerr << "Vocabulario vazio" << std::endl;
+        return 1;
+    }
+
+    // Consultas: ocorrências em ordem aleatória (acertos) + 10% de palavras ausentes
+    srand(11);
+    DinamicoArray<std::string> consultas;
+    for (int i = 0; i < palavras.size(); i++) {
+        if (rand() % 10 == 0) {
+            consultas.push_back(palavras[rand() % palavras.size()] + "#");
+        } else {
+            consultas.push_back(palavras[rand() % palavras.size()]);
+        }
+    }
+
+    medir("avl", DICIONARIO_AVL, palavras, consultas);
+    medir("hash", DICIONARIO_HASH, palavras, consultas);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,104 @@
+/**
+ * Benchmark do crescimento do DinamicoArray
+ *
+ * Insere n elementos um a um e compara, em ns por elemento:
+ *   - o crescimento original (new T[2 * capacidade] + atribuição de cada
+ *     elemento a cada duplicação);
+ *   - push_back do DinamicoArray (realloc para tipos trivialmente copiáveis,
+ *     movimentação para os demais);
+ *   - reserve(n) seguido de push_back (sem nenhuma realocação).
+ * Mede com int e com std::string longa (fora do buffer interno da string).
+ *
+ * Uso: bin/bench_dinamico_array.out [elementos]
+ */
+
+#include "dinamico_array.hpp"
+#include "utils.hpp"
+#include "cronometro.hpp"
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * Array como era antes, para comparação
+ */
+template<typename T>
+class ArrayOriginal {
+private:
+    T* dados;
+    int tamanho;
+    int capacidade;
+
+public:
+    ArrayOriginal() : dados(nullptr), tamanho(0), capacidade(0) {}
+
+    ~ArrayOriginal() {
+        delete[] dados;
+    }
+
+    void push_back(const T& valor) {
+        if (tamanho >= capacidade) {
+            int novaCapacidade = (capacidade == 0) ? 10 : capacidade * 2;
+            T* novosDados = new T[novaCapacidade];
+            for (int i = 0; i < tamanho; i++) {
+                novosDados[i] = dados[i];
+            }
+            delete[] dados;
+            dados = novosDados;
+            capacidade = novaCapacidade;
+        }
+        dados[tamanho++] = valor;
+    }
+
+    int size() const {
+        return tamanho;
+    }
+};
+
+template<typename T>
+static double medirOriginal(const T& valor, int n) {
+    return medirNsPorChamada([&]() {
+        ArrayOriginal<T> array;
+        for (int i = 0; i < n; i++) {
+            array.push_back(valor);
+        }
+        naoOtimizar(array);
+    }, 1, 1, 5) / n;
+}
+
+template<typename T>
+static double medirDinamico(const T& valor, int n, bool reservar) {
+    return medirNsPorChamada([&]() {
+        DinamicoArray<T> array;
+        if (reservar) {
+            array.reserve(n);
+        }
+        for (int i = 0; i < n; i++) {
+            array.push_back(valor);
+        }
+        naoOtimizar(array);
+    }, 1, 1, 5) / n;
+}
+
+template<typename T>
+static void medir(const char* tipo, const T& valor, int n) {
+    std::cout << "tipo=" << tipo << " n=" << n
+              << " original_ns=" << medirOriginal(valor, n)
+              << " push_back_ns=" << medirDinamico(valor, n, false)
+              << " reserve_ns=" << medirDinamico(valor, n, true) << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    int n = 1000000;
+    if (argc > 2 || (argc == 2 && (!converterInteiro(argv[1], static_cast<int>(std::strlen(argv[1])), n) ||
+                                   n <= 0))) {
+        std::cerr << "Uso: " << argv[0] << " [elementos]" << std::endl;
+        return 1;
+    }
+
+    medir("int", 42, n);
+    medir("string", std::string("RUA DESEMBARGADOR JORGE FONTANA 1234"), n / 4);
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,167 @@
+/**
+ * Benchmark dos kernels de distância em lote
+ *
+ * Compara os kernels escalar, AVX2 e AVX-512 (os suportados pela CPU) sobre
+ * slots espalhados numa tabela grande, com limite infinito (todos
+ * sobrevivem, como na seleção por partição) e com limites que deixam passar
+ * uma fração dos candidatos (heap cheia). Confere que todos produzem os
+ * mesmos slots e quadrados que o kernel escalar.
+ *
+ * Repete a comparação com os kernels da métrica geodésica (corda entre
+ * vetores unitários intercalados por slot: três gathers, mas uma só linha
+ * de cache por slot), com limites equivalentes em corda.
+ *
+ * Uso: bin/bench_distancias.out
+ */
+
+#include "distancias.hpp"
+#include "metrica.hpp"
+#include "cronometro.hpp"
+#include <iostream>
+#include <cstdlib>
+#include <limits>
+#include <cmath>
+
+int main() {
+    srand(7);
+
+    const int numLogradouros = 1 << 20;
+    const int numSlots = 1 << 16;
+    double* latitudes = new double[numLogradouros];
+    double* longitudes = new double[numLogradouros];
+    for (int i = 0; i < numLogradouros; i++) {
+        latitudes[i] = -20.0 + (rand() % 100000) / 100000.0;
+        longitudes[i] = -44.0 + (rand() % 100000) / 100000.0;
+    }
+
+    // Slots crescentes e espalhados, como os candidatos de uma interseção
+    int* slots = new int[numSlots];
+    int passo = numLogradouros / numSlots;
+    for (int i = 0; i < numSlots; i++) {
+        slots[i] = i * passo + rand() % passo;
+    }
+
+    KernelDistancia suportado = detectarKernelDistancia();
+    const char* nomes[] = {"escalar", "avx2", "avx512"};
+    typedef int (*FuncaoDistancias)(const double*, const double*, const int*, int,
+                                    double, double, double, int*, double*);
+    FuncaoDistancias funcoes[] = {filtrarDistanciasEscalar,
+                                  filtrarDistanciasAvx2,
+                                  filtrarDistanciasAvx512};
+
+    // Limites: todos, ~10% e ~1% da área em volta da origem
+    const double limites[] = {std::numeric_limits<double>::infinity(), 0.032, 0.0032};
+    const char* rotulos[] = {"infinito", "10%", "1%"};
+
+    int* saidaSlots = new int[TAMANHO_BLOCO_DISTANCIAS];
+    double* saidaQuadrados = new double[TAMANHO_BLOCO_DISTANCIAS];
+    int* referenciaSlots = new int[TAMANHO_BLOCO_DISTANCIAS];
+    double* referenciaQuadrados = new double[TAMANHO_BLOCO_DISTANCIAS];
+
+    for (int l = 0; l < 3; l++) {
+        for (int k = 0; k <= static_cast<int>(suportado); k++) {
+            bool correto = true;
+            long long sobreviventes = 0;
+            for (int b = 0; b < numSlots; b += TAMANHO_BLOCO_DISTANCIAS) {
+                int n = funcoes[k](latitudes, longitudes, slots + b, TAMANHO_BLOCO_DISTANCIAS,
+                                   -19.5, -43.5, limites[l], saidaSlots, saidaQuadrados);
+                int m = filtrarDistanciasEscalar(latitudes, longitudes, slots + b,
+                                                 TAMANHO_BLOCO_DISTANCIAS, -19.5, -43.5, limites[l],
+                                                 referenciaSlots, referenciaQuadrados);
+                correto = correto && n == m;
+                for (int i = 0; correto && i < n; i++) {
+                    correto = saidaSlots[i] == referenciaSlots[i] &&
+                              saidaQuadrados[i] == referenciaQuadrados[i];
+                }
+                sobreviventes += n;
+            }
+
+            double ns = medirNsPorChamada([&]() {
+                int total = 0;
+                for (int b = 0; b < numSlots; b += TAMANHO_BLOCO_DISTANCIAS) {
+                    total += funcoes[k](latitudes, longitudes, slots + b, TAMANHO_BLOCO_DISTANCIAS,
+                                        -19.5, -43.5, limites[l], saidaSlots, saidaQuadrados);
+                }
+                naoOtimizar(total);
+            }, 20);
+
+            std::cout << "kernel=" << nomes[k]
+                      << " limite=" << rotulos[l]
+                      << " slots=" << numSlots
+                      << " sobreviventes=" << sobreviventes
+                      << " ns_por_slot=" << ns / numSlots
+                      << (correto ? "" : " ERRO") << std::endl;
+        }
+    }
+
+    // Métrica geodésica: vetores unitários calculados uma vez, como na carga
+    double* vetores = new double[static_cast<long long>(numLogradouros) * COMPONENTES_VETOR];
+    for (int i = 0; i < numLogradouros; i++) {
+        double* vetor = vetores + static_cast<long long>(i) * COMPONENTES_VETOR;
+        MetricaGeodesica::vetorUnitario(latitudes[i], longitudes[i], vetor);
+        vetor[3] = 0.0;
+    }
+    double origem[3];
+    MetricaGeodesica::vetorUnitario(-19.5, -43.5, origem);
+
+    typedef int (*FuncaoDistanciasVetores)(const double*, const int*, int, const double*,
+                                           double, int*, double*);
+    FuncaoDistanciasVetores funcoesVetores[] = {filtrarDistanciasVetoresEscalar,
+                                                filtrarDistanciasVetoresAvx2,
+                                                filtrarDistanciasVetoresAvx512};
+    // Mesmas frações: quadrado da corda de um ângulo de sqrt(limite) graus
+    double limitesCorda[3];
+    for (int l = 0; l < 3; l++) {
+        double corda = MetricaGeodesica::cordaDoAngulo(std::sqrt(limites[l]));
+        limitesCorda[l] = corda * corda;
+    }
+
+    for (int l = 0; l < 3; l++) {
+        for (int k = 0; k <= static_cast<int>(suportado); k++) {
+            bool correto = true;
+            long long sobreviventes = 0;
+            for (int b = 0; b < numSlots; b += TAMANHO_BLOCO_DISTANCIAS) {
+                int n = funcoesVetores[k](vetores, slots + b,
+                                          TAMANHO_BLOCO_DISTANCIAS, origem, limitesCorda[l],
+                                          saidaSlots, saidaQuadrados);
+                int m = filtrarDistanciasVetoresEscalar(vetores, slots + b,
+                                                        TAMANHO_BLOCO_DISTANCIAS, origem,
+                                                        limitesCorda[l], referenciaSlots,
+                                                        referenciaQuadrados);
+                correto = correto && n == m;
+                for (int i = 0; correto && i < n; i++) {
+                    correto = saidaSlots[i] == referenciaSlots[i] &&
+                              saidaQuadrados[i] == referenciaQuadrados[i];
+                }
+                sobreviventes += n;
+            }
+
+            double ns = medirNsPorChamada([&]() {
+                int total = 0;
+                for (int b = 0; b < numSlots; b += TAMANHO_BLOCO_DISTANCIAS) {
+                    total += funcoesVetores[k](vetores, slots + b,
+                                               TAMANHO_BLOCO_DISTANCIAS, origem, limitesCorda[l],
+                                               saidaSlots, saidaQuadrados);
+                }
+                naoOtimizar(total);
+            }, 20);
+
+            std::cout << "kernel=" << nomes[k] << "_geodesica"
+                      << " limite=" << rotulos[l]
+                      << " slots=" << numSlots
+                      << " sobreviventes=" << sobreviventes
+                      << " ns_por_slot=" << ns / numSlots
+                      << (correto ? "" : " ERRO") << std::endl;
+        }
+    }
+
+    delete[] vetores;
+    delete[] latitudes;
+    delete[] longitudes;
+    delete[] slots;
+    delete[] saidaSlots;
+    delete[] saidaQuadrados;
+    delete[] referenciaSlots;
+    delete[] referenciaQuadrados;
+    return 0;
+}
@@ -0,0 +1,80 @@
+/**
+ * Benchmark dos kernels de interseção de arrays ordenados
+ *
+ * Compara os kernels escalar, SSE e AVX2 (os suportados pela CPU) para
+ * várias razões entre os tamanhos das listas, e confere que todos produzem
+ * o mesmo resultado que o kernel escalar.
+ *
+ * Uso: bin/bench_intersecao.out
+ */
+
+#include "intersecao.hpp"
+#include "cronometro.hpp"
+#include <iostream>
+#include <cstdlib>
+
+/**
+ * Gera n ids ordenados sem repetição com saltos médios de 'saltoMedio'
+ */
+static int* gerarLista(int n, int saltoMedio) {
+    int* lista = new int[n];
+    int valor = 0;
+    for (int i = 0; i < n; i++) {
+        valor += 1 + rand() % (2 * saltoMedio - 1);
+        lista[i] = valor;
+    }
+    return lista;
+}
+
+int main() {
+    srand(5);
+
+    const int razoes[] = {1, 2, 4, 8, 16, 64};
+    const int tamanhoMenor = 4096;
+    const int faixa = 1 << 22;
+
+    KernelIntersecao suportado = detectarKernelIntersecao();
+    const char* nomes[] = {"escalar", "sse", "avx2"};
+    typedef int (*FuncaoIntersecao)(const int*, int, const int*, int, int*);
+    FuncaoIntersecao funcoes[] = {intersecaoDuasListasEscalar,
+                                  intersecaoDuasListasSse,
+                                  intersecaoDuasListasAvx2};
+
+    for (int r = 0; r < 6; r++) {
+        int tamanhoMaior = tamanhoMenor * razoes[r];
+        int* menor = gerarLista(tamanhoMenor, faixa / tamanhoMenor);
+        int* maior = gerarLista(tamanhoMaior, faixa / tamanhoMaior > 1 ? faixa / tamanhoMaior : 1);
+        int* resultado = new int[tamanhoMenor + FOLGA_SAIDA_INTERSECAO];
+        int* referencia = new int[tamanhoMenor + FOLGA_SAIDA_INTERSECAO];
+
+        int tamanhoReferencia = intersecaoDuasListasEscalar(menor, tamanhoMenor,
+                                                            maior, tamanhoMaior, referencia);
+
+        for (int k = 0; k <= static_cast<int>(suportado); k++) {
+            int tamanho = funcoes[k](menor, tamanhoMenor, maior, tamanhoMaior, resultado);
+            bool correto = tamanho == tamanhoReferencia;
+            for (int i = 0; correto && i < tamanho; i++) {
+                correto = resultado[i] == referencia[i];
+            }
+
+            double ns = medirNsPorChamada([&]() {
+                int t = funcoes[k](menor, tamanhoMenor, maior, tamanhoMaior, resultado);
+                naoOtimizar(t);
+            }, 50);
+
+            std::cout << "kernel=" << nomes[k]
+                      << " razao=" << razoes[r]
+                      << " tamanhos=" << tamanhoMenor << "x" << tamanhoMaior
+                      << " comuns=" << tamanhoReferencia
+                      << " us_por_intersecao=" << ns / 1000.0
+                      << (correto ? "" : " ERRO") << std::endl;
+        }
+
+        delete[] menor;
+        delete[] maior;
+        delete[] resultado;
+        delete[] referencia;
+    }
+
+    return 0;
+}
\ No newline at end of file
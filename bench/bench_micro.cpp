@@ -0,0 +1,307 @@
+/**
+ * Micro-benchmarks por estrutura de dados
+ *
+ * Isola as operações de cada TAD para que uma regressão no benchmark de
+ * ponta a ponta possa ser atribuída a uma estrutura:
+ *   - Palavra::adicionarLogradouro e Palavra::buscar (dicionário AVL e hash);
+ *   - Mapa::inserir e Mapa::buscar;
+ *   - ListaInteiros::inserir e toArray (com e sem arena de nós);
+ *   - MaxHeapCandidatos::inserir (heap limitada), ordenar e extrairOrdenado;
+ *   - dividirString, trim e stringParaDouble.
+ * Cada caso roda para cada tamanho n, com aquecimento e mediana de várias
+ * repetições (medirNsPorChamada, steady_clock), e reporta ns por operação.
+ * Os dados de entrada são gerados antes da medição com semente fixa.
+ * Inserções reconstroem a estrutura a cada repetição (o tempo inclui a
+ * criação e a destruição dela); buscas usam uma estrutura já construída.
+ *
+ * Uso: bin/bench_micro.out [--filtro TEXTO] [n1 n2 ...]
+ *   --filtro   roda só os casos cujo nome contém TEXTO (ex.: "Mapa")
+ *   n1 n2 ...  tamanhos (padrão: 1000 10000 100000)
+ */
+
+#include "palavra.hpp"
+#include "mapa.hpp"
+#include "consulta.hpp"
+#include "utils.hpp"
+#include "cronometro.hpp"
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+
+// ListaInteiros::inserir é linear no tamanho da lista: acima disto o caso
+// é pulado
+static const int MAXIMO_LISTA_INTEIROS = 10000;
+
+// Capacidade da heap limitada (o R das consultas)
+static const int CAPACIDADE_HEAP = 64;
+
+static const int AQUECIMENTO = 2;
+static const int REPETICOES = 7;
+
+static const char* filtro = nullptr;
+
+/**
+ * Dados de entrada compartilhados pelos casos de um tamanho n
+ */
+struct DadosMicro {
+    int n;
+    std::string* palavras;      // n palavras com ~n/4 distintas
+    std::string* chaves;        // n chaves distintas em ordem aleatória
+    int* valores;               // n inteiros em ordem aleatória
+    Candidato* candidatos;      // n candidatos com distâncias aleatórias
+    std::string* linhas;        // n linhas de endereço com 10 campos
+    std::string* campos;        // n campos com espaços laterais
+    std::string* numeros;       // n coordenadas com 6 casas decimais
+
+    DadosMicro(int n)
+        : n(n), palavras(new std::string[n]), chaves(new std::string[n]), valores(new int[n]),
+          candidatos(new Candidato[n]), linhas(new std::string[n]), campos(new std::string[n]),
+          numeros(new std::string[n]) {
+        srand(17);
+        int distintas = n / 4 > 0 ? n / 4 : 1;
+        for (int i = 0; i < n; i++) {
+            palavras[i] = "P" + std::to_string(rand() % distintas);
+            chaves[i] = std::to_string((static_cast<long long>(i) * 7919) % n + 1);
+            valores[i] = rand();
+            candidatos[i] = Candidato(i, (rand() % 1000000) / 1e6, i);
+            double lat = -20.0 + (rand() % 1000000) / 1e6;
+            double lon = -44.0 + (rand() % 1000000) / 1e6;
+            linhas[i] = std::to_string(i) + ";" + std::to_string(i % 997) +
+                        ";RUA;SAO JOSE;" + std::to_string(rand() % 3000) +
+                        ";BAIRRO;REGIAO;30140071;" + std::to_string(lat) + ";" +
+                        std::to_string(lon);
+            campos[i] = "  AVENIDA AFONSO PENA " + std::to_string(i) + "  ";
+            numeros[i] = std::to_string(lat);
+        }
+    }
+
+    ~DadosMicro() {
+        delete[] palavras;
+        delete[] chaves;
+        delete[] valores;
+        delete[] candidatos;
+        delete[] linhas;
+        delete[] campos;
+        delete[] numeros;
+    }
+
+private:
+    DadosMicro(const DadosMicro&);
+    DadosMicro& operator=(const DadosMicro&);
+};
+
+static bool selecionado(const char* nome) {
+    return filtro == nullptr || std::strstr(nome, filtro) != nullptr;
+}
+
+/**
+ * Mede f() (que executa 'operacoes' operações) e imprime ns por operação
+ */
+template<typename F>
+static void medir(const char* nome, int n, int operacoes, F f) {
+    if (!selecionado(nome)) {
+        return;
+    }
+    double ns = medirNsPorChamada(f, 1, AQUECIMENTO, REPETICOES) / operacoes;
+    std::cout << "caso=" << nome << " n=" << n << " ns_por_op=" << ns << std::endl;
+}
+
+static void medirPalavra(const DadosMicro& d, BackendDicionario backend,
+                         const char* nomeInserir, const char* nomeBuscar) {
+    medir(nomeInserir, d.n, d.n, [&]() {
+        Palavra indice(CONSTRUCAO_EM_LOTE, backend);
+        for (int i = 0; i < d.n; i++) {
+            indice.adicionarLogradouro(d.palavras[i], i);
+        }
+        naoOtimizar(indice);
+    });
+
+    if (!selecionado(nomeBuscar)) {
+        return;
+    }
+    Palavra indice(CONSTRUCAO_INCREMENTAL, backend);
+    for (int i = 0; i < d.n; i++) {
+        indice.obterPalavra(d.palavras[i]);
+    }
+    medir(nomeBuscar, d.n, d.n, [&]() {
+        long long soma = 0;
+        for (int i = 0; i < d.n; i++) {
+            soma += indice.buscar(d.palavras[i]) != nullptr;
+        }
+        naoOtimizar(soma);
+    });
+}
+
+static void medirMapa(const DadosMicro& d) {
+    medir("Mapa::inserir", d.n, d.n, [&]() {
+        Mapa<std::string, int> mapa;
+        for (int i = 0; i < d.n; i++) {
+            mapa.inserir(d.chaves[i], i);
+        }
+        naoOtimizar(mapa);
+    });
+
+    if (!selecionado("Mapa::buscar")) {
+        return;
+    }
+    Mapa<std::string, int> mapa;
+    for (int i = 0; i < d.n; i++) {
+        mapa.inserir(d.chaves[i], i);
+    }
+    medir("Mapa::buscar", d.n, d.n, [&]() {
+        long long soma = 0;
+        for (int i = d.n - 1; i >= 0; i--) {
+            const int* valor = mapa.buscar(d.chaves[i]);
+            soma += valor != nullptr ? *valor : 0;
+        }
+        naoOtimizar(soma);
+    });
+}
+
+static void medirListaInteiros(const DadosMicro& d) {
+    if (d.n > MAXIMO_LISTA_INTEIROS) {
+        return;
+    }
+    medir("ListaInteiros::inserir", d.n, d.n, [&]() {
+        ListaInteiros lista;
+        for (int i = 0; i < d.n; i++) {
+            lista.inserir(d.valores[i]);
+        }
+        naoOtimizar(lista);
+    });
+    medir("ListaInteiros::inserir(arena)", d.n, d.n, [&]() {
+        ArenaTipada<NodoListaInt> arena;
+        ListaInteiros lista(&arena);
+        for (int i = 0; i < d.n; i++) {
+            lista.inserir(d.valores[i]);
+        }
+        naoOtimizar(lista);
+    });
+
+    if (!selecionado("ListaInteiros::toArray")) {
+        return;
+    }
+    ListaInteiros lista;
+    for (int i = 0; i < d.n; i++) {
+        lista.inserir(d.valores[i]);
+    }
+    medir("ListaInteiros::toArray", d.n, lista.getTamanho(), [&]() {
+        int* valores = lista.toArray();
+        naoOtimizar(valores);
+        delete[] valores;
+    });
+}
+
+/**
+ * Extração ordenada de uma heap cheia com os n candidatos: a carga da heap
+ * fica fora da medição, pois a extração a esvazia
+ */
+template <typename Funcao>
+static void medirExtracao(const char* nome, const DadosMicro& d, MaxHeapCandidatos& heap,
+                          Funcao extrair) {
+    if (!selecionado(nome)) {
+        return;
+    }
+    double* tempos = new double[REPETICOES];
+    for (int r = 0; r < AQUECIMENTO + REPETICOES; r++) {
+        heap.reiniciar(d.n);
+        for (int i = 0; i < d.n; i++) {
+            heap.inserir(d.candidatos[i]);
+        }
+        Cronometro cronometro;
+        int tamanho = extrair();
+        double ns = cronometro.decorridoNs();
+        naoOtimizar(tamanho);
+        if (r >= AQUECIMENTO) {
+            tempos[r - AQUECIMENTO] = ns / d.n;
+        }
+    }
+    std::cout << "caso=" << nome << " n=" << d.n
+              << " ns_por_op=" << mediana(tempos, REPETICOES) << std::endl;
+    delete[] tempos;
+}
+
+static void medirHeap(const DadosMicro& d) {
+    MaxHeapCandidatos heap;
+    medir("MaxHeapCandidatos::inserir", d.n, d.n, [&]() {
+        heap.reiniciar(CAPACIDADE_HEAP);
+        for (int i = 0; i < d.n; i++) {
+            heap.inserir(d.candidatos[i]);
+        }
+        naoOtimizar(heap);
+    });
+
+    medirExtracao("MaxHeapCandidatos::ordenar", d, heap, [&]() { return heap.ordenar(); });
+    medirExtracao("MaxHeapCandidatos::extrairOrdenado", d, heap, [&]() {
+        int tamanho = 0;
+        const Candidato* resultado = heap.extrairOrdenado(tamanho);
+        naoOtimizar(resultado);
+        return tamanho;
+    });
+}
+
+static void medirUtils(const DadosMicro& d) {
+    medir("dividirString", d.n, d.n, [&]() {
+        long long soma = 0;
+        for (int i = 0; i < d.n; i++) {
+            int tamanho = 0;
+            std::string* partes = dividirString(d.linhas[i], ';', tamanho);
+            soma += tamanho;
+            delete[] partes;
+        }
+        naoOtimizar(soma);
+    });
+    medir("trim", d.n, d.n, [&]() {
+        long long soma = 0;
+        for (int i = 0; i < d.n; i++) {
+            soma += trim(d.campos[i]).size();
+        }
+        naoOtimizar(soma);
+    });
+    medir("stringParaDouble", d.n, d.n, [&]() {
+        double soma = 0.0;
+        for (int i = 0; i < d.n; i++) {
+            soma += stringParaDouble(d.numeros[i]);
+        }
+        naoOtimizar(soma);
+    });
+}
+
+int main(int argc, char* argv[]) {
+    int tamanhos[16];
+    int numTamanhos = 0;
+    for (int a = 1; a < argc; a++) {
+        int tamanho = 0;
+        if (std::strcmp(argv[a], "--filtro") == 0 && a + 1 < argc) {
+            filtro = argv[++a];
+        } else if (numTamanhos < 16 &&
+                   converterInteiro(argv[a], static_cast<int>(std::strlen(argv[a])), tamanho) &&
+                   tamanho > 0) {
+            tamanhos[numTamanhos++] = tamanho;
+        } else {
+            std::cerr << "Uso: " << argv[0] << " [--filtro TEXTO] [n1 n2 ...]" << std::endl;
+            return 1;
+        }
+    }
+    if (numTamanhos == 0) {
+        tamanhos[0] = 1000;
+        tamanhos[1] = 10000;
+        tamanhos[2] = 100000;
+        numTamanhos = 3;
+    }
+
+    for (int t = 0; t < numTamanhos; t++) {
+        DadosMicro dados(tamanhos[t]);
+        medirPalavra(dados, DICIONARIO_AVL, "Palavra::adicionarLogradouro(avl)",
+                     "Palavra::buscar(avl)");
+        medirPalavra(dados, DICIONARIO_HASH, "Palavra::adicionarLogradouro(hash)",
+                     "Palavra::buscar(hash)");
+        medirMapa(dados);
+        medirListaInteiros(dados);
+        medirHeap(dados);
+        medirUtils(dados);
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,179 @@
+/**
+ * Benchmark da conversão numérica da carga
+ *
+ * Cada linha tem um IdLog e duas coordenadas com 6 casas decimais, como na
+ * entrada. Compara, em linhas por segundo:
+ *   - o conversor original (fração acumulada multiplicando por 0.1);
+ *   - strtol/strtod da biblioteca C;
+ *   - converterInteiro/converterDouble.
+ * Também conta as coordenadas cujo valor difere do de strtod (arredondamento
+ * correto): o conversor original erra no último bit com frequência.
+ *
+ * Uso: bin/bench_numeros.out [linhas]
+ */
+
+#include "utils.hpp"
+#include "cronometro.hpp"
+#include <iostream>
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+
+/**
+ * Conversores como eram antes, para comparação
+ */
+static int stringParaIntOriginal(const char* str, int tamanho) {
+    int resultado = 0;
+    int sinal = 1;
+    int i = 0;
+    if (i < tamanho && str[i] == '-') {
+        sinal = -1;
+        i++;
+    } else if (i < tamanho && str[i] == '+') {
+        i++;
+    }
+    while (i < tamanho && str[i] >= '0' && str[i] <= '9') {
+        resultado = resultado * 10 + (str[i] - '0');
+        i++;
+    }
+    return resultado * sinal;
+}
+
+static double stringParaDoubleOriginal(const char* str, int tamanho) {
+    double resultado = 0.0;
+    double frator = 0.1;
+    int sinal = 1;
+    bool temDecimal = false;
+    int i = 0;
+    if (i < tamanho && str[i] == '-') {
+        sinal = -1;
+        i++;
+    } else if (i < tamanho && str[i] == '+') {
+        i++;
+    }
+    while (i < tamanho) {
+        if (str[i] == '.') {
+            temDecimal = true;
+            i++;
+            continue;
+        }
+        if (str[i] >= '0' && str[i] <= '9') {
+            if (!temDecimal) {
+                resultado = resultado * 10.0 + (str[i] - '0');
+            } else {
+                resultado += (str[i] - '0') * frator;
+                frator *= 0.1;
+            }
+        }
+        i++;
+    }
+    return resultado * sinal;
+}
+
+/**
+ * Campos das linhas guardados num único buffer, terminados em '\0'
+ */
+struct Campos {
+    char* texto;
+    int* inicio;        // 3 campos por linha: IdLog, latitude, longitude
+    int* tamanho;
+    int numLinhas;
+};
+
+static void gerar(Campos& campos, int numLinhas) {
+    srand(5);
+    campos.numLinhas = numLinhas;
+    campos.texto = new char[numLinhas * 3 * 16];
+    campos.inicio = new int[numLinhas * 3];
+    campos.tamanho = new int[numLinhas * 3];
+    int posicao = 0;
+    for (int l = 0; l < numLinhas; l++) {
+        double valores[2] = {-20.0 + (rand() % 1000000) / 1e6, -44.0 + (rand() % 1000000) / 1e6};
+        for (int c = 0; c < 3; c++) {
+            char* destino = campos.texto + posicao;
+            int n = c == 0 ? std::snprintf(destino, 16, "%d", 1 + rand() % 200000)
+                           : std::snprintf(destino, 16, "%.6f", valores[c - 1]);
+            campos.inicio[l * 3 + c] = posicao;
+            campos.tamanho[l * 3 + c] = n;
+            posicao += n + 1;
+        }
+    }
+}
+
+static double converterOriginal(const Campos& campos) {
+    double soma = 0.0;
+    for (int k = 0; k < campos.numLinhas * 3; k += 3) {
+        soma += stringParaIntOriginal(campos.texto + campos.inicio[k], campos.tamanho[k]);
+        soma += stringParaDoubleOriginal(campos.texto + campos.inicio[k + 1], campos.tamanho[k + 1]);
+        soma += stringParaDoubleOriginal(campos.texto + campos.inicio[k + 2], campos.tamanho[k + 2]);
+    }
+    return soma;
+}
+
+static double converterBibliotecaC(const Campos& campos) {
+    double soma = 0.0;
+    for (int k = 0; k < campos.numLinhas * 3; k += 3) {
+        soma += std::strtol(campos.texto + campos.inicio[k], nullptr, 10);
+        soma += std::strtod(campos.texto + campos.inicio[k + 1], nullptr);
+        soma += std::strtod(campos.texto + campos.inicio[k + 2], nullptr);
+    }
+    return soma;
+}
+
+static double converterNovo(const Campos& campos) {
+    double soma = 0.0;
+    for (int k = 0; k < campos.numLinhas * 3; k += 3) {
+        int id = 0;
+        double lat = 0.0, lon = 0.0;
+        converterInteiro(campos.texto + campos.inicio[k], campos.tamanho[k], id);
+        converterDouble(campos.texto + campos.inicio[k + 1], campos.tamanho[k + 1], lat);
+        converterDouble(campos.texto + campos.inicio[k + 2], campos.tamanho[k + 2], lon);
+        soma += id + lat + lon;
+    }
+    return soma;
+}
+
+static void reportar(const char* nome, double (*converter)(const Campos&), const Campos& campos) {
+    double ns = medirNsPorChamada([&]() {
+        double soma = converter(campos);
+        naoOtimizar(soma);
+    }, 1, 1, 5);
+    std::cout << "conversor=" << nome << " ms=" << ns / 1e6
+              << " linhas/s=" << campos.numLinhas / (ns / 1e9) << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    int numLinhas = 1000000;
+    if (argc > 2 || (argc == 2 && (!converterInteiro(argv[1], static_cast<int>(std::strlen(argv[1])),
+                                                     numLinhas) || numLinhas <= 0))) {
+        std::cerr << "Uso: " << argv[0] << " [linhas]" << std::endl;
+        return 1;
+    }
+    Campos campos;
+    gerar(campos, numLinhas);
+    std::cout << "linhas=" << numLinhas << std::endl;
+
+    reportar("original", converterOriginal, campos);
+    reportar("strtod", converterBibliotecaC, campos);
+    reportar("novo", converterNovo, campos);
+
+    int divergentesOriginal = 0, divergentesNovo = 0;
+    for (int k = 0; k < numLinhas * 3; k++) {
+        if (k % 3 == 0) {
+            continue;
+        }
+        const char* texto = campos.texto + campos.inicio[k];
+        double esperado = std::strtod(texto, nullptr);
+        double novo = 0.0;
+        converterDouble(texto, campos.tamanho[k], novo);
+        divergentesOriginal += stringParaDoubleOriginal(texto, campos.tamanho[k]) != esperado;
+        divergentesNovo += novo != esperado;
+    }
+    std::cout << "coordenadas_divergentes original=" << divergentesOriginal
+              << " novo=" << divergentesNovo << std::endl;
+
+    delete[] campos.texto;
+    delete[] campos.inicio;
+    delete[] campos.tamanho;
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,340 @@
+/**
+ * Benchmark de ponta a ponta sobre uma entrada completa
+ *
+ * Mede, sobre um arquivo no formato de tp3.out (p.ex. gerado por
+ * bin/gerador_zipf.out):
+ *   - carga + construção do índice, com os mesmos passos de main (ms);
+ *   - cada consulta individualmente (Consulta::executar, uma thread, sem
+ *     cache): vazão e percentis de latência;
+ *   - o executável completo, em processo filho: tempo total (melhor de
+ *     algumas execuções) e pico de memória residente (ru_maxrss).
+ * O resultado é um objeto JSON na saída padrão, para comparar commits.
+ *
+ * Uso: bin/bench_ponta_a_ponta.out ENTRADA [EXECUTAVEL] [--rotulo TEXTO]
+ *          [--execucoes K]
+ */
+
+#include "leitor_entrada.hpp"
+#include "logradouro.hpp"
+#include "palavra.hpp"
+#include "consulta.hpp"
+#include "tabela_logradouros.hpp"
+#include "mapa.hpp"
+#include "dinamico_array.hpp"
+#include "utils.hpp"
+#include "cronometro.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+struct ConsultaEntrada {
+    int id;
+    std::string texto;
+    double lat;
+    double lon;
+};
+
+/**
+ * Lê os dois primeiros inteiros da próxima linha não vazia ("N" ou "M R")
+ * Retorna o primeiro; os ausentes valem 0.
+ */
+static int lerInteiro(LeitorEntrada& leitor, int& segundo) {
+    VisaoTexto linha;
+    segundo = 0;
+    if (!leitor.proximaLinhaNaoVazia(linha)) {
+        return 0;
+    }
+    VisaoTexto campo;
+    VisaoTexto resto = linha;
+    int valor = 0;
+    if (proximoCampo(resto, ' ', campo)) {
+        campo = aparar(campo);
+        converterInteiro(campo.dados, campo.tamanho, valor);
+    }
+    if (proximoCampo(resto, ' ', campo)) {
+        campo = aparar(campo);
+        converterInteiro(campo.dados, campo.tamanho, segundo);
+    }
+    return valor;
+}
+
+/**
+ * Desce tempos[pai] no heap de máximo tempos[0 .. n)
+ */
+static void descerNoHeap(double* tempos, int pai, int n) {
+    while (2 * pai + 1 < n) {
+        int filho = 2 * pai + 1;
+        if (filho + 1 < n && tempos[filho + 1] > tempos[filho]) {
+            filho++;
+        }
+        if (tempos[pai] >= tempos[filho]) {
+            return;
+        }
+        double troca = tempos[pai];
+        tempos[pai] = tempos[filho];
+        tempos[filho] = troca;
+        pai = filho;
+    }
+}
+
+/**
+ * Ordena os tempos em ordem crescente (heapsort, sem memória extra)
+ */
+static void ordenarTempos(double* tempos, int n) {
+    for (int i = n / 2 - 1; i >= 0; i--) {
+        descerNoHeap(tempos, i, n);
+    }
+    for (int fim = n - 1; fim > 0; fim--) {
+        double maior = tempos[0];
+        tempos[0] = tempos[fim];
+        tempos[fim] = maior;
+        descerNoHeap(tempos, 0, fim);
+    }
+}
+
+/**
+ * Percentil p (0..100) de tempos já ordenados (posto mais próximo)
+ */
+static double percentil(const double* tempos, int n, double p) {
+    if (n == 0) {
+        return 0.0;
+    }
+    int posto = static_cast<int>(p / 100.0 * n + 0.999999);
+    if (posto < 1) {
+        posto = 1;
+    }
+    return tempos[(posto > n ? n : posto) - 1];
+}
+
+/**
+ * Executa o programa com a entrada no stdin e a saída descartada
+ * Preenche o tempo total (ms) e o pico de memória residente (KB).
+ */
+static bool executarProcesso(const char* executavel, const char* entrada,
+                             double& ms, long& picoKb) {
+    Cronometro cronometro;
+    pid_t filho = fork();
+    if (filho < 0) {
+        return false;
+    }
+    if (filho == 0) {
+        int descritorEntrada = open(entrada, O_RDONLY);
+        int descritorNulo = open("/dev/null", O_WRONLY);
+        if (descritorEntrada < 0 || descritorNulo < 0) {
+            _exit(127);
+        }
+        dup2(descritorEntrada, STDIN_FILENO);
+        dup2(descritorNulo, STDOUT_FILENO);
+        dup2(descritorNulo, STDERR_FILENO);
+        execl(executavel, executavel, static_cast<char*>(nullptr));
+        _exit(127);
+    }
+    int status = 0;
+    struct rusage uso;
+    if (wait4(filho, &status, 0, &uso) < 0) {
+        return false;
+    }
+    ms = cronometro.decorridoNs() / 1e6;
+    picoKb = uso.ru_maxrss;
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+int main(int argc, char* argv[]) {
+    const char* entrada = nullptr;
+    const char* executavel = nullptr;
+    const char* rotulo = "";
+    int execucoes = 3;
+    for (int a = 1; a < argc; a++) {
+        if (std::strcmp(argv[a], "--rotulo") == 0 && a + 1 < argc) {
+            rotulo = argv[++a];
+        } else if (std::strcmp(argv[a], "--execucoes") == 0 && a + 1 < argc) {
+            a++;
+            if (!converterInteiro(argv[a], static_cast<int>(std::strlen(argv[a])), execucoes) ||
+                execucoes <= 0) {
+                entrada = nullptr;
+                break;
+            }
+        } else if (argv[a][0] == '-' || executavel != nullptr) {
+            // Opção desconhecida (ex.: --help) ou argumento a mais
+            entrada = nullptr;
+            break;
+        } else if (entrada == nullptr) {
+            entrada = argv[a];
+        } else {
+            executavel = argv[a];
+        }
+    }
+    if (entrada == nullptr) {
+        std::fprintf(stderr, "Uso: %s ENTRADA [EXECUTAVEL] [--rotulo TEXTO] [--execucoes K]\n",
+                     argv[0]);
+        return 1;
+    }
+    int descritor = open(entrada, O_RDONLY);
+    if (descritor < 0) {
+        std::fprintf(stderr, "Nao foi possivel abrir %s\n", entrada);
+        return 1;
+    }
+
+    // ========================================================================
+    // Carga e construção, como em main
+    // ========================================================================
+
+    Cronometro cronometroConstrucao;
+    LeitorEntrada leitor(descritor);
+    int R = 0;
+    int N = lerInteiro(leitor, R);
+
+    DinamicoArray<Logradouro*> logradouros;
+    Palavra* indice = new Palavra(CONSTRUCAO_EM_LOTE, DICIONARIO_AVL);
+    TabelaLogradouros* tabela = nullptr;
+    {
+        Mapa<std::string, Logradouro*> porIdLog;
+        VisaoTexto linha;
+        CamposEndereco endereco;
+        std::string chave;
+        for (int i = 0; i < N && leitor.proximaLinha(linha); i++) {
+            if (!interpretarEndereco(linha, endereco)) {
+                if (!contaComoEndereco(linha)) {
+                    i--;
+                }
+                continue;
+            }
+            chave.assign(endereco.idLog.dados, endereco.idLog.tamanho);
+            bool novo = false;
+            Logradouro*& logradouro = porIdLog.obterOuInserir(chave, novo);
+            if (novo) {
+                logradouro = new Logradouro(chave, endereco.nome.paraString(),
+                                            endereco.lat, endereco.lon, 1);
+            } else {
+                logradouro->atualizarMedias(endereco.lat, endereco.lon);
+            }
+            VisaoTexto resto = endereco.nome;
+            VisaoTexto palavra;
+            while (proximoCampo(resto, ' ', palavra)) {
+                palavra = aparar(palavra);
+                if (!palavra.vazia()) {
+                    indice->adicionarLogradouro(palavra.dados, palavra.tamanho, endereco.id);
+                }
+            }
+        }
+        logradouros.reserve(porIdLog.tamanho());
+        for (Mapa<std::string, Logradouro*>::Iterador it = porIdLog.iterar(); it.valido();
+             it.avancar()) {
+            logradouros.push_back(it.valor());
+        }
+        tabela = new TabelaLogradouros(logradouros.data(), logradouros.size());
+        indice->congelar(tabela);
+    }
+    double msConstrucao = cronometroConstrucao.decorridoNs() / 1e6;
+
+    // ========================================================================
+    // Consultas, cronometradas uma a uma
+    // ========================================================================
+
+    int M = lerInteiro(leitor, R);
+    ConsultaEntrada* consultas = new ConsultaEntrada[M > 0 ? M : 1];
+    int numConsultas = 0;
+    VisaoTexto linha;
+    VisaoTexto campos[4];
+    while (numConsultas < M && leitor.proximaLinhaNaoVazia(linha)) {
+        if (dividirCampos(linha, ';', campos, 4) != 4) {
+            continue;
+        }
+        ConsultaEntrada& consulta = consultas[numConsultas];
+        VisaoTexto id = aparar(campos[0]);
+        VisaoTexto lat = aparar(campos[2]);
+        VisaoTexto lon = aparar(campos[3]);
+        if (!converterInteiro(id.dados, id.tamanho, consulta.id) ||
+            !converterDouble(lat.dados, lat.tamanho, consulta.lat) ||
+            !converterDouble(lon.dados, lon.tamanho, consulta.lon)) {
+            continue;
+        }
+        consulta.texto = aparar(campos[1]).paraString();
+        numConsultas++;
+    }
+    close(descritor);
+
+    double* tempos = new double[numConsultas > 0 ? numConsultas : 1];
+    AreaTrabalhoConsulta area;
+    long long totalResultados = 0;
+    Cronometro cronometroConsultas;
+    for (int q = 0; q < numConsultas; q++) {
+        Cronometro cronometro;
+        Consulta consulta(consultas[q].id, consultas[q].texto, consultas[q].lat,
+                          consultas[q].lon, R);
+        int tamanho = 0;
+        consulta.executar(indice, tabela, consultas[q].lat, consultas[q].lon, tamanho, area);
+        tempos[q] = cronometro.decorridoNs() / 1e3;
+        totalResultados += tamanho;
+    }
+    double msConsultas = cronometroConsultas.decorridoNs() / 1e6;
+    ordenarTempos(tempos, numConsultas);
+
+    struct rusage usoProprio;
+    getrusage(RUSAGE_SELF, &usoProprio);
+
+    // ========================================================================
+    // Executável completo
+    // ========================================================================
+
+    double msExecutavel = 0.0;
+    long picoExecutavelKb = 0;
+    bool executavelOk = true;
+    if (executavel != nullptr) {
+        for (int e = 0; e < execucoes; e++) {
+            double ms = 0.0;
+            long picoKb = 0;
+            if (!executarProcesso(executavel, entrada, ms, picoKb)) {
+                executavelOk = false;
+                break;
+            }
+            if (e == 0 || ms < msExecutavel) {
+                msExecutavel = ms;
+            }
+            if (picoKb > picoExecutavelKb) {
+                picoExecutavelKb = picoKb;
+            }
+        }
+    }
+
+    std::printf("{\n");
+    std::printf("  \"rotulo\": \"%s\",\n", rotulo);
+    std::printf("  \"entrada\": \"%s\",\n", entrada);
+    std::printf("  \"enderecos\": %d,\n", N);
+    std::printf("  \"logradouros\": %d,\n", logradouros.size());
+    std::printf("  \"termos\": %d,\n", indice->getNumPalavras());
+    std::printf("  \"consultas\": %d,\n", numConsultas);
+    std::printf("  \"max_respostas\": %d,\n", R);
+    std::printf("  \"resultados\": %lld,\n", totalResultados);
+    std::printf("  \"construcao_ms\": %.3f,\n", msConstrucao);
+    std::printf("  \"consultas_ms\": %.3f,\n", msConsultas);
+    std::printf("  \"consultas_por_segundo\": %.1f,\n",
+                msConsultas > 0.0 ? numConsultas / (msConsultas / 1e3) : 0.0);
+    std::printf("  \"latencia_us\": {\"p50\": %.3f, \"p90\": %.3f, \"p99\": %.3f, "
+                "\"p999\": %.3f, \"max\": %.3f},\n",
+                percentil(tempos, numConsultas, 50.0), percentil(tempos, numConsultas, 90.0),
+                percentil(tempos, numConsultas, 99.0), percentil(tempos, numConsultas, 99.9),
+                numConsultas > 0 ? tempos[numConsultas - 1] : 0.0);
+    std::printf("  \"pico_rss_kb\": %ld", usoProprio.ru_maxrss);
+    if (executavel != nullptr) {
+        std::printf(",\n  \"executavel\": {\"caminho\": \"%s\", \"ok\": %s, \"execucoes\": %d, "
+                    "\"total_ms\": %.3f, \"pico_rss_kb\": %ld}",
+                    executavel, executavelOk ? "true" : "false", execucoes, msExecutavel,
+                    picoExecutavelKb);
+    }
+    std::printf("\n}\n");
+
+    delete[] tempos;
+    delete[] consultas;
+    delete indice;
+    delete tabela;
+    for (int i = 0; i < logradouros.size(); i++) {
+        delete logradouros[i];
+    }
+    return executavelOk ? 0 : 1;
+}
\ No newline at end of file
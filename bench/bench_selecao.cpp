@@ -0,0 +1,87 @@
+/**
+ * Benchmark da seleção dos R melhores (fase 3 sem a grade)
+ *
+ * Para cada número de candidatos n e de respostas R, mede
+ * selecionarMaisProximos com cada estratégia forçada (heap limitada,
+ * partição + ordenação dos R primeiros, ordenação completa) e com a escolha
+ * automática, que deve ficar próxima da melhor. Os limiares de
+ * escolherSelecao saem desta tabela.
+ *
+ * Uso: bin/bench_selecao.out
+ */
+
+#include "consulta.hpp"
+#include "logradouro.hpp"
+#include "tabela_logradouros.hpp"
+#include "cronometro.hpp"
+#include <iostream>
+#include <string>
+#include <cstdlib>
+
+static const char* NOMES_ESTRATEGIAS[] = {"automatica", "heap", "particao", "ordenacao"};
+
+static void executarCaso(const TabelaLogradouros& tabela, const int* slots, int numCandidatos,
+                         int maxRespostas, AreaTrabalhoConsulta& area) {
+    double tempos[4];
+    for (int e = 0; e < 4; e++) {
+        EstrategiaSelecao estrategia = static_cast<EstrategiaSelecao>(e);
+        tempos[e] = medirNsPorChamada([&]() {
+            int tamanho = 0;
+            const Candidato* resultado = selecionarMaisProximos(&tabela, slots, numCandidatos,
+                                                                -19.5, -43.5, maxRespostas, area,
+                                                                tamanho, estrategia);
+            naoOtimizar(resultado);
+        }, numCandidatos >= 100000 ? 5 : 50);
+    }
+
+    int melhor = 1;
+    for (int e = 2; e < 4; e++) {
+        if (tempos[e] < tempos[melhor]) {
+            melhor = e;
+        }
+    }
+    std::cout << "candidatos=" << numCandidatos << " R=" << maxRespostas;
+    for (int e = 1; e < 4; e++) {
+        std::cout << " " << NOMES_ESTRATEGIAS[e] << "_us=" << tempos[e] / 1000.0;
+    }
+    std::cout << " automatica_us=" << tempos[0] / 1000.0
+              << " escolhida=" << NOMES_ESTRATEGIAS[escolherSelecao(numCandidatos, maxRespostas)]
+              << " melhor=" << NOMES_ESTRATEGIAS[melhor] << std::endl;
+}
+
+int main() {
+    const int totalLogradouros = 1000000;
+    srand(42);
+
+    Logradouro** logradouros = new Logradouro*[totalLogradouros];
+    for (int i = 0; i < totalLogradouros; i++) {
+        double lat = -20.0 + (rand() % 100000) / 100000.0;
+        double lon = -44.0 + (rand() % 100000) / 100000.0;
+        logradouros[i] = new Logradouro(std::to_string(i + 1), "RUA", lat, lon, 1);
+    }
+    TabelaLogradouros tabela(logradouros, totalLogradouros);
+    AreaTrabalhoConsulta area;
+
+    // Candidatos espalhados pela tabela, em ordem crescente de slot, como
+    // saem da interseção
+    const int candidatos[] = {100, 1000, 10000, 100000, 1000000};
+    const int respostas[] = {1, 10, 100, 1000, 10000};
+    int* slots = new int[totalLogradouros];
+    for (int c = 0; c < 5; c++) {
+        int n = candidatos[c];
+        int passo = totalLogradouros / n;
+        for (int i = 0; i < n; i++) {
+            slots[i] = i * passo;
+        }
+        for (int r = 0; r < 5; r++) {
+            executarCaso(tabela, slots, n, respostas[r], area);
+        }
+    }
+
+    delete[] slots;
+    for (int i = 0; i < totalLogradouros; i++) {
+        delete logradouros[i];
+    }
+    delete[] logradouros;
+    return 0;
+}
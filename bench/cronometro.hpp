@@ -0,0 +1,83 @@
+#ifndef CRONOMETRO_H
+#define CRONOMETRO_H
+
+#include <chrono>
+
+/**
+ * Utilitários de medição compartilhados pelos benchmarks
+ *
+ * Usa steady_clock (monotônico) e reporta a mediana de várias repetições,
+ * após algumas execuções de aquecimento, para reduzir o ruído da medição.
+ */
+
+class Cronometro {
+private:
+    std::chrono::steady_clock::time_point inicio;
+
+public:
+    Cronometro() : inicio(std::chrono::steady_clock::now()) {}
+
+    void reiniciar() {
+        inicio = std::chrono::steady_clock::now();
+    }
+
+    /**
+     * Tempo decorrido desde o início em nanossegundos
+     */
+    double decorridoNs() const {
+        return std::chrono::duration<double, std::nano>(
+            std::chrono::steady_clock::now() - inicio).count();
+    }
+};
+
+/**
+ * Impede que o compilador descarte um valor calculado apenas para medição
+ */
+template<typename T>
+inline void naoOtimizar(const T& valor) {
+    asm volatile("" : : "g"(&valor) : "memory");
+}
+
+/**
+ * Mediana de um array pequeno (ordena no próprio array)
+ */
+inline double mediana(double* valores, int n) {
+    for (int i = 1; i < n; i++) {
+        double chave = valores[i];
+        int j = i - 1;
+        while (j >= 0 && valores[j] > chave) {
+            valores[j + 1] = valores[j];
+            j--;
+        }
+        valores[j + 1] = chave;
+    }
+    return (n % 2 == 1) ? valores[n / 2] : (valores[n / 2 - 1] + valores[n / 2]) / 2.0;
+}
+
+/**
+ * Executa f() 'aquecimento' vezes sem medir e depois 'repeticoes' vezes,
+ * cada uma com 'iteracoes' chamadas. Retorna a mediana do tempo por chamada (ns).
+ */
+template<typename F>
+double medirNsPorChamada(F f, int iteracoes, int aquecimento = 2, int repeticoes = 7) {
+    for (int a = 0; a < aquecimento; a++) {
+        for (int i = 0; i < iteracoes; i++) {
+            f();
+        }
+    }
+
+    double* tempos = new double[repeticoes];
+    for (int r = 0; r < repeticoes; r++) {
+        Cronometro cronometro;
+        for (int i = 0; i < iteracoes; i++) {
+            f();
+        }
+        tempos[r] = cronometro.decorridoNs() / iteracoes;
+    }
+
+    double resultado = mediana(tempos, repeticoes);
+    delete[] tempos;
+    return resultado;
+}
+
+#endif // CRONOMETRO_H
\ No newline at end of file
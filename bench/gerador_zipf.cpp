@@ -0,0 +1,295 @@
+/**
+ * Gerador de entradas sintéticas para os benchmarks de ponta a ponta
+ *
+ * Escreve na saída padrão uma entrada completa no formato lido por tp3.out:
+ *   N
+ *   N linhas idEnd;IdLog;TipoLog;Log;Num;Bairro;Regiao;CEP;Lat;Long
+ *   M R
+ *   M linhas idConsulta;texto;Lat;Long
+ *
+ * As palavras dos nomes seguem uma distribuição de Zipf sobre o vocabulário
+ * (a palavra de posto r tem peso 1/r^s), como "DE", "SAO" e "JOSE" nos dados
+ * reais. Os logradouros se concentram em aglomerados espaciais: cada um fica
+ * perto do centro de um aglomerado e seus endereços, perto do logradouro.
+ * As consultas usam uma ou duas palavras de um logradouro existente (às vezes
+ * uma palavra sorteada do vocabulário) e partem de perto de um aglomerado.
+ * A mesma semente gera sempre a mesma entrada.
+ *
+ * Uso: bin/gerador_zipf.out [--enderecos N] [--consultas M] [--respostas R]
+ *          [--vocabulario V] [--zipf s] [--palavras-por-rua k]
+ *          [--enderecos-por-rua e] [--aglomerados C] [--desvio graus]
+ *          [--semente S] > entrada.txt
+ */
+
+#include "utils.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <cstdint>
+#include <string>
+
+/**
+ * Região sorteada para os centros dos aglomerados (em graus)
+ */
+static const double LAT_MINIMA = -20.05;
+static const double LAT_MAXIMA = -19.75;
+static const double LON_MINIMA = -44.10;
+static const double LON_MAXIMA = -43.85;
+
+// Dispersão dos endereços em torno do logradouro (em graus)
+static const double DESVIO_ENDERECO = 0.001;
+
+static const char* TIPOS[] = {"RUA", "AVENIDA", "TRAVESSA", "BECO", "ALAMEDA", "PRACA"};
+static const int NUM_TIPOS = 6;
+
+static const char* SILABAS[] = {"BA", "CE", "DI", "FO", "GU", "LA", "ME", "NI", "PO", "RU",
+                                "SA", "TE", "VI", "ZO", "MA", "RO", "JO", "SE", "PE", "NA"};
+static const int NUM_SILABAS = 20;
+
+struct Parametros {
+    int enderecos;
+    int consultas;
+    int respostas;
+    int vocabulario;
+    double zipf;
+    int palavrasPorRua;
+    int enderecosPorRua;
+    int aglomerados;
+    double desvio;
+    unsigned long long semente;
+
+    Parametros()
+        : enderecos(100000), consultas(10000), respostas(10), vocabulario(5000), zipf(1.0),
+          palavrasPorRua(3), enderecosPorRua(8), aglomerados(20), desvio(0.02), semente(1) {}
+};
+
+/**
+ * Gerador pseudoaleatório xorshift64*: reprodutível entre plataformas,
+ * ao contrário de rand()
+ */
+class Aleatorio {
+private:
+    uint64_t estado;
+
+public:
+    Aleatorio(unsigned long long semente) : estado(semente * 2685821657736338717ULL + 1) {}
+
+    uint64_t proximo() {
+        estado ^= estado >> 12;
+        estado ^= estado << 25;
+        estado ^= estado >> 27;
+        return estado * 2685821657736338717ULL;
+    }
+
+    /**
+     * Uniforme em [0, 1)
+     */
+    double uniforme() {
+        return (proximo() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    /**
+     * Inteiro uniforme em [0, n)
+     */
+    int inteiro(int n) {
+        return static_cast<int>(proximo() % static_cast<uint64_t>(n));
+    }
+
+    /**
+     * Normal padrão (Box-Muller)
+     */
+    double normal() {
+        double u = uniforme();
+        double v = uniforme();
+        return std::sqrt(-2.0 * std::log(1.0 - u)) * std::cos(6.283185307179586 * v);
+    }
+};
+
+/**
+ * Sorteio de postos 0..n-1 com probabilidade proporcional a 1/(posto+1)^s,
+ * por busca binária na distribuição acumulada
+ */
+class DistribuicaoZipf {
+private:
+    double* acumulada;
+    int n;
+
+public:
+    DistribuicaoZipf(int n, double s) : acumulada(new double[n]), n(n) {
+        double soma = 0.0;
+        for (int r = 0; r < n; r++) {
+            soma += 1.0 / std::pow(r + 1.0, s);
+            acumulada[r] = soma;
+        }
+        for (int r = 0; r < n; r++) {
+            acumulada[r] /= soma;
+        }
+    }
+
+    ~DistribuicaoZipf() {
+        delete[] acumulada;
+    }
+
+    int sortear(Aleatorio& aleatorio) const {
+        double u = aleatorio.uniforme();
+        int baixo = 0;
+        int alto = n - 1;
+        while (baixo < alto) {
+            int meio = (baixo + alto) >> 1;
+            if (acumulada[meio] < u) {
+                baixo = meio + 1;
+            } else {
+                alto = meio;
+            }
+        }
+        return baixo;
+    }
+
+private:
+    DistribuicaoZipf(const DistribuicaoZipf&);
+    DistribuicaoZipf& operator=(const DistribuicaoZipf&);
+};
+
+/**
+ * Palavra do vocabulário de posto r: sílabas da representação de r na base
+ * NUM_SILABAS (palavras distintas para postos distintos)
+ */
+static std::string palavraDoPosto(int posto) {
+    std::string palavra;
+    int valor = posto;
+    do {
+        palavra += SILABAS[valor % NUM_SILABAS];
+        valor /= NUM_SILABAS;
+    } while (valor > 0);
+    return palavra;
+}
+
+/**
+ * Lê os parâmetros; retorna false com opção desconhecida ou valor inválido
+ */
+static bool lerParametros(int argc, char* argv[], Parametros& p) {
+    for (int a = 1; a < argc; a++) {
+        if (a + 1 >= argc) {
+            return false;
+        }
+        const char* opcao = argv[a];
+        const char* valor = argv[++a];
+        int tamanho = static_cast<int>(std::strlen(valor));
+        bool valido = true;
+        if (std::strcmp(opcao, "--enderecos") == 0) {
+            valido = converterInteiro(valor, tamanho, p.enderecos);
+        } else if (std::strcmp(opcao, "--consultas") == 0) {
+            valido = converterInteiro(valor, tamanho, p.consultas);
+        } else if (std::strcmp(opcao, "--respostas") == 0) {
+            valido = converterInteiro(valor, tamanho, p.respostas);
+        } else if (std::strcmp(opcao, "--vocabulario") == 0) {
+            valido = converterInteiro(valor, tamanho, p.vocabulario);
+        } else if (std::strcmp(opcao, "--zipf") == 0) {
+            valido = converterDouble(valor, tamanho, p.zipf);
+        } else if (std::strcmp(opcao, "--palavras-por-rua") == 0) {
+            valido = converterInteiro(valor, tamanho, p.palavrasPorRua);
+        } else if (std::strcmp(opcao, "--enderecos-por-rua") == 0) {
+            valido = converterInteiro(valor, tamanho, p.enderecosPorRua);
+        } else if (std::strcmp(opcao, "--aglomerados") == 0) {
+            valido = converterInteiro(valor, tamanho, p.aglomerados);
+        } else if (std::strcmp(opcao, "--desvio") == 0) {
+            valido = converterDouble(valor, tamanho, p.desvio);
+        } else if (std::strcmp(opcao, "--semente") == 0) {
+            char* fim = nullptr;
+            p.semente = std::strtoull(valor, &fim, 10);
+            valido = tamanho > 0 && *fim == '\0' && valor[0] != '-';
+        } else {
+            return false;
+        }
+        if (!valido) {
+            return false;
+        }
+    }
+    return p.enderecos > 0 && p.consultas >= 0 && p.respostas > 0 && p.vocabulario > 0 &&
+           p.palavrasPorRua > 0 && p.enderecosPorRua > 0 && p.aglomerados > 0;
+}
+
+int main(int argc, char* argv[]) {
+    Parametros p;
+    if (!lerParametros(argc, argv, p)) {
+        std::fprintf(stderr,
+                     "Uso: %s [--enderecos N] [--consultas M] [--respostas R] [--vocabulario V]\n"
+                     "        [--zipf s] [--palavras-por-rua k] [--enderecos-por-rua e]\n"
+                     "        [--aglomerados C] [--desvio graus] [--semente S]\n",
+                     argv[0]);
+        return 1;
+    }
+
+    Aleatorio aleatorio(p.semente);
+    DistribuicaoZipf zipf(p.vocabulario, p.zipf);
+
+    double* latAglomerado = new double[p.aglomerados];
+    double* lonAglomerado = new double[p.aglomerados];
+    for (int c = 0; c < p.aglomerados; c++) {
+        latAglomerado[c] = LAT_MINIMA + aleatorio.uniforme() * (LAT_MAXIMA - LAT_MINIMA);
+        lonAglomerado[c] = LON_MINIMA + aleatorio.uniforme() * (LON_MAXIMA - LON_MINIMA);
+    }
+
+    // Logradouros: nome com palavrasPorRua palavras e posição no aglomerado
+    int numRuas = (p.enderecos + p.enderecosPorRua - 1) / p.enderecosPorRua;
+    std::string* nomes = new std::string[numRuas];
+    int* postos = new int[static_cast<long long>(numRuas) * p.palavrasPorRua];
+    int* tipos = new int[numRuas];
+    double* latRua = new double[numRuas];
+    double* lonRua = new double[numRuas];
+    for (int r = 0; r < numRuas; r++) {
+        for (int k = 0; k < p.palavrasPorRua; k++) {
+            int posto = zipf.sortear(aleatorio);
+            postos[static_cast<long long>(r) * p.palavrasPorRua + k] = posto;
+            if (k > 0) {
+                nomes[r] += ' ';
+            }
+            nomes[r] += palavraDoPosto(posto);
+        }
+        tipos[r] = aleatorio.inteiro(NUM_TIPOS);
+        int c = aleatorio.inteiro(p.aglomerados);
+        latRua[r] = latAglomerado[c] + p.desvio * aleatorio.normal();
+        lonRua[r] = lonAglomerado[c] + p.desvio * aleatorio.normal();
+    }
+
+    std::printf("%d\n", p.enderecos);
+    for (int i = 0; i < p.enderecos; i++) {
+        int r = aleatorio.inteiro(numRuas);
+        std::printf("%d;%d;%s;%s;%d;BAIRRO%d;REGIAO%d;%d;%.6f;%.6f\n",
+                    i, r + 1, TIPOS[tipos[r]], nomes[r].c_str(), 1 + aleatorio.inteiro(3000),
+                    r % 500, r % 9, 30000000 + aleatorio.inteiro(9999999),
+                    latRua[r] + DESVIO_ENDERECO * aleatorio.normal(),
+                    lonRua[r] + DESVIO_ENDERECO * aleatorio.normal());
+    }
+
+    std::printf("%d %d\n", p.consultas, p.respostas);
+    for (int q = 0; q < p.consultas; q++) {
+        std::string texto;
+        if (aleatorio.inteiro(10) == 0) {
+            // Consulta livre: palavra do vocabulário, possivelmente sem resultado
+            texto = palavraDoPosto(zipf.sortear(aleatorio));
+        } else {
+            int r = aleatorio.inteiro(numRuas);
+            const int* palavras = postos + static_cast<long long>(r) * p.palavrasPorRua;
+            texto = palavraDoPosto(palavras[aleatorio.inteiro(p.palavrasPorRua)]);
+            if (p.palavrasPorRua > 1 && aleatorio.inteiro(2) == 0) {
+                texto += ' ';
+                texto += palavraDoPosto(palavras[aleatorio.inteiro(p.palavrasPorRua)]);
+            }
+        }
+        int c = aleatorio.inteiro(p.aglomerados);
+        std::printf("%d;%s;%.6f;%.6f\n", q, texto.c_str(),
+                    latAglomerado[c] + p.desvio * aleatorio.normal(),
+                    lonAglomerado[c] + p.desvio * aleatorio.normal());
+    }
+
+    delete[] latAglomerado;
+    delete[] lonAglomerado;
+    delete[] nomes;
+    delete[] postos;
+    delete[] tipos;
+    delete[] latRua;
+    delete[] lonRua;
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Objetos do primeiro bloco de uma arena; cada bloco seguinte tem o dobro do
+ * anterior, até MAXIMO_OBJETOS_BLOCO_ARENA
+ */
+static const int OBJETOS_PRIMEIRO_BLOCO_ARENA = 64;
+static const int MAXIMO_OBJETOS_BLOCO_ARENA = 1 << 14;
+
+/**
+ * TAD ArenaTipada<T>
+ *
+ * Alocador de objetos de um único tipo em blocos contíguos (slabs).
+ * criar() constrói o objeto na próxima posição livre do bloco atual, sem uma
+ * chamada ao alocador por objeto, e nós criados em sequência ficam vizinhos na
+ * memória. Não há liberação individual: liberarTudo() (e o destrutor) devolve
+ * todos os objetos de uma vez. Para tipos com destrutor trivial isso custa um
+ * free por bloco; para os demais, os destrutores rodam numa varredura linear
+ * dos blocos, sem percorrer as estruturas que apontam para os objetos.
+ */
+template<typename T>
+class ArenaTipada {
+private:
+    struct Bloco {
+        Bloco* anterior;
+        T* objetos;
+        int usados;
+        int capacidade;
+    };
+
+    Bloco* atual;
+    int numObjetos;
+    long long bytesReservados;
+
+    void novoBloco() {
+        int capacidade = OBJETOS_PRIMEIRO_BLOCO_ARENA;
+        if (atual != nullptr) {
+            capacidade = atual->capacidade * 2;
+            if (capacidade > MAXIMO_OBJETOS_BLOCO_ARENA) {
+                capacidade = MAXIMO_OBJETOS_BLOCO_ARENA;
+            }
+        }
+        Bloco* bloco = new Bloco();
+        bloco->objetos = static_cast<T*>(::operator new(sizeof(T) * capacidade));
+        bloco->usados = 0;
+        bloco->capacidade = capacidade;
+        bloco->anterior = atual;
+        atual = bloco;
+        bytesReservados += static_cast<long long>(sizeof(T)) * capacidade;
+    }
+
+    // Não copiável: os objetos pertencem a esta instância
+    ArenaTipada(const ArenaTipada&);
+    ArenaTipada& operator=(const ArenaTipada&);
+
+public:
+    ArenaTipada() : atual(nullptr), numObjetos(0), bytesReservados(0) {
+    }
+
+    ~ArenaTipada() {
+        liberarTudo();
+    }
+
+    /**
+     * Constrói um objeto na arena com os argumentos dados
+     * O ponteiro vale até liberarTudo()
+     */
+    template<typename... Args>
+    T* criar(Args&&... args) {
+        if (atual == nullptr || atual->usados == atual->capacidade) {
+            novoBloco();
+        }
+        T* objeto = atual->objetos + atual->usados;
+        new (objeto) T(std::forward<Args>(args)...);
+        atual->usados++;
+        numObjetos++;
+        return objeto;
+    }
+
+    /**
+     * Destrói todos os objetos e devolve os blocos
+     */
+    void liberarTudo() {
+        while (atual != nullptr) {
+            Bloco* anterior = atual->anterior;
+            if (!std::is_trivially_destructible<T>::value) {
+                for (int i = 0; i < atual->usados; i++) {
+                    atual->objetos[i].~T();
+                }
+            }
+            ::operator delete(atual->objetos);
+            delete atual;
+            atual = anterior;
+        }
+        numObjetos = 0;
+        bytesReservados = 0;
+    }
+
+    /**
+     * Número de objetos criados desde a última liberação
+     */
+    int getNumObjetos() const {
+        return numObjetos;
+    }
+
+    /**
+     * Bytes reservados pelos blocos (inclui posições ainda livres)
+     */
+    long long getBytesReservados() const {
+        return bytesReservados;
+    }
+};
+
+#endif
\ No newline at end of file
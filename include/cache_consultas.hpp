@@ -0,0 +1,153 @@
+#ifndef CACHE_CONSULTAS_H
+#define CACHE_CONSULTAS_H
+
+#include "consulta.hpp"
+#include <string>
+#include <mutex>
+#include <cstdint>
+
+/**
+ * Cada entrada guarda os FATOR_FOLGA_CACHE * R candidatos mais próximos da
+ * origem que a criou: a folga permite responder origens vizinhas
+ */
+static const int FATOR_FOLGA_CACHE = 2;
+
+/**
+ * Margem (na unidade da Metrica) para erros de arredondamento na verificação
+ * da entrada
+ */
+static const double MARGEM_CERTIFICADO_CACHE = 1e-9;
+
+/**
+ * Contadores do cache
+ */
+struct EstatisticasCache {
+    long long acertos;          // Respondidas pelo cache
+    long long faltas;           // Chave ausente: consulta executada
+    long long recusas;          // Chave presente, mas a entrada não garante o resultado exato
+    long long remocoes;         // Entradas descartadas por limite de entradas ou memória
+
+    EstatisticasCache() : acertos(0), faltas(0), recusas(0), remocoes(0) {}
+};
+
+/**
+ * Entrada do cache: candidatos mais próximos de uma origem (âncora)
+ * Todo logradouro da consulta que não está em 'slots' fica a distância
+ * >= limite da âncora.
+ */
+struct EntradaCache {
+    std::string chave;
+    uint32_t hash;
+    double latAncora;
+    double lonAncora;
+    int* slots;                 // Em ordem crescente de distância à âncora
+    int numSlots;
+    double limite;              // Infinito se 'slots' contém todos os candidatos
+    long long bytes;
+
+    int anterior;               // Lista LRU (anterior = mais recente)
+    int proximo;
+    int proximoBalde;           // Encadeamento na tabela de dispersão
+};
+
+/**
+ * TAD CacheConsultas
+ *
+ * Cache LRU limitado na frente de Consulta::executar. A chave é o conjunto
+ * ordenado e sem repetição das palavras da consulta mais a origem trazida
+ * para uma grade de 'passo' graus (ou a origem exata, no modo estrito).
+ *
+ * Origens diferentes na mesma célula da grade compartilham a entrada, mas
+ * o resultado devolvido é sempre igual ao de uma execução sem cache: as
+ * distâncias são recalculadas a partir da origem real para os candidatos
+ * guardados, e a entrada só é usada se, pela desigualdade triangular,
+ * nenhum candidato de fora pode entrar entre os R melhores:
+ *     d(origem, R-ésimo) < limite - d(origem, âncora)
+ * Caso contrário a consulta é executada e a entrada, refeita.
+ *
+ * As entradas ficam num array fixo, com encadeamento por índice na tabela
+ * de dispersão e na lista LRU. O acesso é protegido por uma trava, para uso
+ * pelas threads de consulta.
+ */
+class CacheConsultas {
+private:
+    int maxEntradas;
+    long long maxBytes;
+    double passo;               // 0 = origem exata (modo estrito)
+
+    EntradaCache* entradas;
+    int livre;                  // Primeira entrada livre (encadeada por 'proximo')
+    int* baldes;
+    int numBaldes;
+    int maisRecente;
+    int menosRecente;
+    int numEntradas;
+    long long bytesUsados;
+
+    EstatisticasCache estatisticas;
+    std::mutex trava;
+
+    /**
+     * Monta a chave normalizada; retorna false se a origem não é finita ou
+     * se há palavras vazias (espaços repetidos)
+     */
+    bool montarChave(const std::string& texto, double lat, double lon, std::string& chave) const;
+
+    /**
+     * Índice da entrada com a chave ou -1
+     */
+    int localizar(const std::string& chave, uint32_t hash) const;
+
+    /**
+     * Operações da lista LRU
+     */
+    void desligarLRU(int indice);
+    void ligarComoMaisRecente(int indice);
+
+    /**
+     * Remove a entrada do balde e da lista e a devolve à lista livre
+     */
+    void remover(int indice);
+
+    /**
+     * Guarda o resultado de uma execução com folga
+     */
+    void guardar(const std::string& chave, uint32_t hash, double lat, double lon,
+                 const Candidato* candidatos, int numCandidatos, int maxCandidatos);
+
+public:
+    /**
+     * Construtor
+     * @param maxEntradas Número máximo de entradas
+     * @param maxBytes Limite de memória das entradas
+     * @param passo Lado da célula da grade de origens, em graus (0 = modo estrito)
+     */
+    CacheConsultas(int maxEntradas, long long maxBytes, double passo);
+
+    /**
+     * Destrutor
+     */
+    ~CacheConsultas();
+
+    /**
+     * Executa a consulta passando pelo cache
+     * Mesmo contrato de Consulta::executar (com a origem da própria consulta).
+     */
+    const Candidato* executar(Consulta& consulta, const Palavra* indice,
+                              const TabelaLogradouros* tabela, int& tamanhoResultado,
+                              AreaTrabalhoConsulta& area);
+
+    /**
+     * Contadores acumulados
+     */
+    EstatisticasCache getEstatisticas();
+
+    int getNumEntradas();
+    long long getBytesUsados();
+
+private:
+    CacheConsultas(const CacheConsultas&);
+    CacheConsultas& operator=(const CacheConsultas&);
+};
+
+#endif // CACHE_CONSULTAS_H
\ No newline at end of file
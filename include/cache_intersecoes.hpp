@@ -0,0 +1,154 @@
+#ifndef CACHE_INTERSECOES_H
+#define CACHE_INTERSECOES_H
+
+#include "palavra.hpp"
+#include "intersecao.hpp"
+#include <mutex>
+#include <cstdint>
+
+/**
+ * Consultas com mais termos distintos que isto não passam pelo cache
+ */
+static const int MAX_TERMOS_CACHE_INTERSECOES = 8;
+
+/**
+ * Admissão: a combinação precisa ter sido vista ao menos esta quantidade de
+ * vezes e a interseção precisa custar (soma dos tamanhos das listas) ao
+ * menos CUSTO_MINIMO_CACHE_INTERSECOES postings
+ */
+static const int FREQUENCIA_ADMISSAO_CACHE_INTERSECOES = 2;
+static const long long CUSTO_MINIMO_CACHE_INTERSECOES = 1024;
+
+/**
+ * Contadores de frequência das combinações (com envelhecimento)
+ */
+static const int TAMANHO_CONTADOR_FREQUENCIAS = 1 << 16;
+
+/**
+ * Contadores do cache de interseções
+ */
+struct EstatisticasCacheIntersecoes {
+    long long acertos;          // Combinação inteira no cache
+    long long reaproveitamentos;// Subconjunto no cache, refinado com a lista restante
+    long long faltas;           // Interseção calculada do zero
+    long long admissoes;        // Resultados guardados
+    long long remocoes;         // Entradas descartadas por limite de entradas ou memória
+
+    EstatisticasCacheIntersecoes()
+        : acertos(0), reaproveitamentos(0), faltas(0), admissoes(0), remocoes(0) {}
+};
+
+/**
+ * Entrada do cache: slots da interseção de uma combinação de termos
+ */
+struct EntradaCacheIntersecao {
+    int termos[MAX_TERMOS_CACHE_INTERSECOES];   // Ids dos termos, em ordem crescente
+    int numTermos;
+    uint32_t hash;
+    int* slots;                 // Em ordem crescente, como os de intersectarListas
+    int numSlots;
+    long long bytes;
+
+    int anterior;               // Lista LRU (anterior = mais recente)
+    int proximo;
+    int proximoBalde;           // Encadeamento na tabela de dispersão
+};
+
+/**
+ * TAD CacheIntersecoes
+ *
+ * Cache LRU limitado de interseções materializadas, compartilhado pelas
+ * consultas. A chave é a tupla ordenada e sem repetição dos ids dos termos,
+ * independente da origem: num acerto, só o cálculo de distâncias e a seleção
+ * dos R melhores rodam para a nova origem.
+ *
+ * Só são admitidas combinações frequentes (contador por hash com
+ * envelhecimento) e caras (listas longas). Se a combinação inteira não está
+ * no cache mas uma combinação com um termo a menos está ({A,B} para
+ * {A,B,C}), a interseção parte do resultado guardado e é refinada só com a
+ * lista do termo restante.
+ *
+ * Mesma organização do CacheConsultas: entradas num array fixo, encadeadas
+ * por índice na tabela de dispersão e na lista LRU, protegidas por uma trava.
+ */
+class CacheIntersecoes {
+private:
+    int maxEntradas;
+    long long maxBytes;
+
+    EntradaCacheIntersecao* entradas;
+    int livre;                  // Primeira entrada livre (encadeada por 'proximo')
+    int* baldes;
+    int numBaldes;
+    int maisRecente;
+    int menosRecente;
+    int numEntradas;
+    long long bytesUsados;
+
+    unsigned char* frequencias;
+    int incrementos;            // Desde o último envelhecimento
+
+    EstatisticasCacheIntersecoes estatisticas;
+    std::mutex trava;
+
+    /**
+     * Conta mais uma ocorrência da combinação; retorna a frequência estimada
+     */
+    int registrarFrequencia(uint32_t hash);
+
+    /**
+     * Índice da entrada com a chave ou -1
+     */
+    int localizar(const int* termos, int numTermos, uint32_t hash) const;
+
+    /**
+     * Operações da lista LRU
+     */
+    void desligarLRU(int indice);
+    void ligarComoMaisRecente(int indice);
+
+    /**
+     * Remove a entrada do balde e da lista e a devolve à lista livre
+     */
+    void remover(int indice);
+
+    /**
+     * Guarda o resultado de uma interseção
+     */
+    void guardar(const int* termos, int numTermos, uint32_t hash, const int* slots, int numSlots);
+
+public:
+    /**
+     * Construtor
+     * @param maxEntradas Número máximo de entradas
+     * @param maxBytes Limite de memória das entradas
+     */
+    CacheIntersecoes(int maxEntradas, long long maxBytes);
+
+    /**
+     * Destrutor
+     */
+    ~CacheIntersecoes();
+
+    /**
+     * Interseção das listas dos termos (ids de Palavra::buscarIdTermo; -1 =
+     * termo ausente) passando pelo cache
+     * Mesmo contrato de intersectarListas: os slots ficam em buffer.getDados().
+     */
+    int intersectar(const Palavra* indice, const int* termos, int numTermos,
+                    BufferIntersecao& buffer);
+
+    /**
+     * Contadores acumulados
+     */
+    EstatisticasCacheIntersecoes getEstatisticas();
+
+    int getNumEntradas();
+    long long getBytesUsados();
+
+private:
+    CacheIntersecoes(const CacheIntersecoes&);
+    CacheIntersecoes& operator=(const CacheIntersecoes&);
+};
+
+#endif // CACHE_INTERSECOES_H
\ No newline at end of file
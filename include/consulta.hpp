@@ -3,24 +3,32 @@
 
 #include "palavra.hpp"
 #include "logradouro.hpp"
+#include "tabela_logradouros.hpp"
+#include "intersecao.hpp"
+#include "cache_intersecoes.hpp"
+#include "instrumentacao.hpp"
 #include <string>
 
 /**
  * Estrutura para representar um candidato (logradouro com distância)
  * Utilizado no min-heap de tamanho R
+ * Só guarda o slot na tabela de logradouros: o nome é buscado pelo slot ao
+ * escrever a saída, e o candidato é copiado sem alocação.
  */
 struct Candidato {
-    int idLog;
-    std::string nome;
     double distancia;
+    int idLog;
+    int slot;                   // Slot na tabela de logradouros
 
-    Candidato() : idLog(0), nome(""), distancia(0.0) {}
-    Candidato(int idLog, const std::string& nome, double distancia)
-        : idLog(idLog), nome(nome), distancia(distancia) {}
+    Candidato() : distancia(0.0), idLog(0), slot(-1) {}
+    Candidato(int idLog, double distancia, int slot)
+        : distancia(distancia), idLog(idLog), slot(slot) {}
 
     // Comparação para min-heap (maior distância no topo para fácil remoção)
+    // Só a distância: a ordem entre empatados é a da seleção original (ver
+    // selecionarComoOriginal em consulta.cpp)
     bool operator<(const Candidato& outro) const {
-        return distancia < outro.distancia; // Inverte para max-heap (remove o maior)
+        return distancia < outro.distancia;
     }
 
     bool operator>(const Candidato& outro) const {
@@ -31,12 +39,15 @@ struct Candidato {
 /**
  * Min-Heap de tamanho limitado para manter os R logradouros mais próximos
  * Implementado como árvore binária em array
+ * O array é reaproveitado entre consultas (reiniciar) e só cresce.
  */
 class MaxHeapCandidatos {
 private:
     Candidato* heap;
     int tamanho;
     int capacidade;
+    int alocado;                // Tamanho do array (>= capacidade)
+    double menorDescartada;     // Menor distância recusada ou removida desde reiniciar
 
     /**
      * Retorna o índice do pai de um nodo
@@ -67,13 +78,19 @@ public:
     /**
      * Construtor
      */
-    MaxHeapCandidatos(int capacidade);
+    MaxHeapCandidatos(int capacidade = 0);
 
     /**
      * Destrutor
      */
     ~MaxHeapCandidatos();
 
+    /**
+     * Esvazia a heap e define a nova capacidade, realocando só se o array
+     * atual não comporta
+     */
+    void reiniciar(int capacidade);
+
     /**
      * Insere um candidato no heap
      * Se heap está cheio e candidato é melhor que o pior, remove o pior e insere
@@ -88,7 +105,7 @@ public:
     /**
      * Retorna o topo sem remover
      */
-    Candidato getTopo() const;
+    const Candidato& getTopo() const;
 
     /**
      * Retorna o número de candidatos na heap
@@ -105,13 +122,149 @@ public:
      */
     bool estaVazia() const;
 
+    /**
+     * Menor distância entre os candidatos que não entraram ou foram
+     * removidos desde reiniciar (infinito se nenhum)
+     */
+    double getMenorDescartada() const;
+
+    /**
+     * Ordena os candidatos por distância crescente no próprio array (heapsort)
+     * e esvazia a heap; retorna quantos são, acessíveis por getDados()
+     */
+    int ordenar();
+
+    /**
+     * Candidatos no array (ordenados após ordenar())
+     */
+    const Candidato* getDados() const;
+
     /**
      * Extrai todos os candidatos ordenados por distância crescente
-     * Retorna um array e atualiza tamanho
+     * Retorna o próprio array da heap (sem cópia), válido até o próximo
+     * reiniciar, e atualiza tamanho
+     */
+    const Candidato* extrairOrdenado(int& tamanhoResultado);
+
+private:
+    MaxHeapCandidatos(const MaxHeapCandidatos&);
+    MaxHeapCandidatos& operator=(const MaxHeapCandidatos&);
+};
+
+/**
+ * Buffer reutilizável de candidatos, para as seleções que avaliam todos
+ * Só cresce; a memória é liberada no destrutor
+ */
+class BufferCandidatos {
+private:
+    Candidato* dados;
+    int capacidade;
+
+public:
+    BufferCandidatos();
+    ~BufferCandidatos();
+
+    /**
+     * Garante espaço para pelo menos n candidatos (o conteúdo não é preservado)
      */
-    Candidato* extrairOrdenado(int& tamanhoResultado);
+    void garantir(int n);
+
+    Candidato* getDados();
+
+private:
+    BufferCandidatos(const BufferCandidatos&);
+    BufferCandidatos& operator=(const BufferCandidatos&);
+};
+
+/**
+ * Estratégias de seleção dos R melhores entre n candidatos já conhecidos
+ * - HEAP: heap limitada a R, sem guardar os demais (R bem menor que n)
+ * - PARTICAO: todos num buffer, partição ao redor do R-ésimo (quickselect)
+ *   e ordenação só dos R primeiros
+ * - ORDENACAO: todos num buffer, ordenação completa (R >= n ou quase)
+ * Sem empates de distância o resultado é único; com empate, todas refazem a
+ * seleção como a versão original: o resultado é idêntico.
+ */
+enum EstrategiaSelecao {
+    SELECAO_AUTOMATICA,
+    SELECAO_HEAP,
+    SELECAO_PARTICAO,
+    SELECAO_ORDENACAO
+};
+
+/**
+ * Limiares da escolha automática, medidos com bench_selecao: heap só com
+ * R <= MAXIMO_RESPOSTAS_HEAP e n >= R * LIMIAR_RAZAO_HEAP (o kernel de
+ * distâncias descarta quase todo candidato antes da heap; com R maior, as
+ * trocas na heap já custam mais que a partição). Ordenação completa se
+ * R >= n; partição nos demais casos
+ */
+static const int MAXIMO_RESPOSTAS_HEAP = 128;
+static const int LIMIAR_RAZAO_HEAP = 64;
+
+/**
+ * Estratégia da escolha automática para n candidatos e R respostas
+ */
+EstrategiaSelecao escolherSelecao(int numCandidatos, int maxRespostas);
+
+/**
+ * Ordena candidatos por distância crescente (empatados em ordem qualquer)
+ */
+void ordenarCandidatos(Candidato* candidatos, int n);
+
+/**
+ * Reorganiza candidatos de modo que os k menores fiquem (sem ordem) em [0, k)
+ */
+void particionarCandidatos(Candidato* candidatos, int n, int k);
+
+/**
+ * Retorna true se dois candidatos consecutivos (ordenados) têm a mesma distância
+ */
+bool haEmpateDistancias(const Candidato* ordenados, int n);
+
+/**
+ * Abaixo deste número de candidatos a consulta avalia todos diretamente;
+ * acima, visita as células da grade em anéis a partir da origem
+ */
+static const int LIMIAR_CANDIDATOS_GRADE = 64;
+
+/**
+ * Se até a menor lista da consulta cobre 1/DIVISOR_DENSIDADE_SOB_DEMANDA dos
+ * logradouros, a interseção é feita sob demanda, só nas células visitadas
+ */
+static const int DIVISOR_DENSIDADE_SOB_DEMANDA = 8;
+
+/**
+ * Área de trabalho reaproveitada entre consultas
+ * Mantém os buffers da interseção para não alocá-los a cada consulta
+ */
+struct AreaTrabalhoConsulta {
+    BufferIntersecao intersecao;
+    BufferIntersecao faixa;     // Interseção de uma faixa de células (sob demanda)
+    MaxHeapCandidatos heap;     // R melhores da consulta
+    BufferCandidatos todos;     // Todos os candidatos (seleção por partição ou ordenação)
+    BufferIntersecao slotsCache;    // Slots de uma entrada do cache de resultados
+    CacheIntersecoes* cacheIntersecoes;     // Compartilhado entre as áreas; nullptr sem cache
+#ifdef INSTRUMENTACAO
+    Instrumentacao instrumentacao;          // Fases e contadores das consultas desta área
+#endif
+
+    AreaTrabalhoConsulta() : cacheIntersecoes(nullptr) {}
 };
 
+/**
+ * Seleciona, entre os slots dados, os R mais próximos da origem, em ordem
+ * crescente de distância (R limitado a numSlots)
+ * A estratégia é a de escolherSelecao, salvo se outra for forçada.
+ * Retorna os candidatos num buffer de 'area' (sem alocar), válidos até o
+ * próximo uso da área, e atualiza tamanhoResultado.
+ */
+const Candidato* selecionarMaisProximos(const TabelaLogradouros* tabela, const int* slots,
+                                        int numSlots, double latOrigem, double lonOrigem,
+                                        int maxRespostas, AreaTrabalhoConsulta& area,
+                                        int& tamanhoResultado,
+                                        EstrategiaSelecao estrategia = SELECAO_AUTOMATICA);
+
 /**
  * TAD Consulta
  * 
@@ -119,8 +272,10 @@ public:
  * Integra informações dos TADs Logradouro e Palavra para gerar respostas.
  * 
  * Fase 1: Recuperação de listas de logradouros para cada palavra
- * Fase 2: Interseção das listas e cálculo de distâncias euclidianas
- * Fase 3: Uso de min-heap de tamanho R para seleção dos R melhores
+ * Fase 2: Interseção das listas e cálculo de distâncias (Metrica em uso)
+ * Fase 3: Uso de min-heap de tamanho R para seleção dos R melhores,
+ *         visitando as células da grade espacial da mais próxima para a mais
+ *         distante e parando quando nenhuma célula restante pode melhorar o R-ésimo
  */
 class Consulta {
 private:
@@ -153,19 +308,25 @@ public:
 
     /**
      * Executa a consulta usando os índices de palavra e logradouros
-     * Retorna um array de candidatos e atualiza tamanho
+     * Retorna os candidatos num buffer de 'area' e atualiza tamanho: o
+     * resultado vale até a próxima consulta com a mesma área, e o chamador
+     * o escreve ou copia antes disso
+     * O índice precisa estar congelado; as listas de postings contêm slots
+     * da tabela densa de logradouros, resolvidos diretamente em O(1)
+     * 'area' é reaproveitada entre chamadas: a fase 3 não aloca
      * 
      * Fase 1: Recupera listas de logradouros para cada palavra da consulta
      * Fase 2: Calcula a interseção das listas (logradouros com TODAS as palavras)
-     *         e calcula distâncias euclidianas até a origem
-     * Fase 3: Usa min-heap de tamanho R para selecionar os R melhores
-     */
-    Candidato* executar(Palavra* indice,
-                        Logradouro** logradourosArray,
-                        int numLogradouros,
-                        double latOrigem,
-                        double lonOrigem,
-                        int& tamanhoResultado);
+     *         e calcula distâncias até a origem (Metrica em uso)
+     * Fase 3: Usa min-heap de tamanho R para selecionar os R melhores; com
+     *         muitos candidatos, percorre a grade em anéis e para cedo
+     */
+    const Candidato* executar(const Palavra* indice,
+                              const TabelaLogradouros* tabela,
+                              double latOrigem,
+                              double lonOrigem,
+                              int& tamanhoResultado,
+                              AreaTrabalhoConsulta& area);
 };
 
 #endif // CONSULTA_H
\ No newline at end of file
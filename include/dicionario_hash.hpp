@@ -0,0 +1,138 @@
+#ifndef DICIONARIO_HASH_H
+#define DICIONARIO_HASH_H
+
+#include <string>
+#include <cstdint>
+
+/**
+ * Slot da tabela de dispersão
+ * Guarda o hash completo da palavra para evitar comparar strings à toa
+ */
+struct SlotDicionario {
+    uint32_t hash;
+    int idTermo;            // -1 se o slot está vazio
+};
+
+/**
+ * Arrays planos que compõem um DicionarioHash
+ * Usados para exportar o dicionário (snapshot) e para montá-lo sobre
+ * memória externa, como um arquivo mapeado
+ */
+struct DadosDicionario {
+    SlotDicionario* slots;
+    int capacidade;
+    int numTermos;
+    char* textos;
+    int tamanhoTextos;
+    int* inicioTexto;           // numTermos + 1 posições
+};
+
+/**
+ * TAD DicionarioHash
+ *
+ * Dicionário de termos palavra -> identificador de termo, implementado como
+ * tabela de dispersão com endereçamento aberto e Robin Hood hashing.
+ *
+ * Os slots são pequenos e contíguos (hash + id), e os textos das palavras
+ * ficam num único buffer de caracteres indexado pelo id do termo. Uma busca
+ * costuma tocar uma ou duas linhas de cache, e só compara a string quando o
+ * hash armazenado coincide.
+ *
+ * Os ids são atribuídos em ordem de inserção (0, 1, 2, ...).
+ *
+ * Um dicionário montado sobre DadosDicionario externos é somente leitura.
+ */
+class DicionarioHash {
+private:
+    SlotDicionario* slots;
+    int capacidade;             // Sempre potência de 2
+    int numTermos;
+
+    char* textos;               // Textos das palavras, concatenados
+    int tamanhoTextos;
+    int capacidadeTextos;
+    int* inicioTexto;           // inicioTexto[id] .. inicioTexto[id + 1] delimita a palavra
+    int capacidadeTermos;
+
+    bool donoDosArrays;         // false quando montado sobre memória externa
+
+    /**
+     * Distância entre a posição ideal de um hash e a posição atual
+     */
+    int distancia(uint32_t hash, int posicao) const;
+
+    /**
+     * Compara o texto do termo id com a palavra informada
+     */
+    bool textoIgual(int id, const char* palavra, int tamanho) const;
+
+    /**
+     * Insere um slot já preenchido (usado na inserção e no crescimento)
+     */
+    void inserirSlot(SlotDicionario slot);
+
+    /**
+     * Dobra a capacidade da tabela e reinsere os slots
+     */
+    void crescer();
+
+    /**
+     * Guarda o texto de um novo termo no buffer de textos
+     */
+    void guardarTexto(const char* palavra, int tamanho);
+
+public:
+    /**
+     * Função de dispersão usada pelo dicionário (FNV-1a de 32 bits)
+     */
+    static uint32_t calcularHash(const char* palavra, int tamanho);
+
+    /**
+     * Construtor
+     */
+    DicionarioHash(int capacidadeInicial = 1024);
+
+    /**
+     * Monta o dicionário sobre arrays externos, sem copiá-los (somente leitura)
+     * Os arrays precisam sobreviver ao dicionário e não são liberados por ele.
+     */
+    DicionarioHash(const DadosDicionario& dadosExternos);
+
+    /**
+     * Destrutor
+     */
+    ~DicionarioHash();
+
+    /**
+     * Retorna o id do termo, inserindo-o se ainda não existir
+     */
+    int obterOuInserir(const std::string& palavra);
+    int obterOuInserir(const char* palavra, int tamanho);
+
+    /**
+     * Retorna o id do termo ou -1 se não existir
+     */
+    int buscar(const std::string& palavra) const;
+    int buscar(const char* palavra, int tamanho) const;
+
+    /**
+     * Retorna o número de termos
+     */
+    int getNumTermos() const;
+
+    /**
+     * Retorna o texto de um termo
+     */
+    std::string getTexto(int id) const;
+
+    /**
+     * Preenche 'saida' com os arrays internos (que continuam do dicionário)
+     */
+    void exportar(DadosDicionario& saida) const;
+
+private:
+    DicionarioHash(const DicionarioHash&);
+    DicionarioHash& operator=(const DicionarioHash&);
+};
+
+#endif // DICIONARIO_HASH_H
\ No newline at end of file
@@ -1,11 +1,21 @@
 #ifndef DINAMICOARRAY_H
 #define DINAMICOARRAY_H
 
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <utility>
+
 /**
  * TAD DinamicoArray
- * 
+ *
  * Implementação manual de um array dinâmico
  * Funcionalidades: inserir, acessar por índice, redimensionar automaticamente
+ *
+ * Os elementos vivem em memória bruta e só as posições [0, size()) estão
+ * construídas. Ao crescer, tipos trivialmente copiáveis são realocados com
+ * realloc (cópia de bytes, muitas vezes sem mover as páginas); os demais são
+ * movidos para o novo buffer, sem construir posições vazias nem copiar.
  */
 template<typename T>
 class DinamicoArray {
@@ -14,21 +24,58 @@ private:
     int tamanho;
     int capacidade;
 
+    // Não copiável: o array é dono dos elementos
+    DinamicoArray(const DinamicoArray&);
+    DinamicoArray& operator=(const DinamicoArray&);
+
+    /**
+     * Troca o buffer por um de novaCapacidade posições (>= tamanho)
+     * A estratégia é escolhida em tempo de compilação conforme T
+     */
+    void realocar(int novaCapacidade) {
+        realocar(novaCapacidade, std::integral_constant<bool, std::is_trivially_copyable<T>::value>());
+    }
+
+    // Trivialmente copiável: realloc copia os bytes (ou estende o bloco no lugar)
+    void realocar(int novaCapacidade, std::true_type) {
+        void* novosDados = std::realloc(static_cast<void*>(dados),
+                                        sizeof(T) * static_cast<size_t>(novaCapacidade));
+        if (novosDados == nullptr) {
+            throw std::bad_alloc();
+        }
+        dados = static_cast<T*>(novosDados);
+        capacidade = novaCapacidade;
+    }
+
+    // Demais tipos: cada elemento é movido para o novo buffer e destruído no antigo
+    void realocar(int novaCapacidade, std::false_type) {
+        T* novosDados = static_cast<T*>(std::malloc(sizeof(T) * static_cast<size_t>(novaCapacidade)));
+        if (novosDados == nullptr) {
+            throw std::bad_alloc();
+        }
+        for (int i = 0; i < tamanho; i++) {
+            new (novosDados + i) T(std::move(dados[i]));
+            dados[i].~T();
+        }
+        std::free(dados);
+        dados = novosDados;
+        capacidade = novaCapacidade;
+    }
+
     /**
      * Redimensiona o array quando necessário
      */
     void redimensionar() {
         if (tamanho >= capacidade) {
-            int novaCapacidade = (capacidade == 0) ? 10 : capacidade * 2;
-            T* novosDados = new T[novaCapacidade];
-            
-            for (int i = 0; i < tamanho; i++) {
-                novosDados[i] = dados[i];
+            realocar((capacidade == 0) ? 10 : capacidade * 2);
+        }
+    }
+
+    void destruirDesde(int inicio) {
+        if (!std::is_trivially_destructible<T>::value) {
+            for (int i = inicio; i < tamanho; i++) {
+                dados[i].~T();
             }
-            
-            delete[] dados;
-            dados = novosDados;
-            capacidade = novaCapacidade;
         }
     }
 
@@ -43,18 +90,70 @@ public:
      * Destrutor
      */
     ~DinamicoArray() {
-        delete[] dados;
+        destruirDesde(0);
+        std::free(dados);
         dados = nullptr;
         tamanho = 0;
         capacidade = 0;
     }
 
+    /**
+     * Garante espaço para pelo menos n elementos sem novas realocações
+     */
+    void reserve(int n) {
+        if (n > capacidade) {
+            realocar(n);
+        }
+    }
+
+    /**
+     * Ajusta o tamanho para n: posições novas recebem T(), as excedentes
+     * são destruídas
+     */
+    void resize(int n) {
+        if (n < tamanho) {
+            destruirDesde(n);
+            tamanho = n;
+            return;
+        }
+        if (n > capacidade) {
+            // Crescimento geométrico: resize(size() + 1) repetido é O(1) amortizado
+            realocar(n > capacidade * 2 ? n : capacidade * 2);
+        }
+        for (int i = tamanho; i < n; i++) {
+            new (dados + i) T();
+        }
+        tamanho = n;
+    }
+
     /**
      * Adiciona um elemento no final
      */
     void push_back(const T& valor) {
-        redimensionar();
-        dados[tamanho++] = valor;
+        emplace_back(valor);
+    }
+
+    /**
+     * Adiciona um elemento no final, movendo-o
+     */
+    void push_back(T&& valor) {
+        emplace_back(std::move(valor));
+    }
+
+    /**
+     * Constrói um elemento no final com os argumentos dados
+     */
+    template<typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (tamanho >= capacidade) {
+            // Os argumentos podem referenciar elementos do próprio array
+            T novo(std::forward<Args>(args)...);
+            redimensionar();
+            new (dados + tamanho) T(std::move(novo));
+        } else {
+            new (dados + tamanho) T(std::forward<Args>(args)...);
+        }
+        return dados[tamanho++];
     }
 
     /**
@@ -64,6 +163,13 @@ public:
         return tamanho;
     }
 
+    /**
+     * Retorna a capacidade reservada
+     */
+    int capacity() const {
+        return capacidade;
+    }
+
     /**
      * Acessa elemento por índice
      */
@@ -79,9 +185,10 @@ public:
     }
 
     /**
-     * Limpa o array
+     * Limpa o array (mantém a capacidade)
      */
     void clear() {
+        destruirDesde(0);
         tamanho = 0;
     }
 
@@ -105,6 +212,25 @@ public:
     const T* data() const {
         return dados;
     }
+
+    /**
+     * Iteradores (ponteiros) para uso em laços for por intervalo
+     */
+    T* begin() {
+        return dados;
+    }
+
+    T* end() {
+        return dados + tamanho;
+    }
+
+    const T* begin() const {
+        return dados;
+    }
+
+    const T* end() const {
+        return dados + tamanho;
+    }
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,105 @@
+#ifndef DISTANCIAS_H
+#define DISTANCIAS_H
+
+/**
+ * Kernels de distância em lote
+ *
+ * Para um bloco de slots candidatos, lê os centros de gravidade nos arrays
+ * de coordenadas da tabela (indexados por slot), calcula o quadrado da
+ * distância euclidiana à origem e descarta quem passa do limite (o R-ésimo
+ * melhor atual), sem raiz quadrada. Só os sobreviventes são devolvidos,
+ * compactados, com seus quadrados; a raiz é tirada apenas para eles.
+ *
+ * O quadrado é calculado exatamente como em calcularDistancia
+ * (dLat * dLat + dLon * dLon), de modo que sqrt(quadrado) é idêntica à
+ * distância escalar. Valores não comparáveis (NaN) nunca são descartados.
+ *
+ * Na métrica geodésica (metrica.hpp) as variantes "Vetores" fazem o mesmo
+ * sobre os vetores unitários (x, y, z) da tabela, intercalados por slot: o
+ * quadrado é o da corda até o vetor da origem, ((dx * dx + dy * dy) + dz * dz).
+ */
+
+/**
+ * Candidatos avaliados por chamada do kernel nas consultas
+ */
+static const int TAMANHO_BLOCO_DISTANCIAS = 256;
+
+/**
+ * Kernels disponíveis
+ * - ESCALAR: um slot por vez
+ * - AVX2: 4 slots por vez (gather de 4 doubles)
+ * - AVX512: 8 slots por vez, com compactação por compress-store
+ * O kernel é escolhido em tempo de execução conforme a CPU (CPUID).
+ */
+enum KernelDistancia {
+    KERNEL_DISTANCIA_ESCALAR,
+    KERNEL_DISTANCIA_AVX2,
+    KERNEL_DISTANCIA_AVX512
+};
+
+/**
+ * Filtra slots pela distância à origem usando o kernel ativo
+ * Mantém os slots com quadrado da distância não maior que limiteQuadrado,
+ * na ordem de entrada, em slotsSaida/quadradosSaida (espaço para n de cada).
+ * Retorna quantos sobreviveram.
+ */
+int filtrarDistancias(const double* latitudes, const double* longitudes,
+                      const int* slots, int n, double latOrigem, double lonOrigem,
+                      double limiteQuadrado, int* slotsSaida, double* quadradosSaida);
+
+/**
+ * Variantes de cada kernel (usadas pelo despacho e pelos benchmarks)
+ * As variantes vetoriais só podem ser chamadas se a CPU as suportar.
+ */
+int filtrarDistanciasEscalar(const double* latitudes, const double* longitudes,
+                             const int* slots, int n, double latOrigem, double lonOrigem,
+                             double limiteQuadrado, int* slotsSaida, double* quadradosSaida);
+int filtrarDistanciasAvx2(const double* latitudes, const double* longitudes,
+                          const int* slots, int n, double latOrigem, double lonOrigem,
+                          double limiteQuadrado, int* slotsSaida, double* quadradosSaida);
+int filtrarDistanciasAvx512(const double* latitudes, const double* longitudes,
+                            const int* slots, int n, double latOrigem, double lonOrigem,
+                            double limiteQuadrado, int* slotsSaida, double* quadradosSaida);
+
+/**
+ * Filtra slots pela corda até a origem (vetor unitário, 3 posições) na
+ * métrica geodésica; mesmo contrato de filtrarDistancias
+ * 'vetores' guarda COMPONENTES_VETOR doubles por slot (x, y, z e uma posição
+ * vazia): os três componentes de um slot ficam na mesma linha de cache.
+ * Os slots precisam ser menores que 2^29 (índices de gather em 32 bits).
+ */
+static const int COMPONENTES_VETOR = 4;
+
+int filtrarDistanciasVetores(const double* vetores, const int* slots, int n,
+                             const double* origem, double limiteQuadrado,
+                             int* slotsSaida, double* quadradosSaida);
+
+int filtrarDistanciasVetoresEscalar(const double* vetores, const int* slots, int n,
+                                    const double* origem, double limiteQuadrado,
+                                    int* slotsSaida, double* quadradosSaida);
+int filtrarDistanciasVetoresAvx2(const double* vetores, const int* slots, int n,
+                                 const double* origem, double limiteQuadrado,
+                                 int* slotsSaida, double* quadradosSaida);
+int filtrarDistanciasVetoresAvx512(const double* vetores, const int* slots, int n,
+                                   const double* origem, double limiteQuadrado,
+                                   int* slotsSaida, double* quadradosSaida);
+
+/**
+ * Melhor kernel suportado pela CPU
+ */
+KernelDistancia detectarKernelDistancia();
+
+/**
+ * Kernel em uso / força um kernel (não deve exceder o suportado pela CPU)
+ */
+KernelDistancia getKernelDistancia();
+void setKernelDistancia(KernelDistancia kernel);
+
+/**
+ * Limite de quadrado equivalente a uma distância: todo quadrado maior que
+ * ele tem raiz estritamente maior que 'distancia' (folga para o
+ * arredondamento da raiz). Infinito se a distância não for finita.
+ */
+double limiteQuadradoDistancia(double distancia);
+
+#endif // DISTANCIAS_H
\ No newline at end of file
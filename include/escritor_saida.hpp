@@ -0,0 +1,84 @@
+#ifndef ESCRITOR_SAIDA_H
+#define ESCRITOR_SAIDA_H
+
+#include "utils.hpp"
+#include <cstring>
+
+// Tamanho do buffer de saída; ao encher, é escrito de uma vez
+static const int TAMANHO_BUFFER_SAIDA = 1 << 20;
+
+/**
+ * TAD EscritorSaida
+ *
+ * Saída bufferizada sobre um descritor de arquivo. Os textos são copiados
+ * para um buffer grande em memória, escrito com write() só quando enche ou
+ * em descarregar(), em vez de um flush por linha. Escrever uma linha já
+ * formatada é uma cópia de memória.
+ */
+class EscritorSaida {
+private:
+    int descritor;
+    char* buffer;
+    int usado;
+    bool falhou;                // Alguma escrita no descritor falhou
+
+public:
+    /**
+     * Construtor
+     */
+    EscritorSaida(int descritor);
+
+    /**
+     * Destrutor: descarrega o que restou no buffer
+     */
+    ~EscritorSaida();
+
+    /**
+     * Acrescenta 'tamanho' bytes à saída
+     */
+    void escrever(const char* texto, int tamanho) {
+        if (tamanho > TAMANHO_BUFFER_SAIDA - usado) {
+            escreverLongo(texto, tamanho);
+            return;
+        }
+        std::memcpy(buffer + usado, texto, tamanho);
+        usado += tamanho;
+    }
+
+    /**
+     * Acrescenta um caractere à saída
+     */
+    void escreverCaractere(char c) {
+        if (usado == TAMANHO_BUFFER_SAIDA) {
+            descarregar();
+        }
+        buffer[usado++] = c;
+    }
+
+    /**
+     * Acrescenta um inteiro em decimal à saída
+     */
+    void escreverInteiro(int valor) {
+        if (TAMANHO_BUFFER_SAIDA - usado < TAMANHO_MAXIMO_INTEIRO) {
+            descarregar();
+        }
+        usado += formatarInteiro(valor, buffer + usado);
+    }
+
+    /**
+     * Escreve o conteúdo do buffer no descritor
+     * Retorna false se alguma escrita (desta ou de chamadas anteriores) falhou.
+     */
+    bool descarregar();
+
+private:
+    /**
+     * Texto que não cabe no espaço livre: descarrega e escreve o restante
+     */
+    void escreverLongo(const char* texto, int tamanho);
+
+    EscritorSaida(const EscritorSaida&);
+    EscritorSaida& operator=(const EscritorSaida&);
+};
+
+#endif // ESCRITOR_SAIDA_H
\ No newline at end of file
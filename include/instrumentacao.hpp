@@ -0,0 +1,136 @@
+#ifndef INSTRUMENTACAO_H
+#define INSTRUMENTACAO_H
+
+#include <chrono>
+#include <ostream>
+
+/**
+ * Instrumentação por fase da construção do índice e das consultas
+ *
+ * Só existe quando compilada com INSTRUMENTACAO definido (make
+ * INSTRUMENTACAO=1; ao trocar, rode make clean). Sem a flag, as macros
+ * INSTR_* não geram código e o executável é o mesmo de antes.
+ *
+ * Cada thread acumula numa Instrumentacao própria, apontada por
+ * instrumentacaoAtual durante um INSTR_ESCOPO (a da área de trabalho em
+ * Consulta::executar, ou a da construção em main): os pontos medidos não
+ * recebem parâmetros extras nem disputam contadores. Ao fim, main soma as de
+ * todas as threads.
+ * Com várias threads, o tempo das fases de consulta é a soma entre elas.
+ */
+
+/**
+ * Fases medidas (tempo em ns)
+ */
+enum FaseInstrumentada {
+    FASE_LEITURA = 0,           // Interpretação das linhas de endereço
+    FASE_AGREGACAO,             // Agrupamento por IdLog (Mapa) e médias
+    FASE_INDEXACAO,             // Inserção das palavras no índice
+    FASE_CONGELAMENTO,          // Tabela de logradouros + congelamento do índice
+    FASE_TERMOS,                // Consulta, fase 1: termos e listas de postings
+    FASE_INTERSECAO,            // Consulta, fase 2: interseção das listas
+    FASE_SELECAO,               // Consulta, fase 3: seleção dos R melhores
+    NUM_FASES
+};
+
+/**
+ * Contadores de eventos
+ */
+enum ContadorInstrumentado {
+    CONTADOR_LINHAS_LIDAS = 0,          // Linhas de endereço interpretadas
+    CONTADOR_LINHAS_REJEITADAS,         // Linhas de endereço ou consulta descartadas
+    CONTADOR_CONSULTAS,                 // Consultas executadas (sem acertos de cache)
+    CONTADOR_POSTINGS_LIDOS,            // Soma dos tamanhos das listas dos termos
+    CONTADOR_CANDIDATOS_INTERSECAO,     // Soma dos tamanhos das interseções materializadas
+    CONTADOR_CANDIDATOS_AVALIADOS,      // Slots com a distância calculada
+    CONTADOR_SUBSTITUICOES_HEAP,        // Candidatos que tiraram o pior de uma heap cheia
+    NUM_CONTADORES
+};
+
+struct Instrumentacao {
+    long long ns[NUM_FASES];
+    long long contadores[NUM_CONTADORES];
+
+    Instrumentacao();
+
+    /**
+     * Soma os valores de outra instrumentação a esta
+     */
+    void acumular(const Instrumentacao& outra);
+
+    /**
+     * Escreve uma linha por fase e por contador ("nome=valor")
+     */
+    void escreverTexto(std::ostream& saida) const;
+
+    /**
+     * Grava um objeto JSON em 'caminho'; retorna false se não conseguir
+     */
+    bool escreverJson(const char* caminho) const;
+};
+
+/**
+ * Relógio monotônico em ns usado pelas macros
+ */
+inline long long instrumentacaoRelogioNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#ifdef INSTRUMENTACAO
+
+static const bool INSTRUMENTACAO_ATIVA = true;
+
+/**
+ * Instrumentação em que a thread atual acumula (nullptr: nada é registrado)
+ */
+extern thread_local Instrumentacao* instrumentacaoAtual;
+
+/**
+ * Aponta instrumentacaoAtual para outra instrumentação até o fim do escopo
+ */
+class EscopoInstrumentacao {
+private:
+    Instrumentacao* anterior;
+
+public:
+    EscopoInstrumentacao(Instrumentacao* instrumentacao) : anterior(instrumentacaoAtual) {
+        instrumentacaoAtual = instrumentacao;
+    }
+
+    ~EscopoInstrumentacao() {
+        instrumentacaoAtual = anterior;
+    }
+};
+
+#define INSTR_ESCOPO(instrumentacao) EscopoInstrumentacao escopoInstrumentacao(instrumentacao)
+
+#define INSTR_CONTAR(contador, valor)                                       \
+    do {                                                                    \
+        if (instrumentacaoAtual != nullptr) {                               \
+            instrumentacaoAtual->contadores[contador] += (valor);           \
+        }                                                                   \
+    } while (0)
+
+// Marca o início de um trecho; INSTR_FIM_FASE soma o tempo desde a marca
+#define INSTR_INICIO_FASE(marca) long long marca = instrumentacaoRelogioNs()
+
+#define INSTR_FIM_FASE(fase, marca)                                         \
+    do {                                                                    \
+        if (instrumentacaoAtual != nullptr) {                               \
+            instrumentacaoAtual->ns[fase] += instrumentacaoRelogioNs() - (marca); \
+        }                                                                   \
+    } while (0)
+
+#else
+
+static const bool INSTRUMENTACAO_ATIVA = false;
+
+#define INSTR_ESCOPO(instrumentacao) ((void)0)
+#define INSTR_CONTAR(contador, valor) ((void)0)
+#define INSTR_INICIO_FASE(marca) ((void)0)
+#define INSTR_FIM_FASE(fase, marca) ((void)0)
+
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,161 @@
+#ifndef INTERSECAO_H
+#define INTERSECAO_H
+
+#include "palavra.hpp"
+
+/**
+ * Motor de interseção de listas de postings
+ *
+ * Ordena as listas por tamanho e conduz a interseção a partir da menor.
+ * Cada lista seguinte é intersectada com os candidatos atuais por:
+ * - merge: varredura sequencial, saltando blocos pelos cabeçalhos
+ * - galope: busca exponencial nos cabeçalhos e dentro do bloco
+ * A escolha depende da razão entre o tamanho da lista e o número de candidatos.
+ * Listas densas em formato Roaring são consultadas por pertinência (teste de
+ * bit ou busca no container), e duas listas Roaring se intersectam container
+ * a container com AND de palavras de 64 bits.
+ *
+ * Todo o trabalho acontece num único buffer de saída reutilizável.
+ */
+
+/**
+ * Razão (tamanho da lista / candidatos) a partir da qual se usa galope
+ */
+static const int LIMIAR_RAZAO_GALOPE = 16;
+
+/**
+ * Buffer reutilizável para o resultado da interseção
+ * Só cresce; a memória é liberada no destrutor
+ */
+class BufferIntersecao {
+private:
+    int* dados;
+    int capacidade;
+
+public:
+    BufferIntersecao();
+    ~BufferIntersecao();
+
+    /**
+     * Garante espaço para pelo menos n inteiros (o conteúdo não é preservado)
+     */
+    void garantir(int n);
+
+    int* getDados();
+    int getCapacidade() const;
+
+private:
+    BufferIntersecao(const BufferIntersecao&);
+    BufferIntersecao& operator=(const BufferIntersecao&);
+};
+
+/**
+ * Kernels de interseção de dois arrays ordenados sem repetição
+ * - ESCALAR: merge clássico
+ * - SSE: compara blocos de 4 x 4 ids (SSE4.2 + POPCNT)
+ * - AVX2: compara blocos de 8 x 8 ids
+ * O kernel é escolhido em tempo de execução conforme a CPU (CPUID).
+ */
+enum KernelIntersecao {
+    KERNEL_ESCALAR,
+    KERNEL_SSE,
+    KERNEL_AVX2
+};
+
+/**
+ * Folga exigida no array de saída dos kernels vetoriais, que gravam
+ * blocos inteiros de lanes além do último resultado
+ */
+static const int FOLGA_SAIDA_INTERSECAO = 8;
+
+/**
+ * Interseção de dois arrays ordenados usando o kernel ativo
+ * 'resultado' não pode se sobrepor às entradas e precisa de espaço para
+ * min(tam1, tam2) + FOLGA_SAIDA_INTERSECAO inteiros. Retorna o tamanho.
+ */
+int intersecaoDuasListas(const int* lista1, int tam1,
+                         const int* lista2, int tam2,
+                         int* resultado);
+
+/**
+ * Variantes de cada kernel (usadas pelo despacho e pelos benchmarks)
+ * As variantes vetoriais só podem ser chamadas se a CPU as suportar.
+ */
+int intersecaoDuasListasEscalar(const int* lista1, int tam1,
+                                const int* lista2, int tam2,
+                                int* resultado);
+int intersecaoDuasListasSse(const int* lista1, int tam1,
+                            const int* lista2, int tam2,
+                            int* resultado);
+int intersecaoDuasListasAvx2(const int* lista1, int tam1,
+                             const int* lista2, int tam2,
+                             int* resultado);
+
+/**
+ * Melhor kernel suportado pela CPU
+ */
+KernelIntersecao detectarKernelIntersecao();
+
+/**
+ * Kernel em uso / força um kernel (não deve exceder o suportado pela CPU)
+ */
+KernelIntersecao getKernelIntersecao();
+void setKernelIntersecao(KernelIntersecao kernel);
+
+/**
+ * Intersecta candidatos (ordenados) com uma lista comprimida por merge
+ * Cada bloco da lista é descomprimido e intersectado com a faixa de
+ * candidatos que ele cobre usando o kernel ativo.
+ * O resultado é escrito sobre 'candidatos'; retorna o novo tamanho
+ */
+int intersecaoMerge(int* candidatos, int numCandidatos, const ListaPostings& lista);
+
+/**
+ * Intersecta candidatos (ordenados) com uma lista comprimida por galope
+ * O resultado é escrito sobre 'candidatos'; retorna o novo tamanho
+ */
+int intersecaoGalope(int* candidatos, int numCandidatos, const ListaPostings& lista);
+
+/**
+ * Intersecta candidatos (ordenados) com uma lista em formato Roaring
+ * O resultado é escrito sobre 'candidatos'; retorna o novo tamanho
+ */
+int intersecaoComRoaring(int* candidatos, int numCandidatos, const ListaPostings& lista);
+
+/**
+ * Interseção de duas listas em formato Roaring, container a container
+ * 'resultado' precisa de espaço para min(a.tamanho, b.tamanho) inteiros.
+ * Retorna o tamanho.
+ */
+int intersecaoRoaring(const ListaPostings& a, const ListaPostings& b, int* resultado);
+
+/**
+ * Ordena as listas por tamanho crescente (a primeira conduz a interseção)
+ */
+void ordenarListasPorTamanho(ListaPostings* listas, int numListas);
+
+/**
+ * Interseção de várias listas, da menor para a maior
+ * Reordena o array 'listas' por tamanho. O resultado fica em buffer.getDados().
+ * Retorna o número de slots na interseção.
+ */
+int intersectarListas(ListaPostings* listas, int numListas, BufferIntersecao& buffer);
+
+/**
+ * Intersecta candidatos (ordenados) com cada lista, na ordem dada (listas
+ * menores primeiro), escolhendo merge, galope ou pertinência por lista
+ * O resultado é escrito sobre 'candidatos'; retorna o novo tamanho
+ */
+int refinarCandidatos(int* candidatos, int numCandidatos,
+                      const ListaPostings* listas, int numListas);
+
+/**
+ * Interseção de várias listas restrita aos slots em [inicio, fim)
+ * As listas já devem estar ordenadas por tamanho. Só a faixa da primeira é
+ * descomprimida; as demais são consultadas por pertinência.
+ * O resultado fica em buffer.getDados(). Retorna o número de slots.
+ */
+int intersectarListasFaixa(const ListaPostings* listas, int numListas,
+                           int inicio, int fim, BufferIntersecao& buffer);
+
+#endif // INTERSECAO_H
\ No newline at end of file
@@ -0,0 +1,157 @@
+#ifndef LEITOR_ENTRADA_H
+#define LEITOR_ENTRADA_H
+
+#include <string>
+#include <cstddef>
+
+// Tamanho do bloco lido por vez quando a entrada não pode ser mapeada
+static const int TAMANHO_BLOCO_LEITURA = 1 << 20;
+
+/**
+ * Trecho de texto que não é dono dos caracteres (ponteiro + tamanho)
+ * Válido enquanto o buffer de onde veio não for reaproveitado.
+ */
+struct VisaoTexto {
+    const char* dados;
+    int tamanho;
+
+    VisaoTexto() : dados(nullptr), tamanho(0) {}
+    VisaoTexto(const char* dados, int tamanho) : dados(dados), tamanho(tamanho) {}
+
+    bool vazia() const { return tamanho == 0; }
+    std::string paraString() const { return std::string(dados, tamanho); }
+};
+
+/**
+ * Remove espaços em branco do início e do fim, sem copiar
+ */
+VisaoTexto aparar(VisaoTexto texto);
+
+/**
+ * Separa o próximo campo de 'resto' até o delimitador (ou o fim) e avança
+ * 'resto' para depois do delimitador. Retorna false se 'resto' já acabou.
+ */
+bool proximoCampo(VisaoTexto& resto, char delim, VisaoTexto& campo);
+
+/**
+ * Divide a linha nos campos separados pelo delimitador, sem copiar
+ * Preenche até 'maxCampos' posições de 'campos' (campos vazios mantêm a
+ * posição) e retorna o número total de campos da linha.
+ */
+int dividirCampos(VisaoTexto linha, char delim, VisaoTexto* campos, int maxCampos);
+
+/**
+ * Colunas de uma linha de endereço:
+ * idEnd;IdLog;TipoLog;Log;Num;Bairro;Regiao;CEP;Lat;Long
+ * Só as colunas usadas pelo índice são interpretadas.
+ */
+static const int NUM_CAMPOS_ENDERECO = 10;
+static const int CAMPO_ID_LOGRADOURO = 1;
+static const int CAMPO_NOME_LOGRADOURO = 3;
+static const int CAMPO_LATITUDE = 8;
+static const int CAMPO_LONGITUDE = 9;
+
+/**
+ * Campos de uma linha de endereço usados na construção (visões da linha)
+ */
+struct CamposEndereco {
+    VisaoTexto idLog;
+    int id;                     // IdLog convertido
+    VisaoTexto nome;
+    double lat;
+    double lon;
+};
+
+/**
+ * Contagem das linhas descartadas na leitura da entrada, por motivo
+ */
+struct ContadoresCarga {
+    int linhasVazias;
+    int camposIncorretos;       // Número de campos diferente do esperado
+    int numerosInvalidos;       // IdLog, coordenada ou id de consulta inválido
+    int consultasRejeitadas;    // Linhas de consulta descartadas (qualquer motivo)
+
+    ContadoresCarga()
+        : linhasVazias(0), camposIncorretos(0), numerosInvalidos(0), consultasRejeitadas(0) {}
+
+    /**
+     * Linhas com conteúdo que foram descartadas (as vazias não contam)
+     */
+    int getRejeitadas() const { return camposIncorretos + numerosInvalidos; }
+};
+
+/**
+ * Interpreta uma linha de endereço; retorna false se ela deve ser ignorada
+ * (vazia, sem os 10 campos ou com IdLog/coordenadas inválidos) e, nesse
+ * caso, registra o motivo em 'contadores' (se informado)
+ */
+bool interpretarEndereco(VisaoTexto linha, CamposEndereco& endereco,
+                         ContadoresCarga* contadores = nullptr);
+
+/**
+ * Verifica se uma linha rejeitada por interpretarEndereco conta entre as N
+ * linhas de endereço: só a que tem os 10 campos (com números inválidos).
+ * A vazia e a sem os 10 campos ficam fora, como na versão original.
+ */
+bool contaComoEndereco(VisaoTexto linha);
+
+/**
+ * TAD LeitorEntrada
+ *
+ * Leitor de linhas em fluxo sobre um descritor de arquivo. Se o descritor
+ * é um arquivo regular, ele é mapeado inteiro com mmap e as linhas apontam
+ * direto para as páginas do arquivo; caso contrário (pipe, terminal), é lido
+ * em blocos grandes para um buffer reaproveitado. Nenhuma alocação é feita
+ * por linha.
+ */
+class LeitorEntrada {
+private:
+    int descritor;
+
+    // Arquivo mapeado (nullptr se lido em blocos)
+    char* mapeado;
+    size_t tamanhoMapeado;
+
+    // Buffer da leitura em blocos
+    char* buffer;
+    int capacidade;
+
+    // Janela de bytes ainda não consumidos
+    const char* atual;
+    const char* fim;
+    bool fimArquivo;
+
+    /**
+     * Move o resto não consumido para o início do buffer (dobrando-o se
+     * uma linha não couber) e lê o próximo bloco. Retorna false no fim.
+     */
+    bool recarregar();
+
+public:
+    /**
+     * Construtor: lê a partir da posição atual do descritor
+     */
+    LeitorEntrada(int descritor);
+
+    /**
+     * Destrutor: libera o buffer ou desfaz o mapeamento
+     */
+    ~LeitorEntrada();
+
+    /**
+     * Retorna a próxima linha (sem o '\n') em 'linha'
+     * A visão vale até a próxima chamada. Retorna false no fim da entrada.
+     */
+    bool proximaLinha(VisaoTexto& linha);
+
+    /**
+     * Retorna a próxima linha que não seja só espaços, já aparada
+     */
+    bool proximaLinhaNaoVazia(VisaoTexto& linha);
+
+private:
+    LeitorEntrada(const LeitorEntrada&);
+    LeitorEntrada& operator=(const LeitorEntrada&);
+};
+
+#endif // LEITOR_ENTRADA_H
\ No newline at end of file
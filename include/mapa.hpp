@@ -2,166 +2,290 @@
 #define MAPA_H
 
 #include <string>
+#include <utility>
+#include "arena.hpp"
 
 /**
- * TAD Mapa<K, V>
- * 
- * Implementação manual de uma estrutura de "mapa"
- * Usa Árvore AVL para manter ordem e busca eficiente O(log n)
- * 
- * Funcionalidades necessárias:
- * - Inserir par chave-valor
- * - Buscar valor por chave
- * - Verificar existência de chave
- * - Iterar sobre pares
+ * Máximo de chaves por nó da árvore do Mapa
+ * Com chaves curtas, um nó interno inteiro cabe em poucas linhas de cache e a
+ * busca dentro do nó é uma busca binária sobre um array contíguo
  */
+static const int ORDEM_MAPA = 16;
 
-template<typename K, typename V>
-struct ParChaveValor {
-    K chave;
-    V valor;
+/**
+ * Cabeçalho comum aos nós da árvore: o tipo do nó (folha ou interno) é
+ * determinado pelo nível em que ele está, pois todas as folhas têm a mesma
+ * profundidade
+ */
+struct NodoMapaBase {
+    int numChaves;
 
-    ParChaveValor() : chave(K()), valor(V()) {}
-    ParChaveValor(const K& k, const V& v) : chave(k), valor(v) {}
+    NodoMapaBase() : numChaves(0) {}
 };
 
+/**
+ * Folha: guarda os pares em ordem crescente de chave e aponta para a folha
+ * seguinte, de modo que a iteração em ordem é uma varredura da lista de folhas
+ */
 template<typename K, typename V>
-struct NodoMapa {
-    K chave;
-    V valor;
-    NodoMapa* esq;
-    NodoMapa* dir;
-    int altura;
-
-    NodoMapa(const K& k, const V& v)
-        : chave(k), valor(v), esq(nullptr), dir(nullptr), altura(1) {}
-
-    ~NodoMapa() {
-        // Nós serão deletados recursivamente
-    }
+struct FolhaMapa : NodoMapaBase {
+    K chaves[ORDEM_MAPA];
+    V valores[ORDEM_MAPA];
+    FolhaMapa* prox;
+
+    FolhaMapa() : chaves(), valores(), prox(nullptr) {}
 };
 
+/**
+ * Nó interno: filhos[i] contém as chaves em [chaves[i - 1], chaves[i])
+ */
+template<typename K>
+struct InternoMapa : NodoMapaBase {
+    K chaves[ORDEM_MAPA];
+    NodoMapaBase* filhos[ORDEM_MAPA + 1];
+
+    InternoMapa() : chaves(), filhos() {}
+};
+
+/**
+ * TAD Mapa<K, V>
+ *
+ * Implementação manual de uma estrutura de "mapa"
+ * Usa uma Árvore B+ com até ORDEM_MAPA chaves por nó: a altura é
+ * O(log_ORDEM n) e cada nível custa um acesso a um bloco contíguo de chaves,
+ * em vez de um nó alocado por entrada. Os nós vêm de ArenaTipadas do próprio
+ * mapa e são liberados em bloco. O número de pares é mantido em um contador.
+ *
+ * K precisa de construtor padrão, operator< e operator==; V, de construtor
+ * padrão e atribuição. Referências e ponteiros para valores valem até a
+ * próxima inserção (uma divisão de folha move os pares).
+ *
+ * Funcionalidades necessárias:
+ * - Inserir par chave-valor
+ * - Buscar valor por chave
+ * - Buscar ou inserir em uma única descida
+ * - Verificar existência de chave
+ * - Iterar sobre pares em ordem, sem cópia
+ */
 template<typename K, typename V>
 class Mapa {
 private:
-    NodoMapa<K, V>* raiz;
+    NodoMapaBase* raiz;
+    int altura;                     // Níveis da árvore (1: a raiz é folha)
+    int numPares;
+    FolhaMapa<K, V>* primeiraFolha;
+    ArenaTipada<FolhaMapa<K, V> > folhas;
+    ArenaTipada<InternoMapa<K> > internos;
 
-    int altura(NodoMapa<K, V>* nodo) const {
-        return nodo == nullptr ? 0 : nodo->altura;
-    }
+    // Não copiável: os nós pertencem às arenas deste mapa
+    Mapa(const Mapa&);
+    Mapa& operator=(const Mapa&);
 
-    int fatorBalanceamento(NodoMapa<K, V>* nodo) const {
-        return nodo == nullptr ? 0 : altura(nodo->esq) - altura(nodo->dir);
+    /**
+     * Índice do filho de um nó interno que pode conter a chave
+     * (primeira separadora maior que a chave)
+     */
+    static int indiceFilho(const InternoMapa<K>* interno, const K& chave) {
+        int baixo = 0;
+        int alto = interno->numChaves;
+        while (baixo < alto) {
+            int meio = (baixo + alto) >> 1;
+            if (chave < interno->chaves[meio]) {
+                alto = meio;
+            } else {
+                baixo = meio + 1;
+            }
+        }
+        return baixo;
     }
 
-    NodoMapa<K, V>* rotacaoDireita(NodoMapa<K, V>* y) {
-        NodoMapa<K, V>* x = y->esq;
-        NodoMapa<K, V>* T2 = x->dir;
-
-        x->dir = y;
-        y->esq = T2;
-
-        y->altura = 1 + (altura(y->esq) > altura(y->dir) ? altura(y->esq) : altura(y->dir));
-        x->altura = 1 + (altura(x->esq) > altura(x->dir) ? altura(x->esq) : altura(x->dir));
-
-        return x;
+    /**
+     * Posição da chave na folha, ou onde ela seria inserida
+     * (primeira chave não menor que a procurada)
+     */
+    static int posicaoNaFolha(const FolhaMapa<K, V>* folha, const K& chave) {
+        int baixo = 0;
+        int alto = folha->numChaves;
+        while (baixo < alto) {
+            int meio = (baixo + alto) >> 1;
+            if (folha->chaves[meio] < chave) {
+                baixo = meio + 1;
+            } else {
+                alto = meio;
+            }
+        }
+        return baixo;
     }
 
-    NodoMapa<K, V>* rotacaoEsquerda(NodoMapa<K, V>* x) {
-        NodoMapa<K, V>* y = x->dir;
-        NodoMapa<K, V>* T2 = y->esq;
-
-        y->esq = x;
-        x->dir = T2;
-
-        x->altura = 1 + (altura(x->esq) > altura(x->dir) ? altura(x->esq) : altura(x->dir));
-        y->altura = 1 + (altura(y->esq) > altura(y->dir) ? altura(y->esq) : altura(y->dir));
-
-        return y;
+    /**
+     * Desce da raiz até a folha que pode conter a chave
+     */
+    FolhaMapa<K, V>* buscarFolha(const K& chave) const {
+        NodoMapaBase* nodo = raiz;
+        for (int nivel = altura; nivel > 1; nivel--) {
+            const InternoMapa<K>* interno = static_cast<const InternoMapa<K>*>(nodo);
+            nodo = interno->filhos[indiceFilho(interno, chave)];
+        }
+        return static_cast<FolhaMapa<K, V>*>(nodo);
     }
 
-    NodoMapa<K, V>* inserirRec(NodoMapa<K, V>* nodo, const K& chave, const V& valor) {
-        if (nodo == nullptr) {
-            return new NodoMapa<K, V>(chave, valor);
+    /**
+     * Valor da chave, ou nullptr se ela não estiver no mapa
+     */
+    V* buscarValor(const K& chave) const {
+        if (raiz == nullptr) {
+            return nullptr;
+        }
+        FolhaMapa<K, V>* folha = buscarFolha(chave);
+        int i = posicaoNaFolha(folha, chave);
+        if (i < folha->numChaves && folha->chaves[i] == chave) {
+            return &folha->valores[i];
         }
+        return nullptr;
+    }
 
-        if (chave < nodo->chave) {
-            nodo->esq = inserirRec(nodo->esq, chave, valor);
-        } else if (chave > nodo->chave) {
-            nodo->dir = inserirRec(nodo->dir, chave, valor);
+    /**
+     * Divide o filho cheio pai->filhos[i] em dois, inserindo a separadora
+     * no pai (que não está cheio). Numa folha a separadora é copiada (a
+     * primeira chave da nova folha); num nó interno ela sobe para o pai.
+     */
+    void dividirFilho(InternoMapa<K>* pai, int i, bool filhoEhFolha) {
+        const int meio = ORDEM_MAPA / 2;
+        NodoMapaBase* novo;
+        K separadora;
+
+        if (filhoEhFolha) {
+            FolhaMapa<K, V>* folha = static_cast<FolhaMapa<K, V>*>(pai->filhos[i]);
+            FolhaMapa<K, V>* irmao = folhas.criar();
+            for (int j = meio; j < ORDEM_MAPA; j++) {
+                irmao->chaves[j - meio] = std::move(folha->chaves[j]);
+                irmao->valores[j - meio] = std::move(folha->valores[j]);
+            }
+            irmao->numChaves = ORDEM_MAPA - meio;
+            folha->numChaves = meio;
+            irmao->prox = folha->prox;
+            folha->prox = irmao;
+            separadora = irmao->chaves[0];
+            novo = irmao;
         } else {
-            // Chave existe, atualiza valor
-            nodo->valor = valor;
-            return nodo;
+            InternoMapa<K>* interno = static_cast<InternoMapa<K>*>(pai->filhos[i]);
+            InternoMapa<K>* irmao = internos.criar();
+            separadora = std::move(interno->chaves[meio]);
+            for (int j = meio + 1; j < ORDEM_MAPA; j++) {
+                irmao->chaves[j - meio - 1] = std::move(interno->chaves[j]);
+            }
+            for (int j = meio + 1; j <= ORDEM_MAPA; j++) {
+                irmao->filhos[j - meio - 1] = interno->filhos[j];
+            }
+            irmao->numChaves = ORDEM_MAPA - meio - 1;
+            interno->numChaves = meio;
+            novo = irmao;
         }
 
-        nodo->altura = 1 + (altura(nodo->esq) > altura(nodo->dir) ? 
-                            altura(nodo->esq) : altura(nodo->dir));
-
-        int fb = fatorBalanceamento(nodo);
-
-        // Caso Left-Left
-        if (fb > 1 && chave < nodo->esq->chave) {
-            return rotacaoDireita(nodo);
+        for (int j = pai->numChaves; j > i; j--) {
+            pai->chaves[j] = std::move(pai->chaves[j - 1]);
+            pai->filhos[j + 1] = pai->filhos[j];
         }
+        pai->chaves[i] = std::move(separadora);
+        pai->filhos[i + 1] = novo;
+        pai->numChaves++;
+    }
 
-        // Caso Right-Right
-        if (fb < -1 && chave > nodo->dir->chave) {
-            return rotacaoEsquerda(nodo);
+    /**
+     * Retorna o endereço do valor da chave, inserindo-a com 'valor' se ela
+     * não existir. Nós cheios são divididos na própria descida (mesmo que a
+     * chave já exista), então a folha final sempre tem espaço.
+     */
+    V* localizarOuInserir(const K& chave, const V& valor, bool& inserido) {
+        if (raiz == nullptr) {
+            primeiraFolha = folhas.criar();
+            raiz = primeiraFolha;
+            altura = 1;
         }
-
-        // Caso Left-Right
-        if (fb > 1 && chave > nodo->esq->chave) {
-            nodo->esq = rotacaoEsquerda(nodo->esq);
-            return rotacaoDireita(nodo);
+        if (raiz->numChaves == ORDEM_MAPA) {
+            InternoMapa<K>* novaRaiz = internos.criar();
+            novaRaiz->filhos[0] = raiz;
+            dividirFilho(novaRaiz, 0, altura == 1);
+            raiz = novaRaiz;
+            altura++;
         }
 
-        // Caso Right-Left
-        if (fb < -1 && chave < nodo->dir->chave) {
-            nodo->dir = rotacaoDireita(nodo->dir);
-            return rotacaoEsquerda(nodo);
+        NodoMapaBase* nodo = raiz;
+        for (int nivel = altura; nivel > 1; nivel--) {
+            InternoMapa<K>* interno = static_cast<InternoMapa<K>*>(nodo);
+            int i = indiceFilho(interno, chave);
+            if (interno->filhos[i]->numChaves == ORDEM_MAPA) {
+                dividirFilho(interno, i, nivel == 2);
+                if (!(chave < interno->chaves[i])) {
+                    i++;
+                }
+            }
+            nodo = interno->filhos[i];
         }
 
-        return nodo;
+        FolhaMapa<K, V>* folha = static_cast<FolhaMapa<K, V>*>(nodo);
+        int posicao = posicaoNaFolha(folha, chave);
+        if (posicao < folha->numChaves && folha->chaves[posicao] == chave) {
+            inserido = false;
+            return &folha->valores[posicao];
+        }
+        for (int j = folha->numChaves; j > posicao; j--) {
+            folha->chaves[j] = std::move(folha->chaves[j - 1]);
+            folha->valores[j] = std::move(folha->valores[j - 1]);
+        }
+        folha->chaves[posicao] = chave;
+        folha->valores[posicao] = valor;
+        folha->numChaves++;
+        numPares++;
+        inserido = true;
+        return &folha->valores[posicao];
     }
 
-    NodoMapa<K, V>* buscarRec(NodoMapa<K, V>* nodo, const K& chave) const {
-        if (nodo == nullptr) {
-            return nullptr;
+public:
+    /**
+     * Percorre os pares em ordem crescente de chave sem copiá-los
+     *
+     * Uso: for (Mapa<K, V>::Iterador it = mapa.iterar(); it.valido(); it.avancar())
+     * Inserir no mapa durante a iteração invalida o iterador.
+     */
+    class Iterador {
+    private:
+        FolhaMapa<K, V>* folha;
+        int indice;
+
+    public:
+        Iterador(FolhaMapa<K, V>* folha) : folha(folha), indice(0) {
+            while (this->folha != nullptr && this->folha->numChaves == 0) {
+                this->folha = this->folha->prox;
+            }
         }
 
-        if (chave == nodo->chave) {
-            return nodo;
-        } else if (chave < nodo->chave) {
-            return buscarRec(nodo->esq, chave);
-        } else {
-            return buscarRec(nodo->dir, chave);
+        bool valido() const {
+            return folha != nullptr;
         }
-    }
 
-    void desalocarRec(NodoMapa<K, V>* nodo) {
-        if (nodo == nullptr) {
-            return;
+        void avancar() {
+            indice++;
+            if (indice == folha->numChaves) {
+                folha = folha->prox;
+                indice = 0;
+            }
         }
-        desalocarRec(nodo->esq);
-        desalocarRec(nodo->dir);
-        delete nodo;
-    }
 
-    void coletarParesRec(NodoMapa<K, V>* nodo, ParChaveValor<K, V>* pares, int& idx) const {
-        if (nodo == nullptr) {
-            return;
+        const K& chave() const {
+            return folha->chaves[indice];
         }
-        coletarParesRec(nodo->esq, pares, idx);
-        pares[idx++] = ParChaveValor<K, V>(nodo->chave, nodo->valor);
-        coletarParesRec(nodo->dir, pares, idx);
-    }
 
-public:
-    Mapa() : raiz(nullptr) {}
+        V& valor() const {
+            return folha->valores[indice];
+        }
+    };
+
+    Mapa() : raiz(nullptr), altura(0), numPares(0), primeiraFolha(nullptr) {}
 
     ~Mapa() {
-        desalocarRec(raiz);
+        folhas.liberarTudo();
+        internos.liberarTudo();
         raiz = nullptr;
     }
 
@@ -169,7 +293,20 @@ public:
      * Insere ou atualiza um par chave-valor
      */
     void inserir(const K& chave, const V& valor) {
-        raiz = inserirRec(raiz, chave, valor);
+        bool inserido = false;
+        V* destino = localizarOuInserir(chave, valor, inserido);
+        if (!inserido) {
+            *destino = valor;
+        }
+    }
+
+    /**
+     * Retorna o valor da chave, inserindo-a com V() se ainda não existir
+     * 'inserido' indica se a chave era nova. A referência vale até a próxima
+     * inserção.
+     */
+    V& obterOuInserir(const K& chave, bool& inserido) {
+        return *localizarOuInserir(chave, V(), inserido);
     }
 
     /**
@@ -177,67 +314,42 @@ public:
      * Retorna ponteiro para o valor ou nullptr
      */
     V* buscar(const K& chave) {
-        NodoMapa<K, V>* nodo = buscarRec(raiz, chave);
-        if (nodo != nullptr) {
-            return &(nodo->valor);
-        }
-        return nullptr;
+        return buscarValor(chave);
     }
 
     /**
      * Busca um valor pela chave (const)
      */
     const V* buscar(const K& chave) const {
-        NodoMapa<K, V>* nodo = buscarRec(raiz, chave);
-        if (nodo != nullptr) {
-            return &(nodo->valor);
-        }
-        return nullptr;
+        return buscarValor(chave);
     }
 
     /**
      * Verifica se chave existe
      */
     bool contem(const K& chave) const {
-        return buscarRec(raiz, chave) != nullptr;
+        return buscarValor(chave) != nullptr;
     }
 
     /**
-     * Retorna número de pares
+     * Retorna número de pares (O(1))
      */
     int tamanho() const {
-        return contarNodosRec(raiz);
+        return numPares;
     }
 
     /**
      * Retorna true se vazio
      */
     bool vazio() const {
-        return raiz == nullptr;
+        return numPares == 0;
     }
 
     /**
-     * Coleta todos os pares em ordem (in-order)
-     * O chamador deve liberar a memória retornada
+     * Iterador posicionado no par de menor chave
      */
-    ParChaveValor<K, V>* coletarTodos(int& tamanho) const {
-        tamanho = contarNodosRec(raiz);
-        if (tamanho == 0) {
-            return nullptr;
-        }
-
-        ParChaveValor<K, V>* pares = new ParChaveValor<K, V>[tamanho];
-        int idx = 0;
-        coletarParesRec(raiz, pares, idx);
-        return pares;
-    }
-
-private:
-    int contarNodosRec(NodoMapa<K, V>* nodo) const {
-        if (nodo == nullptr) {
-            return 0;
-        }
-        return 1 + contarNodosRec(nodo->esq) + contarNodosRec(nodo->dir);
+    Iterador iterar() {
+        return Iterador(primeiraFolha);
     }
 };
 
@@ -0,0 +1,73 @@
+#ifndef METRICA_H
+#define METRICA_H
+
+/**
+ * Métrica usada para ordenar os logradouros pela distância à origem
+ *
+ * A métrica é uma política escolhida em tempo de compilação (make
+ * METRICA=geodesica define METRICA_GEODESICA); o código de consulta usa
+ * sempre o tipo Metrica e testa Metrica::GEODESICA, uma constante, de modo
+ * que o ramo da outra métrica é eliminado pelo compilador.
+ *
+ * - MetricaEuclidiana (padrão): distância euclidiana em graus, a mesma de
+ *   calcularDistancia. Mantém as saídas existentes.
+ * - MetricaGeodesica: distância de grande círculo. Cada centro de gravidade
+ *   é convertido uma única vez, na carga da tabela, num vetor unitário 3D.
+ *   A distância usada na ordenação é a corda |u - o| entre os vetores do
+ *   logradouro e da origem (|u - o|² = 2 - 2 u.o), que cresce junto com o
+ *   ângulo central (corda = 2 sen(ângulo / 2)): a ordem é a do grande
+ *   círculo, sem trigonometria por candidato.
+ */
+/**
+ * Conversão de graus para radianos
+ */
+static const double GRAUS_PARA_RADIANOS = 3.14159265358979323846 / 180.0;
+
+struct MetricaEuclidiana {
+    static const bool GEODESICA = false;
+
+    /**
+     * Distância entre dois pontos em graus (calcularDistancia)
+     */
+    static double distancia(double lat1, double lon1, double lat2, double lon2);
+};
+
+struct MetricaGeodesica {
+    static const bool GEODESICA = true;
+
+    /**
+     * Vetor unitário (x, y, z) de um ponto dado em graus
+     * Coordenadas não finitas resultam em componentes NaN.
+     */
+    static void vetorUnitario(double lat, double lon, double* vetor);
+
+    /**
+     * Corda entre os vetores unitários de dois pontos dados em graus
+     */
+    static double distancia(double lat1, double lon1, double lat2, double lon2);
+
+    /**
+     * Corda correspondente a um ângulo central em graus (limitado a [0, 180])
+     */
+    static double cordaDoAngulo(double graus);
+};
+
+#ifdef METRICA_GEODESICA
+typedef MetricaGeodesica Metrica;
+#else
+typedef MetricaEuclidiana Metrica;
+#endif
+
+/**
+ * Origem de uma consulta preparada para a métrica: as coordenadas e, na
+ * métrica geodésica, o vetor unitário, calculado uma vez por consulta
+ */
+struct OrigemMetrica {
+    double lat;
+    double lon;
+    double vetor[3];
+
+    OrigemMetrica(double lat, double lon);
+};
+
+#endif // METRICA_H
\ No newline at end of file
@@ -2,6 +2,11 @@
 #define PALAVRA_H
 
 #include <string>
+#include <cstdint>
+#include "dinamico_array.hpp"
+#include "arena.hpp"
+#include "tabela_logradouros.hpp"
+#include "dicionario_hash.hpp"
 
 /**
  * Nó de uma lista dinâmica de inteiros
@@ -17,14 +22,23 @@ struct NodoListaInt {
 /**
  * Lista dinâmica de inteiros para armazenar IDs de logradouros
  * Mantida em ordem crescente para facilitar interseção eficiente
+ *
+ * Com uma arena, os nós são criados nela e pertencem a ela: o destrutor da
+ * lista não os libera. Sem arena, cada nó é alocado e liberado com new/delete.
  */
 class ListaInteiros {
 private:
     NodoListaInt* inicio;
     int tamanho;
+    ArenaTipada<NodoListaInt>* arena;
+
+    /**
+     * Cria um nó na arena (ou com new, se a lista não tem arena)
+     */
+    NodoListaInt* novoNodo(int valor);
 
 public:
-    ListaInteiros();
+    ListaInteiros(ArenaTipada<NodoListaInt>* arena = nullptr);
     ~ListaInteiros();
 
     /**
@@ -56,24 +70,182 @@ public:
 
 /**
  * Nó da Árvore AVL
- * Armazena uma palavra e a lista de logradouros onde ela ocorre
+ * Armazena uma palavra e seu identificador de termo
  */
 struct NodoAVL {
     std::string palavra;
-    ListaInteiros* logradouros;
+    int idTermo;
     NodoAVL* esq;
     NodoAVL* dir;
     int altura;
 
-    NodoAVL(const std::string& palavra)
-        : palavra(palavra), logradouros(nullptr), esq(nullptr), 
+    NodoAVL(const std::string& palavra, int idTermo)
+        : palavra(palavra), idTermo(idTermo), esq(nullptr),
           dir(nullptr), altura(1) {
-        logradouros = new ListaInteiros();
     }
+};
+
+/**
+ * Par (termo, logradouro) coletado durante a construção em lote
+ */
+struct ParTermoLogradouro {
+    int idTermo;
+    int idLog;
 
-    ~NodoAVL() {
-        delete logradouros;
+    ParTermoLogradouro() : idTermo(0), idLog(0) {}
+    ParTermoLogradouro(int idTermo, int idLog) : idTermo(idTermo), idLog(idLog) {}
+};
+
+/**
+ * Número de postings por bloco comprimido
+ */
+static const int TAMANHO_BLOCO_POSTINGS = 128;
+
+/**
+ * Cabeçalho de salto de um bloco de postings comprimido
+ *
+ * Cada bloco guarda até 128 slots em ordem crescente. O primeiro slot fica no
+ * cabeçalho; os demais são codificados como deltas (slot[i] - slot[i-1] - 1)
+ * empacotados com 'bits' bits cada, a partir de dados[deslocamento].
+ * O campo 'ultimo' permite pular o bloco inteiro sem descomprimi-lo.
+ */
+struct CabecalhoBloco {
+    int primeiro;
+    int ultimo;
+    int deslocamento;
+    int bits;
+};
+
+/**
+ * Listas muito densas (palavras como "DE", "DA", "RUA") são guardadas como
+ * bitmaps comprimidos no estilo Roaring em vez de blocos de deltas.
+ * Uma lista vira bitmap quando tem pelo menos TAMANHO_MINIMO_BITMAP slots e
+ * cobre pelo menos 1/DIVISOR_DENSIDADE_BITMAP de todos os logradouros.
+ */
+static const int TAMANHO_MINIMO_BITMAP = 1024;
+static const int DIVISOR_DENSIDADE_BITMAP = 8;
+
+/**
+ * Um container Roaring cobre 2^16 slots consecutivos (mesmos 16 bits altos)
+ * Containers com mais de LIMIAR_CONTAINER_ARRAY slots são bitmaps de
+ * PALAVRAS_CONTAINER_BITMAP palavras de 64 bits; os demais são arrays
+ * ordenados dos 16 bits baixos.
+ */
+static const int LIMIAR_CONTAINER_ARRAY = 4096;
+static const int PALAVRAS_CONTAINER_BITMAP = 1024;
+
+struct ContainerRoaring {
+    int chave;              // 16 bits altos dos slots do container
+    int cardinalidade;
+    int deslocamento;       // Início em bitmaps (se ehBitmap) ou em valores
+    int ehBitmap;
+};
+
+/**
+ * Visão somente leitura da lista de logradouros de uma palavra no índice
+ * congelado. Contém slots da TabelaLogradouros em ordem crescente, sem
+ * repetição, em um de dois formatos:
+ * - blocos de TAMANHO_BLOCO_POSTINGS comprimidos (numBlocos > 0)
+ * - containers Roaring (numContainers > 0), para listas densas
+ */
+struct ListaPostings {
+    const CabecalhoBloco* blocos;
+    const uint32_t* dados;
+    int numBlocos;
+    int tamanho;
+
+    const ContainerRoaring* containers;
+    const uint64_t* bitmaps;
+    const uint16_t* valores;
+    int numContainers;
+
+    ListaPostings()
+        : blocos(nullptr), dados(nullptr), numBlocos(0), tamanho(0),
+          containers(nullptr), bitmaps(nullptr), valores(nullptr), numContainers(0) {}
+    ListaPostings(const CabecalhoBloco* blocos, const uint32_t* dados, int numBlocos, int tamanho)
+        : blocos(blocos), dados(dados), numBlocos(numBlocos), tamanho(tamanho),
+          containers(nullptr), bitmaps(nullptr), valores(nullptr), numContainers(0) {}
+
+    /**
+     * Retorna true se a lista está no formato Roaring
+     */
+    bool ehRoaring() const {
+        return numContainers > 0;
     }
+
+    /**
+     * Número de slots no bloco b
+     */
+    int tamanhoBloco(int b) const {
+        return b < numBlocos - 1 ? TAMANHO_BLOCO_POSTINGS
+                                 : tamanho - (numBlocos - 1) * TAMANHO_BLOCO_POSTINGS;
+    }
+};
+
+/**
+ * Descomprime o bloco b da lista em 'saida' (capacidade TAMANHO_BLOCO_POSTINGS)
+ * Retorna o número de slots escritos
+ */
+int decodificarBloco(const ListaPostings& lista, int b, int* saida);
+
+/**
+ * Descomprime a lista inteira (em qualquer formato) em 'saida'
+ * (capacidade lista.tamanho)
+ */
+void decodificarLista(const ListaPostings& lista, int* saida);
+
+/**
+ * Escreve em 'saida' os slots de um container Roaring; retorna quantos
+ */
+int decodificarContainer(const ListaPostings& lista, int c, int* saida);
+
+/**
+ * Descomprime só os slots da lista na faixa [inicio, fim), usando os
+ * cabeçalhos de bloco (ou as chaves dos containers) para saltar o resto.
+ * 'saida' precisa de espaço para fim - inicio inteiros. Retorna quantos.
+ */
+int decodificarFaixa(const ListaPostings& lista, int inicio, int fim, int* saida);
+
+/**
+ * Arrays planos do índice congelado
+ * Usados para exportar o índice (snapshot) e para montá-lo sobre memória
+ * externa, como um arquivo mapeado. O número de blocos é
+ * inicioBlocos[numPalavras] e o de containers, inicioContainers[numPalavras].
+ */
+struct DadosPostings {
+    int numPalavras;
+    CabecalhoBloco* blocos;
+    int* inicioBlocos;
+    int* contagens;
+    uint32_t* dados;
+    int numDados;
+    ContainerRoaring* containers;
+    int* inicioContainers;
+    uint64_t* bitmaps;
+    int numPalavrasBitmap;
+    uint16_t* valores;
+    int numValores;
+};
+
+/**
+ * Modo de construção do índice
+ * - INCREMENTAL: cada ocorrência é inserida na ListaInteiros ordenada da palavra
+ * - EM_LOTE: as ocorrências são apenas coletadas como pares (termo, IdLog) e
+ *   ordenadas de uma só vez em congelar(), em tempo linear no número de pares
+ */
+enum ModoConstrucao {
+    CONSTRUCAO_INCREMENTAL,
+    CONSTRUCAO_EM_LOTE
+};
+
+/**
+ * Estrutura usada como dicionário de termos (palavra -> id do termo)
+ * - AVL: árvore AVL de strings (ordem lexicográfica)
+ * - HASH: tabela de dispersão Robin Hood (DicionarioHash)
+ */
+enum BackendDicionario {
+    DICIONARIO_AVL,
+    DICIONARIO_HASH
 };
 
 /**
@@ -81,14 +253,53 @@ struct NodoAVL {
  * 
  * Mapeia cada palavra única para uma lista de logradouros onde ela ocorre.
  * A árvore AVL garante operações de busca, inserção em O(log n) tempo.
+ * Alternativamente, o dicionário de termos pode ser uma tabela de dispersão
+ * (DICIONARIO_HASH), com busca em O(1) esperado.
  * 
  * As listas de logradouros são mantidas em ordem crescente para permitir
  * interseção eficiente durante processamento de consultas.
+ *
+ * Depois de construído, o índice é congelado em formato CSR (offsets + slots
+ * contíguos), que é o formato lido pela Consulta.
  */
 class Palavra {
 private:
     NodoAVL* raiz;
     int numPalavras;
+    ModoConstrucao modo;
+    BackendDicionario backend;
+    DicionarioHash* dicionarioHash;
+
+    // Listas do modo incremental, indexadas pelo id do termo
+    DinamicoArray<ListaInteiros*> listas;
+
+    // Nós da AVL, listas e nós das listas vêm de arenas do índice, liberadas
+    // em bloco na destruição (sem percorrer a árvore nem as listas)
+    ArenaTipada<NodoAVL> arenaNodos;
+    ArenaTipada<ListaInteiros> arenaListas;
+    ArenaTipada<NodoListaInt> arenaPostings;
+
+    // Pares coletados no modo em lote (liberados ao congelar)
+    DinamicoArray<ParTermoLogradouro>* pares;
+
+    // Índice congelado: os blocos do termo t são
+    // blocos[inicioBlocos[t] .. inicioBlocos[t + 1]) e o termo tem contagens[t] slots
+    CabecalhoBloco* blocos;
+    int* inicioBlocos;
+    int* contagens;
+    uint32_t* dados;
+    int numDados;
+
+    // Termos densos: containers[inicioContainers[t] .. inicioContainers[t + 1])
+    ContainerRoaring* containers;
+    int* inicioContainers;
+    uint64_t* bitmaps;
+    int numPalavrasBitmap;
+    uint16_t* valores;
+    int numValores;
+
+    bool congelado;
+    bool donoDosPostings;       // false quando montado sobre memória externa
 
     /**
      * Retorna a altura de um nodo (0 se nullptr)
@@ -131,15 +342,35 @@ private:
     NodoAVL* buscarRec(NodoAVL* nodo, const std::string& palavra) const;
 
     /**
-     * Desaloca recursivamente toda a árvore
+     * Preenche textos[id] com a palavra de cada nodo da subárvore
+     */
+    void coletarTermosRec(NodoAVL* nodo, std::string* textos) const;
+
+    /**
+     * Retorna o id do termo, inserindo a palavra no dicionário se necessário
+     */
+    int obterIdTermo(const std::string& palavra);
+    int obterIdTermo(const char* palavra, int tamanho);
+
+    /**
+     * Comprime as listas CSR (offsets + slots) em blocos delta + bit-packing,
+     * ou em containers Roaring quando a lista é densa
      */
-    void desalocarRec(NodoAVL* nodo);
+    void comprimirPostings(const int* offsets, const int* slots, int numSlots);
 
 public:
     /**
      * Construtor
      */
-    Palavra();
+    Palavra(ModoConstrucao modo = CONSTRUCAO_INCREMENTAL,
+            BackendDicionario backend = DICIONARIO_AVL);
+
+    /**
+     * Monta um índice já congelado sobre arrays externos, sem copiá-los
+     * O dicionário (que deve atribuir os mesmos ids de termo) passa a ser do
+     * índice; os arrays precisam sobreviver ao índice e não são liberados.
+     */
+    Palavra(const DadosPostings& dadosExternos, DicionarioHash* dicionario);
 
     /**
      * Destrutor
@@ -154,10 +385,15 @@ public:
 
     /**
      * Busca uma palavra na árvore
-     * Retorna nullptr se não encontrada
+     * Retorna nullptr se não encontrada (ou se o índice foi construído em lote)
      */
     ListaInteiros* buscar(const std::string& palavra) const;
 
+    /**
+     * Retorna o id do termo de uma palavra ou -1 se não existir
+     */
+    int buscarIdTermo(const std::string& palavra) const;
+
     /**
      * Retorna o número total de palavras únicas
      */
@@ -165,8 +401,60 @@ public:
 
     /**
      * Adiciona um logradouro a uma palavra existente ou cria uma nova entrada
+     * No modo em lote apenas registra o par (termo, IdLog)
      */
     void adicionarLogradouro(const std::string& palavra, int idLog);
+
+    /**
+     * Mesmo que o anterior, com a palavra dada por ponteiro e tamanho
+     * (não copia a palavra no modo em lote com o dicionário hash)
+     */
+    void adicionarLogradouro(const char* palavra, int tamanho, int idLog);
+
+    /**
+     * Congela o índice em formato CSR
+     * Converte cada IdLog para o slot correspondente na tabela (pares cujo
+     * IdLog não está na tabela são descartados), ordena os pares com radix
+     * sort e remove duplicatas. Após congelar, não é mais possível inserir.
+     */
+    void congelar(const TabelaLogradouros* tabela);
+
+    /**
+     * Retorna true se o índice já foi congelado
+     */
+    bool estaCongelado() const;
+
+    /**
+     * Retorna os slots de logradouros de uma palavra no índice congelado
+     * Lista vazia se a palavra não existe ou o índice não foi congelado
+     */
+    ListaPostings buscarPostings(const std::string& palavra) const;
+
+    /**
+     * Lista de postings do termo com o id informado (vazia se o id for
+     * inválido ou o índice não estiver congelado)
+     */
+    ListaPostings getPostings(int idTermo) const;
+
+    /**
+     * Memória ocupada pelas listas de postings congeladas, em bytes
+     */
+    long long getMemoriaPostings() const;
+
+    /**
+     * Preenche 'saida' com os arrays do índice congelado (que continuam dele)
+     */
+    void exportarPostings(DadosPostings& saida) const;
+
+    /**
+     * Retorna um array com o texto de cada termo, indexado pelo id
+     * (getNumPalavras() posições; o chamador libera com delete[])
+     */
+    std::string* coletarTermos() const;
+
+private:
+    Palavra(const Palavra&);
+    Palavra& operator=(const Palavra&);
 };
 
 #endif // PALAVRA_H
\ No newline at end of file
@@ -0,0 +1,120 @@
+#ifndef POOL_TRABALHO_H
+#define POOL_TRABALHO_H
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/**
+ * Função executada para cada tarefa
+ * Recebe o índice da tarefa, o índice do trabalhador que a executa
+ * (0 .. numTrabalhadores - 1, útil para áreas de trabalho por thread)
+ * e o contexto informado em iniciar()
+ */
+typedef void (*FuncaoTarefa)(int tarefa, int trabalhador, void* contexto);
+
+/**
+ * Fila de lotes de um trabalhador
+ * O dono retira pelo início (lotes de menor índice primeiro) e os ladrões
+ * roubam pelo fim (o trabalho mais distante da saída)
+ */
+struct FilaLotes {
+    std::mutex trava;
+    int* lotes;
+    int inicio;
+    int fim;
+
+    FilaLotes() : lotes(nullptr), inicio(0), fim(0) {}
+};
+
+/**
+ * TAD PoolTrabalho
+ *
+ * Conjunto fixo de threads com roubo de trabalho (work stealing).
+ * As tarefas [0, numTarefas) são agrupadas em lotes consecutivos e os lotes
+ * são distribuídos em rodízio entre as filas dos trabalhadores. Cada
+ * trabalhador consome a própria fila em ordem crescente e, quando ela se
+ * esvazia, rouba lotes do fim da fila dos outros.
+ *
+ * Como os lotes tendem a terminar na ordem de entrada, quem consome os
+ * resultados pode aguardar lote a lote (aguardarLote) e emiti-los em ordem,
+ * como um buffer de reordenação.
+ */
+class PoolTrabalho {
+private:
+    int numTrabalhadores;
+    std::thread* threads;
+    FilaLotes* filas;
+
+    // Trabalho corrente
+    FuncaoTarefa funcao;
+    void* contexto;
+    int numTarefas;
+    int tamanhoLote;
+    int numLotes;
+
+    // Sinalização trabalhadores <-> coordenador
+    std::mutex trava;
+    std::condition_variable condTrabalho;
+    std::condition_variable condConclusao;
+    int geracao;                // Incrementada a cada iniciar()
+    bool encerrar;
+    bool* loteConcluido;
+    int lotesConcluidos;
+
+    /**
+     * Laço principal de cada thread
+     */
+    void executarTrabalhador(int trabalhador);
+
+    /**
+     * Retira o próximo lote da própria fila ou rouba de outra; -1 se não houver
+     */
+    int obterLote(int trabalhador);
+
+    /**
+     * Executa as tarefas de um lote e o marca como concluído
+     */
+    void executarLote(int lote, int trabalhador);
+
+public:
+    /**
+     * Construtor: cria as threads, que ficam aguardando trabalho
+     */
+    PoolTrabalho(int numTrabalhadores);
+
+    /**
+     * Destrutor: encerra e junta as threads
+     */
+    ~PoolTrabalho();
+
+    /**
+     * Distribui as tarefas em lotes de 'tamanhoLote' e retorna imediatamente
+     * O trabalho anterior precisa ter sido aguardado por completo.
+     */
+    void iniciar(int numTarefas, int tamanhoLote, FuncaoTarefa funcao, void* contexto);
+
+    /**
+     * Bloqueia até o lote informado estar concluído
+     */
+    void aguardarLote(int lote);
+
+    /**
+     * Bloqueia até todos os lotes estarem concluídos
+     */
+    void aguardarTodos();
+
+    /**
+     * Lote de uma tarefa / número de lotes do trabalho corrente
+     */
+    int getLote(int tarefa) const;
+    int getNumLotes() const;
+
+    int getNumTrabalhadores() const;
+
+private:
+    PoolTrabalho(const PoolTrabalho&);
+    PoolTrabalho& operator=(const PoolTrabalho&);
+};
+
+#endif // POOL_TRABALHO_H
\ No newline at end of file
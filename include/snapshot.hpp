@@ -0,0 +1,137 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include "palavra.hpp"
+#include "dicionario_hash.hpp"
+#include "tabela_logradouros.hpp"
+#include <string>
+#include <cstdint>
+
+/**
+ * Formato do snapshot binário do índice
+ *
+ * Um cabeçalho de tamanho fixo seguido de seções, cada uma um array plano
+ * (postings, dicionário de termos, tabela de logradouros). As seções são
+ * referenciadas por deslocamento a partir do início do arquivo e alinhadas
+ * a ALINHAMENTO_SECAO_SNAPSHOT bytes, de modo que o arquivo pode ser mapeado
+ * em qualquer endereço e usado diretamente, sem cópia nem conversão.
+ *
+ * O checksum cobre tudo o que vem depois do cabeçalho. Os arrays são
+ * gravados na ordem de bytes da máquina; um marcador no cabeçalho rejeita
+ * arquivos gerados numa máquina de ordem diferente.
+ */
+static const uint32_t VERSAO_SNAPSHOT = 2;
+static const uint32_t MARCADOR_ORDEM_SNAPSHOT = 0x01020304u;
+static const int ALINHAMENTO_SECAO_SNAPSHOT = 64;
+
+enum SecaoSnapshot {
+    // Índice congelado
+    SECAO_BLOCOS,
+    SECAO_INICIO_BLOCOS,
+    SECAO_CONTAGENS,
+    SECAO_DADOS,
+    SECAO_CONTAINERS,
+    SECAO_INICIO_CONTAINERS,
+    SECAO_BITMAPS,
+    SECAO_VALORES,
+    // Dicionário de termos (tabela de dispersão)
+    SECAO_SLOTS_DICIONARIO,
+    SECAO_TEXTOS_TERMOS,
+    SECAO_INICIO_TERMOS,
+    // Tabela de logradouros
+    SECAO_IDS,
+    SECAO_LATITUDES,
+    SECAO_LONGITUDES,
+    SECAO_LINHAS_SAIDA,         // "IdLog;nome\n" de cada slot
+    SECAO_INICIO_LINHAS,
+    SECAO_SLOT_POR_ID,
+    SECAO_IDS_ORDENADOS,
+    SECAO_SLOTS_ORDENADOS,
+    SECAO_INICIO_CELULA,
+    NUM_SECOES_SNAPSHOT
+};
+
+/**
+ * Posição de uma seção no arquivo
+ */
+struct DescritorSecao {
+    uint64_t deslocamento;
+    uint64_t tamanho;           // Em bytes
+};
+
+/**
+ * Cabeçalho do arquivo (início do arquivo)
+ */
+struct CabecalhoSnapshot {
+    char assinatura[8];         // "TP3SNAP"
+    uint32_t versao;
+    uint32_t marcadorOrdem;
+    uint64_t tamanhoArquivo;
+    uint64_t checksum;
+
+    // Escalares do índice
+    int32_t numPalavras;
+    int32_t numDados;
+    int32_t numPalavrasBitmap;
+    int32_t numValores;
+    int32_t capacidadeDicionario;
+    int32_t tamanhoTextosTermos;
+
+    // Escalares da tabela de logradouros
+    int32_t numLogradouros;
+    int32_t tamanhoLinhas;
+    int32_t idMinimo;
+    int32_t faixaIds;
+    int32_t linhasGrade;
+    int32_t colunasGrade;
+    double latMinima;
+    double lonMinima;
+    double ladoCelula;
+    double folgaLimite;
+
+    DescritorSecao secoes[NUM_SECOES_SNAPSHOT];
+};
+
+/**
+ * Grava o snapshot do índice congelado e da tabela de logradouros
+ * Retorna false (com a mensagem em 'erro') se não for possível gravar.
+ */
+bool gravarSnapshot(const char* caminho, const Palavra* indice,
+                    const TabelaLogradouros* tabela, std::string& erro);
+
+/**
+ * TAD Snapshot
+ *
+ * Snapshot aberto com mmap. O índice e a tabela de logradouros são montados
+ * diretamente sobre as páginas do arquivo (somente leitura), que o sistema
+ * operacional compartilha entre os processos que abrem o mesmo arquivo.
+ */
+class Snapshot {
+private:
+    void* base;
+    uint64_t tamanho;
+    Palavra* indice;
+    TabelaLogradouros* tabela;
+
+public:
+    Snapshot();
+    ~Snapshot();
+
+    /**
+     * Mapeia e valida o arquivo (assinatura, versão, ordem de bytes,
+     * limites das seções e checksum). Retorna false com a mensagem em 'erro'.
+     */
+    bool abrir(const char* caminho, std::string& erro);
+
+    /**
+     * Índice e tabela montados sobre o arquivo (nullptr se não aberto)
+     */
+    const Palavra* getIndice() const;
+    const TabelaLogradouros* getTabela() const;
+
+private:
+    Snapshot(const Snapshot&);
+    Snapshot& operator=(const Snapshot&);
+};
+
+#endif // SNAPSHOT_H
\ No newline at end of file
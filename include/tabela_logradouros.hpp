@@ -0,0 +1,225 @@
+#ifndef TABELA_LOGRADOUROS_H
+#define TABELA_LOGRADOUROS_H
+
+#include "logradouro.hpp"
+
+/**
+ * Número médio de logradouros por célula da grade espacial
+ */
+static const int LOGRADOUROS_POR_CELULA = 8;
+
+/**
+ * Arrays planos que compõem uma TabelaLogradouros
+ * Usados para exportar a tabela (snapshot) e para montá-la sobre memória
+ * externa, como um arquivo mapeado. idsOrdenados/slotsOrdenados só existem
+ * quando slotPorId é nulo; inicioCelula tem linhasGrade * colunasGrade + 2 posições.
+ */
+struct DadosTabelaLogradouros {
+    int numLogradouros;
+    int* ids;
+    double* latitudes;
+    double* longitudes;
+    char* linhasSaida;
+    int tamanhoLinhas;
+    int* inicioLinha;           // Linha do slot s: linhasSaida[inicioLinha[s] .. inicioLinha[s + 1])
+
+    int* slotPorId;
+    int idMinimo;
+    int faixaIds;
+    int* idsOrdenados;
+    int* slotsOrdenados;
+
+    double latMinima;
+    double lonMinima;
+    double ladoCelula;
+    double folgaLimite;
+    int linhasGrade;
+    int colunasGrade;
+    int* inicioCelula;
+};
+
+/**
+ * Alinhamento dos arrays de coordenadas (uma linha de cache)
+ */
+static const int ALINHAMENTO_COORDENADAS = 64;
+
+/**
+ * TAD TabelaLogradouros
+ *
+ * Tabela densa de logradouros construída uma única vez, ao final da fase de
+ * construção. Cada logradouro ocupa uma posição (slot).
+ *
+ * Os slots são particionados por uma grade espacial regular sobre os centros
+ * de gravidade: os logradouros de uma mesma célula ocupam slots contíguos
+ * (em ordem crescente de IdLog dentro da célula), com as células em ordem
+ * linha a linha. Como as listas de postings guardam slots em ordem crescente,
+ * toda lista já fica particionada por célula, e uma consulta pode visitar as
+ * células em anéis a partir da origem e parar cedo. Logradouros com
+ * coordenadas não finitas ficam numa faixa extra, depois da última célula.
+ *
+ * O mapeamento IdLog -> slot é feito por endereçamento direto quando a faixa
+ * de IdLogs é compacta, o que torna a resolução de um candidato O(1) durante
+ * as consultas. Se a faixa for esparsa demais, recorre à busca binária sobre
+ * os IdLogs ordenados.
+ *
+ * Centros de gravidade e nomes ficam em arrays próprios, indexados por slot,
+ * de modo que as consultas não precisam dos objetos Logradouro. O nome de
+ * cada slot é guardado já como a linha de resultado "IdLog;nome\n", que a
+ * saída copia sem formatar. Uma tabela
+ * montada sobre DadosTabelaLogradouros externos (snapshot) é somente leitura
+ * e não tem objetos Logradouro.
+ */
+class TabelaLogradouros {
+private:
+    Logradouro** logradouros;   // Logradouro de cada slot (não é dono dos objetos)
+    int* ids;                   // IdLog numérico de cada slot
+    int numLogradouros;
+
+    double* latitudes;          // Centro de gravidade de cada slot (alinhados a
+    double* longitudes;         // ALINHAMENTO_COORDENADAS bytes, lidos em lote)
+    char* linhasSaida;          // Linhas "IdLog;nome\n" concatenadas
+    int tamanhoLinhas;
+    int* inicioLinha;
+
+    double* vetores;            // Vetor unitário de cada slot, COMPONENTES_VETOR
+                                // doubles por slot (só na métrica geodésica;
+                                // calculado na carga e sempre liberado pela tabela)
+    bool podaGeodesica;         // Coordenadas geográficas: limites de grande círculo valem
+
+    bool donaDosArrays;         // false quando montada sobre memória externa
+
+    int* slotPorId;             // slotPorId[idLog - idMinimo] = slot ou -1
+    int idMinimo;
+    int faixaIds;               // Tamanho de slotPorId (0 se não houver tabela direta)
+
+    int* idsOrdenados;          // IdLogs em ordem crescente (só sem tabela direta)
+    int* slotsOrdenados;        // Slot de cada idsOrdenados[i]
+
+    // Grade espacial: célula (linha, coluna) = linha * colunasGrade + coluna
+    double latMinima;
+    double lonMinima;
+    double ladoCelula;
+    double folgaLimite;         // Margem para erros de arredondamento nos limites
+    int linhasGrade;
+    int colunasGrade;
+    int* inicioCelula;          // Slots da célula c: [inicioCelula[c], inicioCelula[c + 1])
+
+    /**
+     * Busca binária do slot de um IdLog (usada quando a faixa é esparsa)
+     */
+    int buscarSlotBinaria(int idLog) const;
+
+    /**
+     * Monta a grade espacial e reordena os slots por célula
+     */
+    void particionarPorGrade();
+
+    /**
+     * Copia centros de gravidade e linhas de resultado para os arrays por slot
+     */
+    void montarArraysPorSlot();
+
+    /**
+     * Calcula os vetores unitários dos slots (métrica geodésica)
+     */
+    void montarVetoresUnitarios();
+
+public:
+    /**
+     * Construtor
+     * Converte o IdLog de cada logradouro uma única vez e monta a tabela.
+     * Logradouros cujo IdLog não é numérico ficam de fora da tabela.
+     * Se dois logradouros resultarem no mesmo IdLog, prevalece o primeiro do array.
+     */
+    TabelaLogradouros(Logradouro** logradourosArray, int tamanhoArray);
+
+    /**
+     * Monta a tabela sobre arrays externos, sem copiá-los
+     * Os arrays precisam sobreviver à tabela e não são liberados por ela.
+     */
+    TabelaLogradouros(const DadosTabelaLogradouros& dadosExternos);
+
+    /**
+     * Destrutor (não libera os objetos Logradouro)
+     */
+    ~TabelaLogradouros();
+
+    /**
+     * Retorna o slot do logradouro com o IdLog informado ou -1
+     */
+    int buscarSlot(int idLog) const;
+
+    /**
+     * Retorna o logradouro com o IdLog informado ou nullptr
+     * (sempre nullptr numa tabela montada sobre memória externa)
+     */
+    Logradouro* buscar(int idLog) const;
+
+    /**
+     * Acesso por slot
+     */
+    Logradouro* getLogradouro(int slot) const;
+    int getIdLog(int slot) const;
+    double getLatitude(int slot) const;
+    double getLongitude(int slot) const;
+
+    /**
+     * Arrays de coordenadas indexados por slot, para os kernels de distância
+     */
+    const double* getLatitudes() const;
+    const double* getLongitudes() const;
+
+    /**
+     * Vetores unitários intercalados por slot (nulo fora da métrica geodésica)
+     */
+    const double* getVetores() const;
+    std::string getNome(int slot) const;
+
+    /**
+     * Linha de resultado do slot ("IdLog;nome\n"), sem cópia
+     */
+    const char* getLinhaSaida(int slot, int& tamanho) const;
+
+    /**
+     * Preenche 'saida' com os arrays internos (que continuam da tabela)
+     */
+    void exportar(DadosTabelaLogradouros& saida) const;
+
+    /**
+     * Retorna o número de logradouros na tabela
+     */
+    int getTamanho() const;
+
+    /**
+     * Dimensões da grade espacial
+     */
+    int getLinhasGrade() const;
+    int getColunasGrade() const;
+    int getNumCelulas() const;
+
+    /**
+     * Primeiro slot da célula; getInicioCelula(getNumCelulas()) é o início da
+     * faixa de logradouros sem coordenadas finitas, que vai até getTamanho()
+     */
+    int getInicioCelula(int celula) const;
+
+    /**
+     * Célula mais próxima de um ponto (pontos fora da grade são trazidos
+     * para a borda)
+     */
+    void localizarCelula(double lat, double lon, int& linha, int& coluna) const;
+
+    /**
+     * Limite inferior da distância (na Metrica em uso) entre (lat, lon) e
+     * qualquer logradouro fora do quadro de células [linha - raio, linha + raio]
+     * x [coluna - raio, coluna + raio]. Retorna -1 se o quadro cobre a grade toda.
+     */
+    double distanciaMinimaForaDoQuadro(double lat, double lon,
+                                       int linha, int coluna, int raio) const;
+
+private:
+    TabelaLogradouros(const TabelaLogradouros&);
+    TabelaLogradouros& operator=(const TabelaLogradouros&);
+};
+
+#endif // TABELA_LOGRADOUROS_H
\ No newline at end of file
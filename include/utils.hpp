@@ -39,8 +39,46 @@ std::string* dividirString(const std::string& str, char delim, int& tamanho);
  */
 std::string trim(const std::string& str);
 
+/**
+ * Converte um inteiro decimal (sinal opcional seguido de dígitos, sem sobras)
+ * Não lança exceções: retorna false se o texto não é um inteiro ou se o
+ * valor não cabe em int.
+ *
+ * @param str Início do texto
+ * @param tamanho Número de caracteres
+ * @param valor Referência que recebe o inteiro convertido
+ * @return true se a conversão foi válida
+ */
+bool converterInteiro(const char* str, int tamanho, int& valor);
+
+/**
+ * Converte um número real decimal: sinal, dígitos, parte fracionária e
+ * expoente opcionais (ex.: "-19.814060", "5", ".5", "1e-3"), sem sobras
+ * O resultado é o double mais próximo (arredondamento correto). Não lança
+ * exceções: retorna false se o texto não é um número.
+ *
+ * @param str Início do texto
+ * @param tamanho Número de caracteres
+ * @param valor Referência que recebe o double convertido
+ * @return true se a conversão foi válida
+ */
+bool converterDouble(const char* str, int tamanho, double& valor);
+
+/**
+ * Escreve o inteiro em decimal a partir de 'destino' (sem '\0')
+ * 'destino' precisa de espaço para TAMANHO_MAXIMO_INTEIRO caracteres.
+ *
+ * @param valor Inteiro a formatar
+ * @param destino Início da área de escrita
+ * @return Número de caracteres escritos
+ */
+static const int TAMANHO_MAXIMO_INTEIRO = 11;
+int formatarInteiro(int valor, char* destino);
+
 /**
  * Converte uma string para inteiro
+ * Não valida o texto (para no primeiro caractere que não é dígito); para
+ * validar, use converterInteiro
  * 
  * @param str String a converter
  * @return Inteiro representado pela string
@@ -49,6 +87,8 @@ int stringParaInt(const std::string& str);
 
 /**
  * Converte uma string para double
+ * Não valida o texto nem arredonda corretamente; para isso, use
+ * converterDouble
  * 
  * @param str String a converter
  * @return Double representado pela string
@@ -0,0 +1,336 @@
+#include "cache_consultas.hpp"
+#include "dicionario_hash.hpp"
+#include "utils.hpp"
+#include "metrica.hpp"
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+// ============================================================================
+// CacheConsultas - Implementação
+// ============================================================================
+
+CacheConsultas::CacheConsultas(int maxEntradas, long long maxBytes, double passo)
+    : maxEntradas(maxEntradas > 0 ? maxEntradas : 1), maxBytes(maxBytes), passo(passo > 0.0 ? passo : 0.0),
+      entradas(nullptr), livre(0), baldes(nullptr), numBaldes(16),
+      maisRecente(-1), menosRecente(-1), numEntradas(0), bytesUsados(0) {
+    entradas = new EntradaCache[this->maxEntradas];
+    for (int i = 0; i < this->maxEntradas; i++) {
+        entradas[i].slots = nullptr;
+        entradas[i].numSlots = 0;
+        entradas[i].proximo = i + 1 < this->maxEntradas ? i + 1 : -1;
+    }
+
+    while (numBaldes < 2 * this->maxEntradas) {
+        numBaldes *= 2;
+    }
+    baldes = new int[numBaldes];
+    for (int b = 0; b < numBaldes; b++) {
+        baldes[b] = -1;
+    }
+}
+
+CacheConsultas::~CacheConsultas() {
+    for (int i = 0; i < maxEntradas; i++) {
+        delete[] entradas[i].slots;
+    }
+    delete[] entradas;
+    delete[] baldes;
+}
+
+bool CacheConsultas::montarChave(const std::string& texto, double lat, double lon,
+                                 std::string& chave) const {
+    if (!std::isfinite(lat) || !std::isfinite(lon)) {
+        return false;
+    }
+
+    // Palavras como Consulta::executar as separa, em ordem e sem repetição:
+    // a ordem e a repetição não mudam a interseção. Espaços repetidos deixam
+    // palavras vazias, que executar também busca: essas consultas ficam fora
+    // do cache
+    int numPalavras = 0;
+    std::string* palavras = dividirString(texto, ' ', numPalavras);
+    if (palavras == nullptr) {
+        return false;
+    }
+    for (int i = 0; i < numPalavras; i++) {
+        if (palavras[i].empty()) {
+            delete[] palavras;
+            return false;
+        }
+    }
+    for (int i = 1; i < numPalavras; i++) {
+        std::string atual = palavras[i];
+        int j = i - 1;
+        while (j >= 0 && palavras[j] > atual) {
+            palavras[j + 1] = palavras[j];
+            j--;
+        }
+        palavras[j + 1] = atual;
+    }
+
+    chave.clear();
+    for (int i = 0; i < numPalavras; i++) {
+        if (i > 0 && palavras[i] == palavras[i - 1]) {
+            continue;
+        }
+        if (!chave.empty()) {
+            chave += ' ';
+        }
+        chave += palavras[i];
+    }
+    delete[] palavras;
+
+    // Origem: célula da grade ou os bits exatos das coordenadas
+    chave += '\0';
+    if (passo > 0.0) {
+        double linha = std::floor(lat / passo);
+        double coluna = std::floor(lon / passo);
+        if (std::fabs(linha) > 1e15 || std::fabs(coluna) > 1e15) {
+            return false;
+        }
+        int64_t celula[2] = {static_cast<int64_t>(linha), static_cast<int64_t>(coluna)};
+        chave.append(reinterpret_cast<const char*>(celula), sizeof(celula));
+    } else {
+        double origem[2] = {lat, lon};
+        chave.append(reinterpret_cast<const char*>(origem), sizeof(origem));
+    }
+    return true;
+}
+
+int CacheConsultas::localizar(const std::string& chave, uint32_t hash) const {
+    for (int i = baldes[hash & (numBaldes - 1)]; i >= 0; i = entradas[i].proximoBalde) {
+        if (entradas[i].hash == hash && entradas[i].chave == chave) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void CacheConsultas::desligarLRU(int indice) {
+    EntradaCache& entrada = entradas[indice];
+    if (entrada.anterior >= 0) {
+        entradas[entrada.anterior].proximo = entrada.proximo;
+    } else {
+        maisRecente = entrada.proximo;
+    }
+    if (entrada.proximo >= 0) {
+        entradas[entrada.proximo].anterior = entrada.anterior;
+    } else {
+        menosRecente = entrada.anterior;
+    }
+}
+
+void CacheConsultas::ligarComoMaisRecente(int indice) {
+    EntradaCache& entrada = entradas[indice];
+    entrada.anterior = -1;
+    entrada.proximo = maisRecente;
+    if (maisRecente >= 0) {
+        entradas[maisRecente].anterior = indice;
+    } else {
+        menosRecente = indice;
+    }
+    maisRecente = indice;
+}
+
+void CacheConsultas::remover(int indice) {
+    EntradaCache& entrada = entradas[indice];
+
+    int* elo = &baldes[entrada.hash & (numBaldes - 1)];
+    while (*elo != indice) {
+        elo = &entradas[*elo].proximoBalde;
+    }
+    *elo = entrada.proximoBalde;
+
+    desligarLRU(indice);
+    bytesUsados -= entrada.bytes;
+    numEntradas--;
+
+    delete[] entrada.slots;
+    entrada.slots = nullptr;
+    entrada.numSlots = 0;
+    std::string().swap(entrada.chave);
+    entrada.proximo = livre;
+    livre = indice;
+}
+
+void CacheConsultas::guardar(const std::string& chave, uint32_t hash, double lat, double lon,
+                             const Candidato* candidatos, int numCandidatos, int maxCandidatos) {
+    int existente = localizar(chave, hash);
+    if (existente >= 0) {
+        remover(existente);
+    }
+
+    long long bytes = static_cast<long long>(sizeof(EntradaCache) + chave.size()) +
+                      static_cast<long long>(numCandidatos) * static_cast<long long>(sizeof(int));
+    if (bytes > maxBytes) {
+        return;
+    }
+    while (numEntradas > 0 && (numEntradas == maxEntradas || bytesUsados + bytes > maxBytes)) {
+        remover(menosRecente);
+        estatisticas.remocoes++;
+    }
+
+    int indice = livre;
+    EntradaCache& entrada = entradas[indice];
+    livre = entrada.proximo;
+
+    entrada.chave = chave;
+    entrada.hash = hash;
+    entrada.latAncora = lat;
+    entrada.lonAncora = lon;
+    entrada.numSlots = numCandidatos;
+    entrada.slots = new int[numCandidatos > 0 ? numCandidatos : 1];
+    for (int i = 0; i < numCandidatos; i++) {
+        entrada.slots[i] = candidatos[i].slot;
+    }
+    // Com menos candidatos que o pedido, a entrada tem todos
+    entrada.limite = numCandidatos == maxCandidatos ? candidatos[numCandidatos - 1].distancia
+                                                    : std::numeric_limits<double>::infinity();
+    entrada.bytes = bytes;
+
+    int balde = static_cast<int>(hash & (numBaldes - 1));
+    entrada.proximoBalde = baldes[balde];
+    baldes[balde] = indice;
+    ligarComoMaisRecente(indice);
+    numEntradas++;
+    bytesUsados += bytes;
+}
+
+/**
+ * Número de primeiros candidatos sem empate que garante os R melhores:
+ * R + 1, para que o R-ésimo não empate com o seguinte
+ */
+static int comVizinho(int maxRespostas) {
+    return maxRespostas < (1 << 30) ? maxRespostas + 1 : maxRespostas;
+}
+
+/**
+ * Responde a consulta a partir dos candidatos de uma entrada
+ * Retorna false se a entrada não garante o resultado exato para a origem.
+ * Com empate de distâncias a ordem depende de todos os candidatos da
+ * consulta (ver selecionarComoOriginal), não só dos da entrada: recusa.
+ */
+static bool responderPelaEntrada(const TabelaLogradouros* tabela, const int* slots, int numSlots,
+                                 double latAncora, double lonAncora, double limite,
+                                 double latOrigem, double lonOrigem, int maxRespostas,
+                                 AreaTrabalhoConsulta& area,
+                                 const Candidato*& resultado, int& tamanhoResultado) {
+    resultado = selecionarMaisProximos(tabela, slots, numSlots, latOrigem, lonOrigem,
+                                       comVizinho(maxRespostas), area, tamanhoResultado);
+    bool exato = !haEmpateDistancias(resultado, tamanhoResultado);
+    if (tamanhoResultado > maxRespostas) {
+        tamanhoResultado = maxRespostas;
+    }
+
+    // Mesma origem ou entrada com todos os candidatos: sempre exato. Senão,
+    // quem está fora da entrada fica a pelo menos limite - d(origem, âncora)
+    bool mesmaOrigem = latOrigem == latAncora && lonOrigem == lonAncora;
+    if (exato && !mesmaOrigem && !std::isinf(limite)) {
+        double deslocamento = Metrica::distancia(latOrigem, lonOrigem, latAncora, lonAncora);
+        exato = tamanhoResultado == maxRespostas &&
+                resultado[tamanhoResultado - 1].distancia + deslocamento + MARGEM_CERTIFICADO_CACHE < limite;
+    }
+    if (!exato) {
+        resultado = nullptr;
+        tamanhoResultado = 0;
+    }
+    return exato;
+}
+
+const Candidato* CacheConsultas::executar(Consulta& consulta, const Palavra* indice,
+                                          const TabelaLogradouros* tabela, int& tamanhoResultado,
+                                          AreaTrabalhoConsulta& area) {
+    tamanhoResultado = 0;
+    double lat = consulta.getLatOrigem();
+    double lon = consulta.getLonOrigem();
+    int maxRespostas = consulta.getMaxRespostas();
+
+    std::string chave;
+    if (indice == nullptr || tabela == nullptr || maxRespostas <= 0 ||
+        !montarChave(consulta.getConsultaTexto(), lat, lon, chave)) {
+        return consulta.executar(indice, tabela, lat, lon, tamanhoResultado, area);
+    }
+    uint32_t hash = DicionarioHash::calcularHash(chave.data(), static_cast<int>(chave.size()));
+
+    // Copia a entrada sob a trava, para o buffer da área (só cresce); as
+    // distâncias são calculadas fora dela
+    bool presente = false;
+    const int* slots = nullptr;
+    int numSlots = 0;
+    double latAncora = 0.0, lonAncora = 0.0, limite = 0.0;
+    {
+        std::lock_guard<std::mutex> guarda(trava);
+        int i = localizar(chave, hash);
+        if (i >= 0) {
+            EntradaCache& entrada = entradas[i];
+            presente = true;
+            numSlots = entrada.numSlots;
+            area.slotsCache.garantir(numSlots);
+            std::memcpy(area.slotsCache.getDados(), entrada.slots, numSlots * sizeof(int));
+            slots = area.slotsCache.getDados();
+            latAncora = entrada.latAncora;
+            lonAncora = entrada.lonAncora;
+            limite = entrada.limite;
+            desligarLRU(i);
+            ligarComoMaisRecente(i);
+        }
+    }
+
+    if (presente) {
+        const Candidato* resultado = nullptr;
+        bool exato = responderPelaEntrada(tabela, slots, numSlots, latAncora, lonAncora, limite,
+                                          lat, lon, maxRespostas, area, resultado, tamanhoResultado);
+        if (exato) {
+            std::lock_guard<std::mutex> guarda(trava);
+            estatisticas.acertos++;
+            return resultado;
+        }
+    }
+
+    // Executa com folga; os R primeiros são o resultado e o resto fica para
+    // as próximas origens da mesma célula
+    long long comFolga = static_cast<long long>(maxRespostas) * FATOR_FOLGA_CACHE;
+    int maxCandidatos = comFolga < (1 << 30) ? static_cast<int>(comFolga) : (1 << 30);
+    Consulta consultaComFolga(consulta.getIdConsulta(), consulta.getConsultaTexto(),
+                              lat, lon, maxCandidatos);
+    int numCandidatos = 0;
+    const Candidato* candidatos = consultaComFolga.executar(indice, tabela, lat, lon,
+                                                            numCandidatos, area);
+
+    {
+        std::lock_guard<std::mutex> guarda(trava);
+        if (presente) {
+            estatisticas.recusas++;
+        } else {
+            estatisticas.faltas++;
+        }
+        guardar(chave, hash, lat, lon, candidatos, numCandidatos, maxCandidatos);
+    }
+
+    // Com empate entre os R + 1 primeiros, a ordem dos empatados com folga
+    // pode diferir da ordem com R: executa sem folga
+    int primeiros = numCandidatos < comVizinho(maxRespostas) ? numCandidatos : comVizinho(maxRespostas);
+    if (haEmpateDistancias(candidatos, primeiros)) {
+        return consulta.executar(indice, tabela, lat, lon, tamanhoResultado, area);
+    }
+
+    // Os R primeiros candidatos são o resultado
+    tamanhoResultado = numCandidatos < maxRespostas ? numCandidatos : maxRespostas;
+    return tamanhoResultado > 0 ? candidatos : nullptr;
+}
+
+EstatisticasCache CacheConsultas::getEstatisticas() {
+    std::lock_guard<std::mutex> guarda(trava);
+    return estatisticas;
+}
+
+int CacheConsultas::getNumEntradas() {
+    std::lock_guard<std::mutex> guarda(trava);
+    return numEntradas;
+}
+
+long long CacheConsultas::getBytesUsados() {
+    std::lock_guard<std::mutex> guarda(trava);
+    return bytesUsados;
+}
\ No newline at end of file
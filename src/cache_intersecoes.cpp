@@ -0,0 +1,298 @@
+#include "cache_intersecoes.hpp"
+#include "dicionario_hash.hpp"
+#include <cstring>
+
+// ============================================================================
+// CacheIntersecoes - Implementação
+// ============================================================================
+
+// Valor máximo de um contador de frequência
+static const int FREQUENCIA_MAXIMA = 15;
+
+CacheIntersecoes::CacheIntersecoes(int maxEntradas, long long maxBytes)
+    : maxEntradas(maxEntradas > 0 ? maxEntradas : 1), maxBytes(maxBytes),
+      entradas(nullptr), livre(0), baldes(nullptr), numBaldes(16),
+      maisRecente(-1), menosRecente(-1), numEntradas(0), bytesUsados(0),
+      frequencias(nullptr), incrementos(0) {
+    entradas = new EntradaCacheIntersecao[this->maxEntradas];
+    for (int i = 0; i < this->maxEntradas; i++) {
+        entradas[i].slots = nullptr;
+        entradas[i].numSlots = 0;
+        entradas[i].proximo = i + 1 < this->maxEntradas ? i + 1 : -1;
+    }
+
+    while (numBaldes < 2 * this->maxEntradas) {
+        numBaldes *= 2;
+    }
+    baldes = new int[numBaldes];
+    for (int b = 0; b < numBaldes; b++) {
+        baldes[b] = -1;
+    }
+
+    frequencias = new unsigned char[TAMANHO_CONTADOR_FREQUENCIAS];
+    std::memset(frequencias, 0, TAMANHO_CONTADOR_FREQUENCIAS);
+}
+
+CacheIntersecoes::~CacheIntersecoes() {
+    for (int i = 0; i < maxEntradas; i++) {
+        delete[] entradas[i].slots;
+    }
+    delete[] entradas;
+    delete[] baldes;
+    delete[] frequencias;
+}
+
+/**
+ * Hash da tupla de ids
+ */
+static uint32_t hashTermos(const int* termos, int numTermos) {
+    return DicionarioHash::calcularHash(reinterpret_cast<const char*>(termos),
+                                        numTermos * static_cast<int>(sizeof(int)));
+}
+
+int CacheIntersecoes::registrarFrequencia(uint32_t hash) {
+    // Duas posições por combinação; a estimativa é o menor dos dois contadores
+    int mascara = TAMANHO_CONTADOR_FREQUENCIAS - 1;
+    unsigned char& primeiro = frequencias[hash & mascara];
+    unsigned char& segundo = frequencias[((hash >> 16) ^ (hash * 0x9E3779B1u)) & mascara];
+    if (primeiro < FREQUENCIA_MAXIMA) {
+        primeiro++;
+    }
+    if (segundo < FREQUENCIA_MAXIMA) {
+        segundo++;
+    }
+    int frequencia = primeiro < segundo ? primeiro : segundo;
+
+    // Envelhecimento: combinações que deixaram de aparecer perdem a prioridade
+    if (++incrementos >= 8 * TAMANHO_CONTADOR_FREQUENCIAS) {
+        for (int i = 0; i < TAMANHO_CONTADOR_FREQUENCIAS; i++) {
+            frequencias[i] >>= 1;
+        }
+        incrementos = 0;
+    }
+    return frequencia;
+}
+
+int CacheIntersecoes::localizar(const int* termos, int numTermos, uint32_t hash) const {
+    for (int i = baldes[hash & (numBaldes - 1)]; i >= 0; i = entradas[i].proximoBalde) {
+        if (entradas[i].hash == hash && entradas[i].numTermos == numTermos &&
+            std::memcmp(entradas[i].termos, termos, numTermos * sizeof(int)) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void CacheIntersecoes::desligarLRU(int indice) {
+    EntradaCacheIntersecao& entrada = entradas[indice];
+    if (entrada.anterior >= 0) {
+        entradas[entrada.anterior].proximo = entrada.proximo;
+    } else {
+        maisRecente = entrada.proximo;
+    }
+    if (entrada.proximo >= 0) {
+        entradas[entrada.proximo].anterior = entrada.anterior;
+    } else {
+        menosRecente = entrada.anterior;
+    }
+}
+
+void CacheIntersecoes::ligarComoMaisRecente(int indice) {
+    EntradaCacheIntersecao& entrada = entradas[indice];
+    entrada.anterior = -1;
+    entrada.proximo = maisRecente;
+    if (maisRecente >= 0) {
+        entradas[maisRecente].anterior = indice;
+    } else {
+        menosRecente = indice;
+    }
+    maisRecente = indice;
+}
+
+void CacheIntersecoes::remover(int indice) {
+    EntradaCacheIntersecao& entrada = entradas[indice];
+
+    int* elo = &baldes[entrada.hash & (numBaldes - 1)];
+    while (*elo != indice) {
+        elo = &entradas[*elo].proximoBalde;
+    }
+    *elo = entrada.proximoBalde;
+
+    desligarLRU(indice);
+    bytesUsados -= entrada.bytes;
+    numEntradas--;
+
+    delete[] entrada.slots;
+    entrada.slots = nullptr;
+    entrada.numSlots = 0;
+    entrada.proximo = livre;
+    livre = indice;
+}
+
+void CacheIntersecoes::guardar(const int* termos, int numTermos, uint32_t hash,
+                               const int* slots, int numSlots) {
+    if (localizar(termos, numTermos, hash) >= 0) {
+        return;     // Outra thread já guardou o mesmo resultado
+    }
+
+    long long bytes = static_cast<long long>(sizeof(EntradaCacheIntersecao)) +
+                      static_cast<long long>(numSlots) * static_cast<long long>(sizeof(int));
+    if (bytes > maxBytes) {
+        return;
+    }
+    while (numEntradas > 0 && (numEntradas == maxEntradas || bytesUsados + bytes > maxBytes)) {
+        remover(menosRecente);
+        estatisticas.remocoes++;
+    }
+
+    int indice = livre;
+    EntradaCacheIntersecao& entrada = entradas[indice];
+    livre = entrada.proximo;
+
+    std::memcpy(entrada.termos, termos, numTermos * sizeof(int));
+    entrada.numTermos = numTermos;
+    entrada.hash = hash;
+    entrada.numSlots = numSlots;
+    entrada.slots = new int[numSlots > 0 ? numSlots : 1];
+    std::memcpy(entrada.slots, slots, numSlots * sizeof(int));
+    entrada.bytes = bytes;
+
+    int balde = static_cast<int>(hash & (numBaldes - 1));
+    entrada.proximoBalde = baldes[balde];
+    baldes[balde] = indice;
+    ligarComoMaisRecente(indice);
+    numEntradas++;
+    bytesUsados += bytes;
+    estatisticas.admissoes++;
+}
+
+int CacheIntersecoes::intersectar(const Palavra* indice, const int* termos, int numTermos,
+                                  BufferIntersecao& buffer) {
+    if (numTermos <= 0) {
+        return 0;
+    }
+
+    // Chave: ids em ordem crescente e sem repetição (a ordem e a repetição
+    // não mudam a interseção). Termo ausente: interseção vazia
+    int chave[MAX_TERMOS_CACHE_INTERSECOES];
+    int numChave = 0;
+    for (int i = 0; i < numTermos; i++) {
+        int termo = termos[i];
+        if (termo < 0) {
+            return 0;
+        }
+        int j = numChave;
+        while (j > 0 && chave[j - 1] > termo) {
+            j--;
+        }
+        if (j > 0 && chave[j - 1] == termo) {
+            continue;
+        }
+        if (numChave == MAX_TERMOS_CACHE_INTERSECOES) {
+            numChave = -1;
+            break;
+        }
+        for (int k = numChave; k > j; k--) {
+            chave[k] = chave[k - 1];
+        }
+        chave[j] = termo;
+        numChave++;
+    }
+
+    // Muitos termos ou um só (a "interseção" é a própria lista): sem cache
+    if (numChave < 2) {
+        ListaPostings* listas = new ListaPostings[numTermos];
+        for (int i = 0; i < numTermos; i++) {
+            listas[i] = indice->getPostings(termos[i]);
+        }
+        int numCandidatos = intersectarListas(listas, numTermos, buffer);
+        delete[] listas;
+        return numCandidatos;
+    }
+
+    uint32_t hash = hashTermos(chave, numChave);
+    int frequencia = 0;
+    int numCandidatos = 0;
+    int restante = -1;          // Termo que falta aplicar ao subconjunto reaproveitado
+    {
+        std::lock_guard<std::mutex> guarda(trava);
+        frequencia = registrarFrequencia(hash);
+
+        int i = localizar(chave, numChave, hash);
+        if (i >= 0) {
+            EntradaCacheIntersecao& entrada = entradas[i];
+            buffer.garantir(entrada.numSlots);
+            std::memcpy(buffer.getDados(), entrada.slots, entrada.numSlots * sizeof(int));
+            desligarLRU(i);
+            ligarComoMaisRecente(i);
+            estatisticas.acertos++;
+            return entrada.numSlots;
+        }
+
+        // Combinações com um termo a menos: a de menor resultado é refinada
+        int melhor = -1;
+        int subconjunto[MAX_TERMOS_CACHE_INTERSECOES];
+        for (int fora = 0; numChave >= 3 && fora < numChave; fora++) {
+            int n = 0;
+            for (int k = 0; k < numChave; k++) {
+                if (k != fora) {
+                    subconjunto[n++] = chave[k];
+                }
+            }
+            int s = localizar(subconjunto, n, hashTermos(subconjunto, n));
+            if (s >= 0 && (melhor < 0 || entradas[s].numSlots < entradas[melhor].numSlots)) {
+                melhor = s;
+                restante = chave[fora];
+            }
+        }
+        if (melhor >= 0) {
+            EntradaCacheIntersecao& entrada = entradas[melhor];
+            buffer.garantir(entrada.numSlots);
+            std::memcpy(buffer.getDados(), entrada.slots, entrada.numSlots * sizeof(int));
+            numCandidatos = entrada.numSlots;
+            desligarLRU(melhor);
+            ligarComoMaisRecente(melhor);
+        }
+    }
+
+    // Custo de calcular do zero: postings de todas as listas
+    ListaPostings listas[MAX_TERMOS_CACHE_INTERSECOES];
+    long long custo = 0;
+    for (int k = 0; k < numChave; k++) {
+        listas[k] = indice->getPostings(chave[k]);
+        custo += listas[k].tamanho;
+    }
+
+    if (restante >= 0) {
+        ListaPostings lista = indice->getPostings(restante);
+        numCandidatos = refinarCandidatos(buffer.getDados(), numCandidatos, &lista, 1);
+    } else {
+        numCandidatos = intersectarListas(listas, numChave, buffer);
+    }
+
+    std::lock_guard<std::mutex> guarda(trava);
+    if (restante >= 0) {
+        estatisticas.reaproveitamentos++;
+    } else {
+        estatisticas.faltas++;
+    }
+    if (frequencia >= FREQUENCIA_ADMISSAO_CACHE_INTERSECOES && custo >= CUSTO_MINIMO_CACHE_INTERSECOES) {
+        guardar(chave, numChave, hash, buffer.getDados(), numCandidatos);
+    }
+    return numCandidatos;
+}
+
+EstatisticasCacheIntersecoes CacheIntersecoes::getEstatisticas() {
+    std::lock_guard<std::mutex> guarda(trava);
+    return estatisticas;
+}
+
+int CacheIntersecoes::getNumEntradas() {
+    std::lock_guard<std::mutex> guarda(trava);
+    return numEntradas;
+}
+
+long long CacheIntersecoes::getBytesUsados() {
+    std::lock_guard<std::mutex> guarda(trava);
+    return bytesUsados;
+}
\ No newline at end of file
@@ -1,20 +1,39 @@
 #include "consulta.hpp"
 #include "utils.hpp"
-#include <cstring>
+#include "intersecao.hpp"
+#include "distancias.hpp"
+#include "metrica.hpp"
+#include <cmath>
+#include <limits>
 
 // ============================================================================
 // MaxHeapCandidatos - Implementação
 // ============================================================================
 
 MaxHeapCandidatos::MaxHeapCandidatos(int capacidade)
-    : tamanho(0), capacidade(capacidade) {
-    heap = new Candidato[capacidade];
+    : heap(nullptr), tamanho(0), capacidade(0), alocado(0),
+      menorDescartada(std::numeric_limits<double>::infinity()) {
+    reiniciar(capacidade);
 }
 
 MaxHeapCandidatos::~MaxHeapCandidatos() {
     delete[] heap;
 }
 
+void MaxHeapCandidatos::reiniciar(int capacidade) {
+    if (capacidade < 0) {
+        capacidade = 0;
+    }
+    if (capacidade > alocado) {
+        delete[] heap;
+        heap = new Candidato[capacidade];
+        alocado = capacidade;
+    }
+    this->capacidade = capacidade;
+    tamanho = 0;
+    menorDescartada = std::numeric_limits<double>::infinity();
+}
+
 int MaxHeapCandidatos::pai(int i) const {
     return (i - 1) / 2;
 }
@@ -71,10 +90,16 @@ void MaxHeapCandidatos::inserir(const Candidato& candidato) {
     } else if (candidato < heap[0]) {
         // Heap cheia, mas novo candidato é melhor que o pior (topo)
         // Remove o pior (topo) e insere o novo
+        if (heap[0].distancia < menorDescartada) {
+            menorDescartada = heap[0].distancia;
+        }
         heap[0] = candidato;
         descerHeap(0);
+        INSTR_CONTAR(CONTADOR_SUBSTITUICOES_HEAP, 1);
+    } else if (candidato.distancia < menorDescartada) {
+        // Candidato não entra pois não é melhor que os já armazenados
+        menorDescartada = candidato.distancia;
     }
-    // Caso contrário, candidato não entra pois é pior que os já armazenados
 }
 
 Candidato MaxHeapCandidatos::removerTopo() {
@@ -87,7 +112,7 @@ Candidato MaxHeapCandidatos::removerTopo() {
     return topo;
 }
 
-Candidato MaxHeapCandidatos::getTopo() const {
+const Candidato& MaxHeapCandidatos::getTopo() const {
     return heap[0];
 }
 
@@ -103,21 +128,347 @@ bool MaxHeapCandidatos::estaVazia() const {
     return tamanho == 0;
 }
 
-Candidato* MaxHeapCandidatos::extrairOrdenado(int& tamanhoResultado) {
-    if (tamanho == 0) {
-        tamanhoResultado = 0;
+double MaxHeapCandidatos::getMenorDescartada() const {
+    return menorDescartada;
+}
+
+int MaxHeapCandidatos::ordenar() {
+    // Cada topo (o pior restante) vai para o fim da parte ainda em heap
+    int total = tamanho;
+    while (tamanho > 1) {
+        Candidato topo = heap[0];
+        heap[0] = heap[tamanho - 1];
+        heap[tamanho - 1] = topo;
+        tamanho--;
+        descerHeap(0);
+    }
+    tamanho = 0;
+    return total;
+}
+
+const Candidato* MaxHeapCandidatos::getDados() const {
+    return heap;
+}
+
+const Candidato* MaxHeapCandidatos::extrairOrdenado(int& tamanhoResultado) {
+    tamanhoResultado = ordenar();
+    return tamanhoResultado > 0 ? heap : nullptr;
+}
+
+// ============================================================================
+// Seleção dos R melhores - Implementação
+// ============================================================================
+
+BufferCandidatos::BufferCandidatos() : dados(nullptr), capacidade(0) {
+}
+
+BufferCandidatos::~BufferCandidatos() {
+    delete[] dados;
+}
+
+void BufferCandidatos::garantir(int n) {
+    if (n <= capacidade) {
+        return;
+    }
+    int novaCapacidade = capacidade == 0 ? 1024 : capacidade;
+    while (novaCapacidade < n) {
+        novaCapacidade *= 2;
+    }
+    delete[] dados;
+    dados = new Candidato[novaCapacidade];
+    capacidade = novaCapacidade;
+}
+
+Candidato* BufferCandidatos::getDados() {
+    return dados;
+}
+
+EstrategiaSelecao escolherSelecao(int numCandidatos, int maxRespostas) {
+    if (maxRespostas >= numCandidatos) {
+        return SELECAO_ORDENACAO;
+    }
+    if (maxRespostas <= MAXIMO_RESPOSTAS_HEAP &&
+        numCandidatos >= maxRespostas * LIMIAR_RAZAO_HEAP) {
+        return SELECAO_HEAP;
+    }
+    return SELECAO_PARTICAO;
+}
+
+// Abaixo deste tamanho, trechos são ordenados por inserção
+static const int LIMIAR_INSERCAO = 16;
+
+/**
+ * Ordens usadas pela ordenação e pela partição
+ */
+struct MenorDistancia {
+    bool operator()(const Candidato& a, const Candidato& b) const {
+        return a < b;
+    }
+};
+
+struct MenorIdLog {
+    bool operator()(const Candidato& a, const Candidato& b) const {
+        return a.idLog < b.idLog;
+    }
+};
+
+static void trocarCandidatos(Candidato& a, Candidato& b) {
+    Candidato temp = a;
+    a = b;
+    b = temp;
+}
+
+template<typename Menor>
+static void ordenarPorInsercao(Candidato* candidatos, int inicio, int fim, Menor menor) {
+    for (int i = inicio + 1; i < fim; i++) {
+        Candidato atual = candidatos[i];
+        int j = i - 1;
+        while (j >= inicio && menor(atual, candidatos[j])) {
+            candidatos[j + 1] = candidatos[j];
+            j--;
+        }
+        candidatos[j + 1] = atual;
+    }
+}
+
+/**
+ * Particiona [inicio, fim) ao redor da mediana de três; retorna a posição
+ * final do pivô (menores à esquerda, maiores à direita)
+ */
+template<typename Menor>
+static int particionarCandidatosFaixa(Candidato* candidatos, int inicio, int fim, Menor menor) {
+    int meio = inicio + (fim - inicio) / 2;
+    int ultimo = fim - 1;
+    if (menor(candidatos[meio], candidatos[inicio])) {
+        trocarCandidatos(candidatos[meio], candidatos[inicio]);
+    }
+    if (menor(candidatos[ultimo], candidatos[inicio])) {
+        trocarCandidatos(candidatos[ultimo], candidatos[inicio]);
+    }
+    if (menor(candidatos[ultimo], candidatos[meio])) {
+        trocarCandidatos(candidatos[ultimo], candidatos[meio]);
+    }
+
+    // Pivô (a mediana) guardado na penúltima posição
+    trocarCandidatos(candidatos[meio], candidatos[ultimo - 1]);
+    Candidato pivo = candidatos[ultimo - 1];
+    int i = inicio;
+    int j = ultimo - 1;
+    while (true) {
+        while (menor(candidatos[++i], pivo)) {}
+        while (menor(pivo, candidatos[--j])) {}
+        if (i >= j) {
+            break;
+        }
+        trocarCandidatos(candidatos[i], candidatos[j]);
+    }
+    trocarCandidatos(candidatos[i], candidatos[ultimo - 1]);
+    return i;
+}
+
+template<typename Menor>
+static void ordenarCandidatosPor(Candidato* candidatos, int n, Menor menor) {
+    // Quicksort iterando no lado maior e recursão no menor (pilha O(log n))
+    int inicio = 0;
+    int fim = n;
+    while (fim - inicio > LIMIAR_INSERCAO) {
+        int p = particionarCandidatosFaixa(candidatos, inicio, fim, menor);
+        if (p - inicio < fim - p - 1) {
+            ordenarCandidatosPor(candidatos + inicio, p - inicio, menor);
+            inicio = p + 1;
+        } else {
+            ordenarCandidatosPor(candidatos + p + 1, fim - p - 1, menor);
+            fim = p;
+        }
+    }
+    ordenarPorInsercao(candidatos, inicio, fim, menor);
+}
+
+void ordenarCandidatos(Candidato* candidatos, int n) {
+    ordenarCandidatosPor(candidatos, n, MenorDistancia());
+}
+
+void particionarCandidatos(Candidato* candidatos, int n, int k) {
+    // Quickselect: só o lado que contém a posição k continua
+    int inicio = 0;
+    int fim = n;
+    while (fim - inicio > LIMIAR_INSERCAO) {
+        int p = particionarCandidatosFaixa(candidatos, inicio, fim, MenorDistancia());
+        if (p == k) {
+            return;
+        }
+        if (p < k) {
+            inicio = p + 1;
+        } else {
+            fim = p;
+        }
+    }
+    ordenarPorInsercao(candidatos, inicio, fim, MenorDistancia());
+}
+
+bool haEmpateDistancias(const Candidato* ordenados, int n) {
+    for (int i = 1; i < n; i++) {
+        if (ordenados[i].distancia == ordenados[i - 1].distancia) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Filtra um bloco de slots pela distância à origem na Metrica em uso
+ */
+static int filtrarBloco(const TabelaLogradouros* tabela, const int* slots, int n,
+                        const OrigemMetrica& origem, double limiteQuadrado,
+                        int* slotsSaida, double* quadradosSaida) {
+    INSTR_CONTAR(CONTADOR_CANDIDATOS_AVALIADOS, n);
+    if (Metrica::GEODESICA) {
+        return filtrarDistanciasVetores(tabela->getVetores(), slots, n, origem.vetor,
+                                        limiteQuadrado, slotsSaida, quadradosSaida);
+    }
+    return filtrarDistancias(tabela->getLatitudes(), tabela->getLongitudes(), slots, n,
+                             origem.lat, origem.lon, limiteQuadrado, slotsSaida, quadradosSaida);
+}
+
+/**
+ * Distância de um slot até a origem, como candidato
+ */
+static Candidato candidatoDoSlot(const TabelaLogradouros* tabela, int slot,
+                                 const OrigemMetrica& origem) {
+    int sobrevivente;
+    double quadrado;
+    filtrarBloco(tabela, &slot, 1, origem, std::numeric_limits<double>::infinity(),
+                 &sobrevivente, &quadrado);
+    return Candidato(tabela->getIdLog(slot), std::sqrt(quadrado), slot);
+}
+
+/**
+ * Oferece os slots à heap, em blocos filtrados pelo kernel de distâncias
+ * Com a heap cheia, o limite do bloco é o R-ésimo melhor atual: quem fica
+ * acima dele não entraria e é descartado sem raiz quadrada.
+ */
+static void avaliarSlots(const TabelaLogradouros* tabela, const int* slots, int n,
+                         const OrigemMetrica& origem, MaxHeapCandidatos& heap) {
+    int sobreviventes[TAMANHO_BLOCO_DISTANCIAS];
+    double quadrados[TAMANHO_BLOCO_DISTANCIAS];
+    for (int inicio = 0; inicio < n; inicio += TAMANHO_BLOCO_DISTANCIAS) {
+        int tamanho = n - inicio < TAMANHO_BLOCO_DISTANCIAS ? n - inicio : TAMANHO_BLOCO_DISTANCIAS;
+        double limite = heap.estaCheia() ? limiteQuadradoDistancia(heap.getTopo().distancia)
+                                         : std::numeric_limits<double>::infinity();
+        int k = filtrarBloco(tabela, slots + inicio, tamanho, origem, limite,
+                             sobreviventes, quadrados);
+        for (int i = 0; i < k; i++) {
+            heap.inserir(Candidato(tabela->getIdLog(sobreviventes[i]), std::sqrt(quadrados[i]),
+                                   sobreviventes[i]));
+        }
+    }
+}
+
+/**
+ * Calcula a distância de todos os slots à origem (limite infinito; o kernel
+ * só faz a leitura em lote); retorna quantos candidatos foram escritos
+ */
+static int calcularCandidatos(const TabelaLogradouros* tabela, const int* slots, int n,
+                              const OrigemMetrica& origem, Candidato* saida) {
+    int sobreviventes[TAMANHO_BLOCO_DISTANCIAS];
+    double quadrados[TAMANHO_BLOCO_DISTANCIAS];
+    int numSaida = 0;
+    for (int inicio = 0; inicio < n; inicio += TAMANHO_BLOCO_DISTANCIAS) {
+        int tamanho = n - inicio < TAMANHO_BLOCO_DISTANCIAS ? n - inicio : TAMANHO_BLOCO_DISTANCIAS;
+        int k = filtrarBloco(tabela, slots + inicio, tamanho, origem,
+                             std::numeric_limits<double>::infinity(), sobreviventes, quadrados);
+        for (int i = 0; i < k; i++) {
+            saida[numSaida++] = Candidato(tabela->getIdLog(sobreviventes[i]), std::sqrt(quadrados[i]),
+                                          sobreviventes[i]);
+        }
+    }
+    return numSaida;
+}
+
+/**
+ * Seleção como na versão original, para quando há empate de distâncias
+ *
+ * A heap limitada compara só distâncias, então a ordem dos empatados
+ * depende da ordem de inserção. A versão original inseria todos os
+ * candidatos em ordem crescente de IdLog; refazer exatamente isso
+ * (distâncias de todos, ordenação por IdLog, heap de capacidade k e
+ * extração) devolve a mesma ordem, qualquer que tenha sido a ordem de
+ * avaliação da busca. O resultado fica em area.heap.getDados().
+ */
+static int selecionarComoOriginal(const TabelaLogradouros* tabela, const int* slots, int n,
+                                  const OrigemMetrica& origem, int k, AreaTrabalhoConsulta& area) {
+    area.todos.garantir(n);
+    Candidato* todos = area.todos.getDados();
+    int numTodos = calcularCandidatos(tabela, slots, n, origem, todos);
+    ordenarCandidatosPor(todos, numTodos, MenorIdLog());
+
+    MaxHeapCandidatos& heap = area.heap;
+    heap.reiniciar(k);
+    for (int i = 0; i < numTodos; i++) {
+        heap.inserir(todos[i]);
+    }
+    return heap.ordenar();
+}
+
+/**
+ * Retorna true se a ordem do resultado depende de como empates são
+ * desfeitos: distâncias repetidas entre os selecionados, ou o último
+ * selecionado empatado com o melhor dos que ficaram de fora
+ */
+static bool resultadoComEmpate(const Candidato* ordenados, int n, double melhorDeFora) {
+    return haEmpateDistancias(ordenados, n) ||
+           (n > 0 && ordenados[n - 1].distancia == melhorDeFora);
+}
+
+const Candidato* selecionarMaisProximos(const TabelaLogradouros* tabela, const int* slots,
+                                        int numSlots, double latOrigem, double lonOrigem,
+                                        int maxRespostas, AreaTrabalhoConsulta& area,
+                                        int& tamanhoResultado, EstrategiaSelecao estrategia) {
+    tamanhoResultado = 0;
+    int k = maxRespostas < numSlots ? maxRespostas : numSlots;
+    if (k <= 0) {
         return nullptr;
     }
+    if (estrategia == SELECAO_AUTOMATICA) {
+        estrategia = escolherSelecao(numSlots, maxRespostas);
+    }
 
-    tamanhoResultado = tamanho;
-    Candidato* resultado = new Candidato[tamanhoResultado];
+    OrigemMetrica origem(latOrigem, lonOrigem);
+    if (estrategia == SELECAO_HEAP) {
+        MaxHeapCandidatos& heap = area.heap;
+        heap.reiniciar(k);
+        avaliarSlots(tabela, slots, numSlots, origem, heap);
+        const Candidato* resultado = heap.extrairOrdenado(tamanhoResultado);
+        if (resultadoComEmpate(resultado, tamanhoResultado, heap.getMenorDescartada())) {
+            tamanhoResultado = selecionarComoOriginal(tabela, slots, numSlots, origem, k, area);
+        }
+        return heap.getDados();
+    }
 
-    // Extrai do heap em ordem reversa para obter ordem crescente de distância
-    for (int i = tamanhoResultado - 1; i >= 0; i--) {
-        resultado[i] = removerTopo();
+    // Todos são mantidos
+    area.todos.garantir(numSlots);
+    Candidato* todos = area.todos.getDados();
+    int numTodos = calcularCandidatos(tabela, slots, numSlots, origem, todos);
+    if (estrategia == SELECAO_PARTICAO) {
+        particionarCandidatos(todos, numTodos, k);
+        ordenarCandidatos(todos, k);
+    } else {
+        ordenarCandidatos(todos, numTodos);
     }
 
-    return resultado;
+    double melhorDeFora = std::numeric_limits<double>::infinity();
+    for (int i = k; i < numTodos; i++) {
+        if (todos[i].distancia < melhorDeFora) {
+            melhorDeFora = todos[i].distancia;
+        }
+    }
+    if (resultadoComEmpate(todos, k, melhorDeFora)) {
+        tamanhoResultado = selecionarComoOriginal(tabela, slots, numSlots, origem, k, area);
+        return area.heap.getDados();
+    }
+
+    tamanhoResultado = k;
+    return todos;
 }
 
 // ============================================================================
@@ -154,63 +505,188 @@ int Consulta::getMaxRespostas() const {
 }
 
 /**
- * Função auxiliar para interseção eficiente de duas listas ordenadas
- * Tempo: O(n + m) onde n e m são os tamanhos das listas
- * Retorna um array com IDs comuns mantendo ordenação
+ * Calcula a distância de um slot até a origem e o oferece à heap
  */
-static int* intersecaoDuasListas(const int* lista1, int tam1, 
-                                 const int* lista2, int tam2,
-                                 int& tamanhoResultado) {
-    if (tam1 == 0 || tam2 == 0) {
-        tamanhoResultado = 0;
-        return nullptr;
-    }
+static void avaliarSlot(const TabelaLogradouros* tabela, int slot,
+                        const OrigemMetrica& origem, MaxHeapCandidatos& heap) {
+    heap.inserir(candidatoDoSlot(tabela, slot, origem));
+}
 
-    // Aloca espaço máximo possível (mínimo dos tamanhos)
-    int maxTamanho = tam1 < tam2 ? tam1 : tam2;
-    int* resultado = new int[maxTamanho];
-    int idx = 0;
-    int i1 = 0, i2 = 0;
-
-    // Algoritmo de interseção com duas listas ordenadas: O(n + m)
-    while (i1 < tam1 && i2 < tam2) {
-        if (lista1[i1] == lista2[i2]) {
-            resultado[idx++] = lista1[i1];
-            i1++;
-            i2++;
-        } else if (lista1[i1] < lista2[i2]) {
-            i1++;
+/**
+ * Primeira posição de candidatos[0 .. n) com slot >= alvo
+ */
+static int primeiroCandidato(const int* candidatos, int n, int alvo) {
+    int baixo = 0;
+    int alto = n;
+    while (baixo < alto) {
+        int meio = baixo + (alto - baixo) / 2;
+        if (candidatos[meio] < alvo) {
+            baixo = meio + 1;
         } else {
-            i2++;
+            alto = meio;
         }
     }
+    return baixo;
+}
 
-    tamanhoResultado = idx;
-    
-    if (tamanhoResultado == 0) {
-        delete[] resultado;
-        return nullptr;
+/**
+ * Origem dos candidatos durante a busca em anéis
+ * - interseção já calculada ('candidatos' ordenados por slot), ou
+ * - listas de postings intersectadas sob demanda, faixa a faixa de slots
+ *   ('candidatos' nulo), para que listas densas não sejam descomprimidas inteiras
+ */
+struct FonteCandidatos {
+    const int* candidatos;
+    int numCandidatos;
+    ListaPostings* listas;
+    int numListas;
+    AreaTrabalhoConsulta* area;
+};
+
+/**
+ * Avalia os candidatos que caem na faixa de slots [inicio, fim)
+ */
+static void avaliarFaixa(const TabelaLogradouros* tabela, const FonteCandidatos& fonte,
+                         int inicio, int fim,
+                         const OrigemMetrica& origem, MaxHeapCandidatos& heap) {
+    if (fonte.candidatos != nullptr) {
+        const int* candidatos = fonte.candidatos;
+        int n = fonte.numCandidatos;
+        int primeiro = primeiroCandidato(candidatos, n, inicio);
+        int ultimo = primeiro + primeiroCandidato(candidatos + primeiro, n - primeiro, fim);
+        avaliarSlots(tabela, candidatos + primeiro, ultimo - primeiro, origem, heap);
+        return;
     }
 
-    return resultado;
+    int n = intersectarListasFaixa(fonte.listas, fonte.numListas, inicio, fim,
+                                   fonte.area->faixa);
+    avaliarSlots(tabela, fonte.area->faixa.getDados(), n, origem, heap);
 }
 
-Candidato* Consulta::executar(Palavra* indice,
-                             Logradouro** logradourosArray,
-                             int numLogradouros,
-                             double latOrigem,
-                             double lonOrigem,
-                             int& tamanhoResultado) {
+/**
+ * Seleção dos R melhores percorrendo a grade em anéis de células
+ *
+ * Os candidatos estão ordenados por slot e, portanto, agrupados por célula.
+ * O anel k é formado pelas células a distância de Chebyshev k da célula da
+ * origem. Antes de cada anel, se a heap está cheia e o R-ésimo melhor é
+ * menor que o limite inferior de distância das células ainda não visitadas,
+ * a busca termina. Se os anéis passarem por mais células do que pode haver
+ * candidatos (candidatos esparsos), os restantes são avaliados diretamente.
+ */
+static void selecionarPorAneis(const TabelaLogradouros* tabela, const FonteCandidatos& fonte,
+                               const OrigemMetrica& origem, MaxHeapCandidatos& heap) {
+    int numCelulas = tabela->getNumCelulas();
+    int linhas = tabela->getLinhasGrade();
+    int colunas = tabela->getColunasGrade();
+    int limiteCelulas = fonte.candidatos != nullptr ? fonte.numCandidatos
+                                                    : fonte.listas[0].tamanho;
+
+    // Logradouros sem coordenadas finitas não entram na poda: sempre avaliados
+    avaliarFaixa(tabela, fonte, tabela->getInicioCelula(numCelulas), tabela->getTamanho(),
+                 origem, heap);
+
+    int linha, coluna;
+    tabela->localizarCelula(origem.lat, origem.lon, linha, coluna);
+
+    int celulasVisitadas = 0;
+    for (int raio = 0; ; raio++) {
+        if (raio > 0) {
+            double limite = tabela->distanciaMinimaForaDoQuadro(origem.lat, origem.lon,
+                                                                linha, coluna, raio - 1);
+            if (limite < 0.0) {
+                return; // A grade inteira já foi visitada
+            }
+            if (heap.estaCheia() && heap.getTopo().distancia < limite) {
+                return; // Nenhuma célula restante melhora o R-ésimo melhor
+            }
+        }
+
+        if (celulasVisitadas > limiteCelulas) {
+            // Anéis passando por muitas células vazias: avalia o que falta
+            const int* candidatos = fonte.candidatos;
+            int n = fonte.numCandidatos;
+            if (candidatos == nullptr) {
+                n = intersectarListas(fonte.listas, fonte.numListas, fonte.area->intersecao);
+                candidatos = fonte.area->intersecao.getDados();
+            }
+            for (int i = 0; i < n && candidatos[i] < tabela->getInicioCelula(numCelulas); i++) {
+                int l, c;
+                tabela->localizarCelula(tabela->getLatitude(candidatos[i]),
+                                        tabela->getLongitude(candidatos[i]), l, c);
+                int dl = l > linha ? l - linha : linha - l;
+                int dc = c > coluna ? c - coluna : coluna - c;
+                if (dl >= raio || dc >= raio) {
+                    avaliarSlot(tabela, candidatos[i], origem, heap);
+                }
+            }
+            return;
+        }
+
+        int colunaInicio = coluna - raio > 0 ? coluna - raio : 0;
+        int colunaFim = coluna + raio < colunas - 1 ? coluna + raio : colunas - 1;
+        for (int l = linha - raio; l <= linha + raio; l++) {
+            if (l < 0 || l >= linhas) {
+                continue;
+            }
+            if (l == linha - raio || l == linha + raio) {
+                // Borda superior/inferior do anel: células contíguas em slots
+                avaliarFaixa(tabela, fonte,
+                             tabela->getInicioCelula(l * colunas + colunaInicio),
+                             tabela->getInicioCelula(l * colunas + colunaFim + 1),
+                             origem, heap);
+                celulasVisitadas += colunaFim - colunaInicio + 1;
+                continue;
+            }
+            // Laterais do anel: uma célula de cada lado
+            if (coluna - raio >= 0) {
+                int celula = l * colunas + coluna - raio;
+                avaliarFaixa(tabela, fonte,
+                             tabela->getInicioCelula(celula), tabela->getInicioCelula(celula + 1),
+                             origem, heap);
+                celulasVisitadas++;
+            }
+            if (coluna + raio < colunas) {
+                int celula = l * colunas + coluna + raio;
+                avaliarFaixa(tabela, fonte,
+                             tabela->getInicioCelula(celula), tabela->getInicioCelula(celula + 1),
+                             origem, heap);
+                celulasVisitadas++;
+            }
+        }
+    }
+}
+
+/**
+ * A busca em anéis compensa quando os R melhores devem aparecer em poucas
+ * células: com m candidatos espalhados por C células, são cerca de R * C / m
+ * células até juntar R candidatos, o que precisa ficar bem abaixo de m
+ */
+static bool compensaAneis(int numCandidatos, int maxRespostas, int numCelulas) {
+    return numCandidatos > LIMIAR_CANDIDATOS_GRADE &&
+           static_cast<long long>(numCandidatos) * numCandidatos >=
+               4LL * maxRespostas * numCelulas;
+}
+
+const Candidato* Consulta::executar(const Palavra* indice,
+                                   const TabelaLogradouros* tabela,
+                                   double latOrigem,
+                                   double lonOrigem,
+                                   int& tamanhoResultado,
+                                   AreaTrabalhoConsulta& area) {
     tamanhoResultado = 0;
 
-    if (indice == nullptr || logradourosArray == nullptr || numLogradouros == 0) {
+    if (indice == nullptr || tabela == nullptr || tabela->getTamanho() == 0) {
         return nullptr;
     }
 
+    INSTR_ESCOPO(&area.instrumentacao);
+    INSTR_CONTAR(CONTADOR_CONSULTAS, 1);
+
     // ========================================================================
     // FASE 1: Dividir consulta em palavras e recuperar listas de logradouros
     // ========================================================================
-    
+
+    INSTR_INICIO_FASE(inicioTermos);
     int numPalavrasConsulta = 0;
     std::string* palavrasConsulta = dividirString(consultaTexto, ' ', numPalavrasConsulta);
 
@@ -218,138 +694,102 @@ Candidato* Consulta::executar(Palavra* indice,
         return nullptr;
     }
 
-    // Recuperar listas de logradouros para cada palavra
-    int** listasLogradouros = new int*[numPalavrasConsulta];
-    int* tamanhosListas = new int[numPalavrasConsulta];
+    // Recuperar as listas do índice congelado (ordenadas e comprimidas, sem cópia)
+    ListaPostings* listasLogradouros = new ListaPostings[numPalavrasConsulta];
+    int* idsTermos = new int[numPalavrasConsulta];
 
     for (int i = 0; i < numPalavrasConsulta; i++) {
-        ListaInteiros* lista = indice->buscar(palavrasConsulta[i]);
-        if (lista == nullptr || lista->getTamanho() == 0) {
-            tamanhosListas[i] = 0;
-            listasLogradouros[i] = nullptr;
-        } else {
-            listasLogradouros[i] = lista->toArray();
-            tamanhosListas[i] = lista->getTamanho();
-            
-            // Ordenar a lista para permitir interseção eficiente
-            if (tamanhosListas[i] > 1) {
-                quicksort(listasLogradouros[i], 0, tamanhosListas[i] - 1);
-            }
-        }
+        idsTermos[i] = indice->buscarIdTermo(palavrasConsulta[i]);
+        listasLogradouros[i] = indice->getPostings(idsTermos[i]);
+        INSTR_CONTAR(CONTADOR_POSTINGS_LIDOS, listasLogradouros[i].tamanho);
     }
+    INSTR_FIM_FASE(FASE_TERMOS, inicioTermos);
 
     // ========================================================================
     // FASE 2: Interseção das listas (logradouros com TODAS as palavras)
-    //         Cálculo de distâncias euclidianas
+    //         Cálculo de distâncias (Metrica em uso)
     // ========================================================================
-    
-    int* candidatos = nullptr;
-    int numCandidatos = 0;
-
-    if (numPalavrasConsulta == 1) {
-        // Se há apenas uma palavra, os candidatos são todos da lista
-        if (listasLogradouros[0] != nullptr && tamanhosListas[0] > 0) {
-            numCandidatos = tamanhosListas[0];
-            candidatos = new int[numCandidatos];
-            for (int i = 0; i < numCandidatos; i++) {
-                candidatos[i] = listasLogradouros[0][i];
-            }
-        }
-    } else {
-        // Múltiplas palavras - fazer interseção sucessiva
-        int* temp = nullptr;
-        int tempTamanho = 0;
-
-        // Começa com as duas primeiras listas
-        if (listasLogradouros[0] != nullptr && listasLogradouros[1] != nullptr &&
-            tamanhosListas[0] > 0 && tamanhosListas[1] > 0) {
-            temp = intersecaoDuasListas(listasLogradouros[0], tamanhosListas[0],
-                                       listasLogradouros[1], tamanhosListas[1],
-                                       tempTamanho);
-        }
 
-        // Intersecta progressivamente com as demais listas
-        for (int i = 2; i < numPalavrasConsulta && tempTamanho > 0; i++) {
-            if (listasLogradouros[i] != nullptr && tamanhosListas[i] > 0) {
-                int* novo = intersecaoDuasListas(temp, tempTamanho,
-                                                listasLogradouros[i], tamanhosListas[i],
-                                                numCandidatos);
-                delete[] temp;
-                temp = novo;
-                tempTamanho = numCandidatos;
-            } else {
-                tempTamanho = 0;
-                if (temp != nullptr) delete[] temp;
-                temp = nullptr;
-                break;
-            }
-        }
-
-        candidatos = temp;
-        numCandidatos = tempTamanho;
+    INSTR_INICIO_FASE(inicioIntersecao);
+    bool usarGrade = maxRespostas > 0 && tabela->getNumCelulas() > 1;
+
+    FonteCandidatos fonte;
+    fonte.candidatos = nullptr;
+    fonte.numCandidatos = 0;
+    fonte.listas = listasLogradouros;
+    fonte.numListas = numPalavrasConsulta;
+    fonte.area = &area;
+
+    // Da menor para a maior lista, escolhendo merge ou galope por par.
+    // Se até a menor lista é densa, a interseção fica para a fase 3, feita
+    // só nas faixas de slots das células visitadas
+    ordenarListasPorTamanho(listasLogradouros, numPalavrasConsulta);
+    int menorLista = listasLogradouros[0].tamanho;
+    bool sobDemanda = usarGrade &&
+                      compensaAneis(menorLista, maxRespostas, tabela->getNumCelulas()) &&
+                      static_cast<long long>(menorLista) * DIVISOR_DENSIDADE_SOB_DEMANDA >=
+                          tabela->getTamanho();
+    if (!sobDemanda && area.cacheIntersecoes != nullptr) {
+        // Interseção materializada de combinações frequentes, reaproveitada
+        // para qualquer origem
+        fonte.numCandidatos = area.cacheIntersecoes->intersectar(indice, idsTermos,
+                                                                 numPalavrasConsulta,
+                                                                 area.intersecao);
+        fonte.candidatos = area.intersecao.getDados();
+    } else if (!sobDemanda) {
+        fonte.numCandidatos = intersectarListas(listasLogradouros, numPalavrasConsulta,
+                                                area.intersecao);
+        fonte.candidatos = area.intersecao.getDados();
     }
+    INSTR_CONTAR(CONTADOR_CANDIDATOS_INTERSECAO, fonte.numCandidatos);
+    INSTR_FIM_FASE(FASE_INTERSECAO, inicioIntersecao);
 
     // ========================================================================
-    // FASE 3: Max-Heap de tamanho R para selecionar os R melhores
+    // FASE 3: Seleção dos R melhores
     // ========================================================================
-    
-    MaxHeapCandidatos heap(maxRespostas);
-
-    for (int i = 0; i < numCandidatos; i++) {
-        int idLog = candidatos[i];
-        
-        // Encontrar o logradouro correspondente a este idLog
-        Logradouro* logradouro = nullptr;
-        for (int j = 0; j < numLogradouros; j++) {
-            if (logradourosArray[j] != nullptr) {
-                try {
-                    int idLogArray = std::stoi(logradourosArray[j]->getIdLog());
-                    if (idLogArray == idLog) {
-                        logradouro = logradourosArray[j];
-                        break;
-                    }
-                } catch (...) {
-                    // Erro de conversão, pula
-                }
-            }
-        }
 
-        if (logradouro != nullptr) {
-            // FASE 2: Calcular distância euclidiana
-            double distancia = calcularDistancia(latOrigem, lonOrigem,
-                                                logradouro->getLatMedia(),
-                                                logradouro->getLonMedia());
+    INSTR_INICIO_FASE(inicioSelecao);
+
+    // Os candidatos já são slots da tabela densa de logradouros, agrupados por
+    // célula. Nos anéis a heap limitada a R dá o critério de parada; nunca há
+    // mais candidatos que logradouros, o que limita a capacidade mesmo com R
+    // enorme. Avaliando todos, a estratégia depende de R e do número de candidatos
+    const Candidato* resultado = nullptr;
+    if (sobDemanda ||
+        (usarGrade && compensaAneis(fonte.numCandidatos, maxRespostas, tabela->getNumCelulas()))) {
+        MaxHeapCandidatos& heap = area.heap;
+        int capacidade = maxRespostas < tabela->getTamanho() ? maxRespostas : tabela->getTamanho();
+        OrigemMetrica origem(latOrigem, lonOrigem);
+        heap.reiniciar(capacidade);
+        selecionarPorAneis(tabela, fonte, origem, heap);
+        resultado = heap.extrairOrdenado(tamanhoResultado);
 
-            // FASE 3: Inserir na heap se for um dos R melhores
-            Candidato cand(idLog, logradouro->getNome(), distancia);
-            heap.inserir(cand);
+        // Células não visitadas só têm candidatos a distância maior que o
+        // R-ésimo: o empate só pode vir dos avaliados
+        if (resultadoComEmpate(resultado, tamanhoResultado, heap.getMenorDescartada())) {
+            if (fonte.candidatos == nullptr) {
+                fonte.numCandidatos = intersectarListas(listasLogradouros, numPalavrasConsulta,
+                                                        area.intersecao);
+                fonte.candidatos = area.intersecao.getDados();
+            }
+            tamanhoResultado = selecionarComoOriginal(tabela, fonte.candidatos, fonte.numCandidatos,
+                                                      origem, capacidade, area);
+            resultado = heap.getDados();
         }
-    }
-
-    // Extrai os resultados ordenados
-    Candidato* resultado = nullptr;
-    if (heap.getTamanho() > 0) {
-        resultado = heap.extrairOrdenado(tamanhoResultado);
     } else {
-        tamanhoResultado = 0;
+        resultado = selecionarMaisProximos(tabela, fonte.candidatos, fonte.numCandidatos,
+                                           latOrigem, lonOrigem, maxRespostas, area,
+                                           tamanhoResultado);
     }
+    INSTR_FIM_FASE(FASE_SELECAO, inicioSelecao);
 
     // ========================================================================
     // Limpeza de memória
     // ========================================================================
     
-    for (int i = 0; i < numPalavrasConsulta; i++) {
-        if (listasLogradouros[i] != nullptr) {
-            delete[] listasLogradouros[i];
-        }
-    }
     delete[] listasLogradouros;
-    delete[] tamanhosListas;
+    delete[] idsTermos;
     delete[] palavrasConsulta;
-    
-    if (candidatos != nullptr) {
-        delete[] candidatos;
-    }
 
     return resultado;
 }
\ No newline at end of file
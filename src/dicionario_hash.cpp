@@ -0,0 +1,197 @@
+#include "dicionario_hash.hpp"
+#include <cstring>
+
+// Fator de carga máximo (7/8): Robin Hood mantém as sondagens curtas mesmo assim
+static const int CARGA_NUMERADOR = 7;
+static const int CARGA_DENOMINADOR = 8;
+
+uint32_t DicionarioHash::calcularHash(const char* palavra, int tamanho) {
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < tamanho; i++) {
+        hash ^= static_cast<unsigned char>(palavra[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+DicionarioHash::DicionarioHash(int capacidadeInicial)
+    : slots(nullptr), capacidade(16), numTermos(0),
+      textos(nullptr), tamanhoTextos(0), capacidadeTextos(0),
+      inicioTexto(nullptr), capacidadeTermos(0), donoDosArrays(true) {
+    while (capacidade < capacidadeInicial) {
+        capacidade *= 2;
+    }
+    slots = new SlotDicionario[capacidade];
+    for (int i = 0; i < capacidade; i++) {
+        slots[i].hash = 0;
+        slots[i].idTermo = -1;
+    }
+
+    capacidadeTermos = 16;
+    inicioTexto = new int[capacidadeTermos + 1];
+    inicioTexto[0] = 0;
+
+    capacidadeTextos = 256;
+    textos = new char[capacidadeTextos];
+}
+
+DicionarioHash::DicionarioHash(const DadosDicionario& dadosExternos)
+    : slots(dadosExternos.slots), capacidade(dadosExternos.capacidade),
+      numTermos(dadosExternos.numTermos),
+      textos(dadosExternos.textos), tamanhoTextos(dadosExternos.tamanhoTextos),
+      capacidadeTextos(dadosExternos.tamanhoTextos),
+      inicioTexto(dadosExternos.inicioTexto), capacidadeTermos(dadosExternos.numTermos),
+      donoDosArrays(false) {
+}
+
+DicionarioHash::~DicionarioHash() {
+    if (!donoDosArrays) {
+        return;
+    }
+    delete[] slots;
+    delete[] textos;
+    delete[] inicioTexto;
+}
+
+int DicionarioHash::distancia(uint32_t hash, int posicao) const {
+    return (posicao - static_cast<int>(hash & (capacidade - 1))) & (capacidade - 1);
+}
+
+bool DicionarioHash::textoIgual(int id, const char* palavra, int tamanho) const {
+    int inicio = inicioTexto[id];
+    return inicioTexto[id + 1] - inicio == tamanho &&
+           std::memcmp(textos + inicio, palavra, tamanho) == 0;
+}
+
+void DicionarioHash::inserirSlot(SlotDicionario slot) {
+    int mascara = capacidade - 1;
+    int posicao = static_cast<int>(slot.hash & mascara);
+    int dist = 0;
+
+    while (true) {
+        if (slots[posicao].idTermo < 0) {
+            slots[posicao] = slot;
+            return;
+        }
+
+        // Robin Hood: quem está mais longe da posição ideal fica com o slot
+        int distExistente = distancia(slots[posicao].hash, posicao);
+        if (distExistente < dist) {
+            SlotDicionario temp = slots[posicao];
+            slots[posicao] = slot;
+            slot = temp;
+            dist = distExistente;
+        }
+
+        posicao = (posicao + 1) & mascara;
+        dist++;
+    }
+}
+
+void DicionarioHash::crescer() {
+    SlotDicionario* antigos = slots;
+    int capacidadeAntiga = capacidade;
+
+    capacidade *= 2;
+    slots = new SlotDicionario[capacidade];
+    for (int i = 0; i < capacidade; i++) {
+        slots[i].hash = 0;
+        slots[i].idTermo = -1;
+    }
+
+    for (int i = 0; i < capacidadeAntiga; i++) {
+        if (antigos[i].idTermo >= 0) {
+            inserirSlot(antigos[i]);
+        }
+    }
+    delete[] antigos;
+}
+
+void DicionarioHash::guardarTexto(const char* palavra, int tamanho) {
+    if (tamanhoTextos + tamanho > capacidadeTextos) {
+        int novaCapacidade = capacidadeTextos * 2;
+        while (novaCapacidade < tamanhoTextos + tamanho) {
+            novaCapacidade *= 2;
+        }
+        char* novosTextos = new char[novaCapacidade];
+        std::memcpy(novosTextos, textos, tamanhoTextos);
+        delete[] textos;
+        textos = novosTextos;
+        capacidadeTextos = novaCapacidade;
+    }
+
+    if (numTermos >= capacidadeTermos) {
+        int* novoInicio = new int[capacidadeTermos * 2 + 1];
+        std::memcpy(novoInicio, inicioTexto, (capacidadeTermos + 1) * sizeof(int));
+        delete[] inicioTexto;
+        inicioTexto = novoInicio;
+        capacidadeTermos *= 2;
+    }
+
+    std::memcpy(textos + tamanhoTextos, palavra, tamanho);
+    tamanhoTextos += tamanho;
+    inicioTexto[numTermos + 1] = tamanhoTextos;
+}
+
+int DicionarioHash::buscar(const char* palavra, int tamanho) const {
+    uint32_t hash = calcularHash(palavra, tamanho);
+    int mascara = capacidade - 1;
+    int posicao = static_cast<int>(hash & mascara);
+    int dist = 0;
+
+    while (true) {
+        const SlotDicionario& slot = slots[posicao];
+        // Slot vazio ou elemento mais próximo da posição ideal: a palavra não existe
+        if (slot.idTermo < 0 || distancia(slot.hash, posicao) < dist) {
+            return -1;
+        }
+        if (slot.hash == hash && textoIgual(slot.idTermo, palavra, tamanho)) {
+            return slot.idTermo;
+        }
+        posicao = (posicao + 1) & mascara;
+        dist++;
+    }
+}
+
+int DicionarioHash::buscar(const std::string& palavra) const {
+    return buscar(palavra.data(), static_cast<int>(palavra.size()));
+}
+
+int DicionarioHash::obterOuInserir(const std::string& palavra) {
+    return obterOuInserir(palavra.data(), static_cast<int>(palavra.size()));
+}
+
+int DicionarioHash::obterOuInserir(const char* palavra, int tamanho) {
+    int id = buscar(palavra, tamanho);
+    if (id >= 0) {
+        return id;
+    }
+
+    if ((numTermos + 1) * CARGA_DENOMINADOR > capacidade * CARGA_NUMERADOR) {
+        crescer();
+    }
+
+    SlotDicionario slot;
+    slot.hash = calcularHash(palavra, tamanho);
+    slot.idTermo = numTermos;
+    guardarTexto(palavra, tamanho);
+    inserirSlot(slot);
+    return numTermos++;
+}
+
+int DicionarioHash::getNumTermos() const {
+    return numTermos;
+}
+
+std::string DicionarioHash::getTexto(int id) const {
+    return std::string(textos + inicioTexto[id], inicioTexto[id + 1] - inicioTexto[id]);
+}
+
+void DicionarioHash::exportar(DadosDicionario& saida) const {
+    saida.slots = slots;
+    saida.capacidade = capacidade;
+    saida.numTermos = numTermos;
+    saida.textos = textos;
+    saida.tamanhoTextos = tamanhoTextos;
+    saida.inicioTexto = inicioTexto;
+}
\ No newline at end of file
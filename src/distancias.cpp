@@ -0,0 +1,347 @@
+#include "distancias.hpp"
+#include <cmath>
+#include <limits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define DISTANCIAS_X86 1
+#endif
+
+// ============================================================================
+// Kernel escalar
+// ============================================================================
+
+int filtrarDistanciasEscalar(const double* latitudes, const double* longitudes,
+                             const int* slots, int n, double latOrigem, double lonOrigem,
+                             double limiteQuadrado, int* slotsSaida, double* quadradosSaida) {
+    int k = 0;
+    for (int i = 0; i < n; i++) {
+        int slot = slots[i];
+        double deltaLat = latitudes[slot] - latOrigem;
+        double deltaLon = longitudes[slot] - lonOrigem;
+        double quadrado = deltaLat * deltaLat + deltaLon * deltaLon;
+        // Negado para manter NaN, como a comparação vetorial _CMP_NGT_UQ
+        if (!(quadrado > limiteQuadrado)) {
+            slotsSaida[k] = slot;
+            quadradosSaida[k] = quadrado;
+            k++;
+        }
+    }
+    return k;
+}
+
+int filtrarDistanciasVetoresEscalar(const double* vetores, const int* slots, int n,
+                                    const double* origem, double limiteQuadrado,
+                                    int* slotsSaida, double* quadradosSaida) {
+    int k = 0;
+    for (int i = 0; i < n; i++) {
+        int slot = slots[i];
+        const double* vetor = vetores + static_cast<long long>(slot) * COMPONENTES_VETOR;
+        double deltaX = vetor[0] - origem[0];
+        double deltaY = vetor[1] - origem[1];
+        double deltaZ = vetor[2] - origem[2];
+        double quadrado = deltaX * deltaX + deltaY * deltaY + deltaZ * deltaZ;
+        if (!(quadrado > limiteQuadrado)) {
+            slotsSaida[k] = slot;
+            quadradosSaida[k] = quadrado;
+            k++;
+        }
+    }
+    return k;
+}
+
+#ifdef DISTANCIAS_X86
+
+// ============================================================================
+// Kernel AVX2: 4 slots por iteração
+// ============================================================================
+
+__attribute__((target("avx2")))
+int filtrarDistanciasAvx2(const double* latitudes, const double* longitudes,
+                          const int* slots, int n, double latOrigem, double lonOrigem,
+                          double limiteQuadrado, int* slotsSaida, double* quadradosSaida) {
+    __m256d origemLat = _mm256_set1_pd(latOrigem);
+    __m256d origemLon = _mm256_set1_pd(lonOrigem);
+    __m256d limite = _mm256_set1_pd(limiteQuadrado);
+    // Gathers com máscara e origem explícitas (as formas sem máscara partem
+    // de um vetor indefinido, que o GCC acusa como não inicializado)
+    __m256d zero = _mm256_setzero_pd();
+    __m256d todas = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    int k = 0;
+    int i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        __m128i indices = _mm_loadu_si128(reinterpret_cast<const __m128i*>(slots + i));
+        __m256d deltaLat = _mm256_sub_pd(
+            _mm256_mask_i32gather_pd(zero, latitudes, indices, todas, 8), origemLat);
+        __m256d deltaLon = _mm256_sub_pd(
+            _mm256_mask_i32gather_pd(zero, longitudes, indices, todas, 8), origemLon);
+        __m256d quadrados = _mm256_add_pd(_mm256_mul_pd(deltaLat, deltaLat),
+                                          _mm256_mul_pd(deltaLon, deltaLon));
+
+        int mascara = _mm256_movemask_pd(_mm256_cmp_pd(quadrados, limite, _CMP_NGT_UQ));
+        if (mascara == 0) {
+            continue;
+        }
+        double valores[4];
+        _mm256_storeu_pd(valores, quadrados);
+        while (mascara != 0) {
+            int lane = __builtin_ctz(mascara);
+            slotsSaida[k] = slots[i + lane];
+            quadradosSaida[k] = valores[lane];
+            k++;
+            mascara &= mascara - 1;
+        }
+    }
+
+    return k + filtrarDistanciasEscalar(latitudes, longitudes, slots + i, n - i,
+                                        latOrigem, lonOrigem, limiteQuadrado,
+                                        slotsSaida + k, quadradosSaida + k);
+}
+
+__attribute__((target("avx2")))
+int filtrarDistanciasVetoresAvx2(const double* vetores, const int* slots, int n,
+                                 const double* origem, double limiteQuadrado,
+                                 int* slotsSaida, double* quadradosSaida) {
+    __m256d origemX = _mm256_set1_pd(origem[0]);
+    __m256d origemY = _mm256_set1_pd(origem[1]);
+    __m256d origemZ = _mm256_set1_pd(origem[2]);
+    __m256d limite = _mm256_set1_pd(limiteQuadrado);
+    __m256d zero = _mm256_setzero_pd();
+    __m256d todas = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    int k = 0;
+    int i = 0;
+
+    for (; i + 4 <= n; i += 4) {
+        // Índice do primeiro componente de cada vetor: slot * COMPONENTES_VETOR
+        __m128i indices = _mm_slli_epi32(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(slots + i)), 2);
+        __m256d deltaX = _mm256_sub_pd(
+            _mm256_mask_i32gather_pd(zero, vetores, indices, todas, 8), origemX);
+        __m256d deltaY = _mm256_sub_pd(
+            _mm256_mask_i32gather_pd(zero, vetores + 1, indices, todas, 8), origemY);
+        __m256d deltaZ = _mm256_sub_pd(
+            _mm256_mask_i32gather_pd(zero, vetores + 2, indices, todas, 8), origemZ);
+        __m256d quadrados = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(deltaX, deltaX),
+                                                        _mm256_mul_pd(deltaY, deltaY)),
+                                          _mm256_mul_pd(deltaZ, deltaZ));
+
+        int mascara = _mm256_movemask_pd(_mm256_cmp_pd(quadrados, limite, _CMP_NGT_UQ));
+        if (mascara == 0) {
+            continue;
+        }
+        double valores[4];
+        _mm256_storeu_pd(valores, quadrados);
+        while (mascara != 0) {
+            int lane = __builtin_ctz(mascara);
+            slotsSaida[k] = slots[i + lane];
+            quadradosSaida[k] = valores[lane];
+            k++;
+            mascara &= mascara - 1;
+        }
+    }
+
+    // O GCC não emite vzeroupper antes desta chamada (o quadro realinhado da
+    // função o confunde): sem ele, o código SSE seguinte, como a libm, paga a
+    // transição AVX -> SSE a cada instrução
+    _mm256_zeroupper();
+    return k + filtrarDistanciasVetoresEscalar(vetores, slots + i, n - i, origem, limiteQuadrado,
+                                               slotsSaida + k, quadradosSaida + k);
+}
+
+// ============================================================================
+// Kernel AVX-512: 8 slots por iteração, compactação com compress-store
+// ============================================================================
+
+__attribute__((target("avx512f")))
+int filtrarDistanciasAvx512(const double* latitudes, const double* longitudes,
+                            const int* slots, int n, double latOrigem, double lonOrigem,
+                            double limiteQuadrado, int* slotsSaida, double* quadradosSaida) {
+    __m512d origemLat = _mm512_set1_pd(latOrigem);
+    __m512d origemLon = _mm512_set1_pd(lonOrigem);
+    __m512d limite = _mm512_set1_pd(limiteQuadrado);
+    __m512d zero = _mm512_setzero_pd();
+    int k = 0;
+    int i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m256i indices = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(slots + i));
+        __m512d deltaLat = _mm512_sub_pd(
+            _mm512_mask_i32gather_pd(zero, 0xFF, indices, latitudes, 8), origemLat);
+        __m512d deltaLon = _mm512_sub_pd(
+            _mm512_mask_i32gather_pd(zero, 0xFF, indices, longitudes, 8), origemLon);
+        __m512d quadrados = _mm512_add_pd(_mm512_mul_pd(deltaLat, deltaLat),
+                                          _mm512_mul_pd(deltaLon, deltaLon));
+
+        __mmask8 mascara = _mm512_cmp_pd_mask(quadrados, limite, _CMP_NGT_UQ);
+        if (mascara == 0) {
+            continue;
+        }
+        // Os 8 índices ocupam as lanes baixas do vetor de 16 inteiros
+        _mm512_mask_compressstoreu_epi32(slotsSaida + k, static_cast<__mmask16>(mascara),
+                                         _mm512_castsi256_si512(indices));
+        _mm512_mask_compressstoreu_pd(quadradosSaida + k, mascara, quadrados);
+        k += __builtin_popcount(mascara);
+    }
+
+    return k + filtrarDistanciasEscalar(latitudes, longitudes, slots + i, n - i,
+                                        latOrigem, lonOrigem, limiteQuadrado,
+                                        slotsSaida + k, quadradosSaida + k);
+}
+
+__attribute__((target("avx512f")))
+int filtrarDistanciasVetoresAvx512(const double* vetores, const int* slots, int n,
+                                   const double* origem, double limiteQuadrado,
+                                   int* slotsSaida, double* quadradosSaida) {
+    __m512d origemX = _mm512_set1_pd(origem[0]);
+    __m512d origemY = _mm512_set1_pd(origem[1]);
+    __m512d origemZ = _mm512_set1_pd(origem[2]);
+    __m512d limite = _mm512_set1_pd(limiteQuadrado);
+    __m512d zero = _mm512_setzero_pd();
+    int k = 0;
+    int i = 0;
+
+    for (; i + 8 <= n; i += 8) {
+        __m256i indices = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(slots + i));
+        __m256i posicoes = _mm256_slli_epi32(indices, 2);
+        __m512d deltaX = _mm512_sub_pd(
+            _mm512_mask_i32gather_pd(zero, 0xFF, posicoes, vetores, 8), origemX);
+        __m512d deltaY = _mm512_sub_pd(
+            _mm512_mask_i32gather_pd(zero, 0xFF, posicoes, vetores + 1, 8), origemY);
+        __m512d deltaZ = _mm512_sub_pd(
+            _mm512_mask_i32gather_pd(zero, 0xFF, posicoes, vetores + 2, 8), origemZ);
+        __m512d quadrados = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(deltaX, deltaX),
+                                                        _mm512_mul_pd(deltaY, deltaY)),
+                                          _mm512_mul_pd(deltaZ, deltaZ));
+
+        __mmask8 mascara = _mm512_cmp_pd_mask(quadrados, limite, _CMP_NGT_UQ);
+        if (mascara == 0) {
+            continue;
+        }
+        _mm512_mask_compressstoreu_epi32(slotsSaida + k, static_cast<__mmask16>(mascara),
+                                         _mm512_castsi256_si512(indices));
+        _mm512_mask_compressstoreu_pd(quadradosSaida + k, mascara, quadrados);
+        k += __builtin_popcount(mascara);
+    }
+
+    // O GCC não emite vzeroupper antes desta chamada (o quadro realinhado da
+    // função o confunde): sem ele, o código SSE seguinte, como a libm, paga a
+    // transição AVX -> SSE a cada instrução
+    _mm256_zeroupper();
+    return k + filtrarDistanciasVetoresEscalar(vetores, slots + i, n - i, origem, limiteQuadrado,
+                                               slotsSaida + k, quadradosSaida + k);
+}
+
+KernelDistancia detectarKernelDistancia() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return KERNEL_DISTANCIA_AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return KERNEL_DISTANCIA_AVX2;
+    }
+    return KERNEL_DISTANCIA_ESCALAR;
+}
+
+#else
+
+int filtrarDistanciasAvx2(const double* latitudes, const double* longitudes,
+                          const int* slots, int n, double latOrigem, double lonOrigem,
+                          double limiteQuadrado, int* slotsSaida, double* quadradosSaida) {
+    return filtrarDistanciasEscalar(latitudes, longitudes, slots, n, latOrigem, lonOrigem,
+                                    limiteQuadrado, slotsSaida, quadradosSaida);
+}
+
+int filtrarDistanciasAvx512(const double* latitudes, const double* longitudes,
+                            const int* slots, int n, double latOrigem, double lonOrigem,
+                            double limiteQuadrado, int* slotsSaida, double* quadradosSaida) {
+    return filtrarDistanciasEscalar(latitudes, longitudes, slots, n, latOrigem, lonOrigem,
+                                    limiteQuadrado, slotsSaida, quadradosSaida);
+}
+
+int filtrarDistanciasVetoresAvx2(const double* vetores, const int* slots, int n,
+                                 const double* origem, double limiteQuadrado,
+                                 int* slotsSaida, double* quadradosSaida) {
+    return filtrarDistanciasVetoresEscalar(vetores, slots, n, origem, limiteQuadrado,
+                                           slotsSaida, quadradosSaida);
+}
+
+int filtrarDistanciasVetoresAvx512(const double* vetores, const int* slots, int n,
+                                   const double* origem, double limiteQuadrado,
+                                   int* slotsSaida, double* quadradosSaida) {
+    return filtrarDistanciasVetoresEscalar(vetores, slots, n, origem, limiteQuadrado,
+                                           slotsSaida, quadradosSaida);
+}
+
+KernelDistancia detectarKernelDistancia() {
+    return KERNEL_DISTANCIA_ESCALAR;
+}
+
+#endif
+
+// ============================================================================
+// Despacho em tempo de execução
+// ============================================================================
+
+typedef int (*FuncaoDistancias)(const double*, const double*, const int*, int,
+                                double, double, double, int*, double*);
+
+typedef int (*FuncaoDistanciasVetores)(const double*, const int*, int, const double*, double,
+                                       int*, double*);
+
+static FuncaoDistancias funcaoParaKernel(KernelDistancia kernel) {
+    switch (kernel) {
+        case KERNEL_DISTANCIA_AVX512:
+            return filtrarDistanciasAvx512;
+        case KERNEL_DISTANCIA_AVX2:
+            return filtrarDistanciasAvx2;
+        default:
+            return filtrarDistanciasEscalar;
+    }
+}
+
+static FuncaoDistanciasVetores funcaoVetoresParaKernel(KernelDistancia kernel) {
+    switch (kernel) {
+        case KERNEL_DISTANCIA_AVX512:
+            return filtrarDistanciasVetoresAvx512;
+        case KERNEL_DISTANCIA_AVX2:
+            return filtrarDistanciasVetoresAvx2;
+        default:
+            return filtrarDistanciasVetoresEscalar;
+    }
+}
+
+static KernelDistancia kernelAtivo = detectarKernelDistancia();
+static FuncaoDistancias funcaoAtiva = funcaoParaKernel(kernelAtivo);
+static FuncaoDistanciasVetores funcaoVetoresAtiva = funcaoVetoresParaKernel(kernelAtivo);
+
+KernelDistancia getKernelDistancia() {
+    return kernelAtivo;
+}
+
+void setKernelDistancia(KernelDistancia kernel) {
+    kernelAtivo = kernel;
+    funcaoAtiva = funcaoParaKernel(kernel);
+    funcaoVetoresAtiva = funcaoVetoresParaKernel(kernel);
+}
+
+int filtrarDistancias(const double* latitudes, const double* longitudes,
+                      const int* slots, int n, double latOrigem, double lonOrigem,
+                      double limiteQuadrado, int* slotsSaida, double* quadradosSaida) {
+    return funcaoAtiva(latitudes, longitudes, slots, n, latOrigem, lonOrigem,
+                       limiteQuadrado, slotsSaida, quadradosSaida);
+}
+
+int filtrarDistanciasVetores(const double* vetores, const int* slots, int n,
+                             const double* origem, double limiteQuadrado,
+                             int* slotsSaida, double* quadradosSaida) {
+    return funcaoVetoresAtiva(vetores, slots, n, origem, limiteQuadrado, slotsSaida, quadradosSaida);
+}
+
+double limiteQuadradoDistancia(double distancia) {
+    if (!std::isfinite(distancia)) {
+        return std::numeric_limits<double>::infinity();
+    }
+    // Se q > d² (1 + 4 eps), sqrt(q) arredondada fica acima de d
+    return distancia * distancia * (1.0 + 4.0 * std::numeric_limits<double>::epsilon());
+}
\ No newline at end of file
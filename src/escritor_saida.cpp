@@ -0,0 +1,54 @@
+#include "escritor_saida.hpp"
+#include <cerrno>
+#include <unistd.h>
+
+// ============================================================================
+// EscritorSaida - Implementação
+// ============================================================================
+
+/**
+ * Escreve todos os bytes, repetindo após escritas parciais e interrupções
+ */
+static bool escreverTudo(int descritor, const char* dados, int tamanho) {
+    while (tamanho > 0) {
+        ssize_t escritos = write(descritor, dados, tamanho);
+        if (escritos < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        dados += escritos;
+        tamanho -= static_cast<int>(escritos);
+    }
+    return true;
+}
+
+EscritorSaida::EscritorSaida(int descritor)
+    : descritor(descritor), buffer(new char[TAMANHO_BUFFER_SAIDA]), usado(0), falhou(false) {}
+
+EscritorSaida::~EscritorSaida() {
+    descarregar();
+    delete[] buffer;
+}
+
+bool EscritorSaida::descarregar() {
+    if (usado > 0 && !falhou && !escreverTudo(descritor, buffer, usado)) {
+        falhou = true;
+    }
+    usado = 0;
+    return !falhou;
+}
+
+void EscritorSaida::escreverLongo(const char* texto, int tamanho) {
+    descarregar();
+    if (tamanho >= TAMANHO_BUFFER_SAIDA) {
+        // Maior que o buffer inteiro: vai direto para o descritor
+        if (!falhou && !escreverTudo(descritor, texto, tamanho)) {
+            falhou = true;
+        }
+        return;
+    }
+    std::memcpy(buffer, texto, tamanho);
+    usado = tamanho;
+}
\ No newline at end of file
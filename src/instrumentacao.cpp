@@ -0,0 +1,60 @@
+#include "instrumentacao.hpp"
+#include <cstdio>
+
+#ifdef INSTRUMENTACAO
+thread_local Instrumentacao* instrumentacaoAtual = nullptr;
+#endif
+
+static const char* NOMES_FASES[NUM_FASES] = {
+    "leitura", "agregacao", "indexacao", "congelamento", "termos", "intersecao", "selecao"
+};
+
+static const char* NOMES_CONTADORES[NUM_CONTADORES] = {
+    "linhas_lidas", "linhas_rejeitadas", "consultas", "postings_lidos",
+    "candidatos_intersecao", "candidatos_avaliados", "substituicoes_heap"
+};
+
+Instrumentacao::Instrumentacao() {
+    for (int f = 0; f < NUM_FASES; f++) {
+        ns[f] = 0;
+    }
+    for (int c = 0; c < NUM_CONTADORES; c++) {
+        contadores[c] = 0;
+    }
+}
+
+void Instrumentacao::acumular(const Instrumentacao& outra) {
+    for (int f = 0; f < NUM_FASES; f++) {
+        ns[f] += outra.ns[f];
+    }
+    for (int c = 0; c < NUM_CONTADORES; c++) {
+        contadores[c] += outra.contadores[c];
+    }
+}
+
+void Instrumentacao::escreverTexto(std::ostream& saida) const {
+    for (int f = 0; f < NUM_FASES; f++) {
+        saida << "fase_" << NOMES_FASES[f] << "_ms=" << ns[f] / 1e6 << std::endl;
+    }
+    for (int c = 0; c < NUM_CONTADORES; c++) {
+        saida << NOMES_CONTADORES[c] << "=" << contadores[c] << std::endl;
+    }
+}
+
+bool Instrumentacao::escreverJson(const char* caminho) const {
+    std::FILE* arquivo = std::fopen(caminho, "w");
+    if (arquivo == nullptr) {
+        return false;
+    }
+    std::fprintf(arquivo, "{\n  \"fases_ms\": {");
+    for (int f = 0; f < NUM_FASES; f++) {
+        std::fprintf(arquivo, "%s\"%s\": %.3f", f > 0 ? ", " : "", NOMES_FASES[f], ns[f] / 1e6);
+    }
+    std::fprintf(arquivo, "},\n  \"contadores\": {");
+    for (int c = 0; c < NUM_CONTADORES; c++) {
+        std::fprintf(arquivo, "%s\"%s\": %lld", c > 0 ? ", " : "", NOMES_CONTADORES[c],
+                     contadores[c]);
+    }
+    std::fprintf(arquivo, "}\n}\n");
+    return std::fclose(arquivo) == 0;
+}
\ No newline at end of file
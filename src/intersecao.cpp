@@ -0,0 +1,417 @@
+#include "intersecao.hpp"
+
+// ============================================================================
+// BufferIntersecao - Implementação
+// ============================================================================
+
+BufferIntersecao::BufferIntersecao() : dados(nullptr), capacidade(0) {
+}
+
+BufferIntersecao::~BufferIntersecao() {
+    delete[] dados;
+}
+
+void BufferIntersecao::garantir(int n) {
+    if (n <= capacidade) {
+        return;
+    }
+    int novaCapacidade = capacidade == 0 ? 1024 : capacidade;
+    while (novaCapacidade < n) {
+        novaCapacidade *= 2;
+    }
+    delete[] dados;
+    dados = new int[novaCapacidade];
+    capacidade = novaCapacidade;
+}
+
+int* BufferIntersecao::getDados() {
+    return dados;
+}
+
+int BufferIntersecao::getCapacidade() const {
+    return capacidade;
+}
+
+// ============================================================================
+// Interseção - Implementação
+// ============================================================================
+
+int intersecaoMerge(int* candidatos, int numCandidatos, const ListaPostings& lista) {
+    int bloco[TAMANHO_BLOCO_POSTINGS];
+    int comuns[TAMANHO_BLOCO_POSTINGS + FOLGA_SAIDA_INTERSECAO];
+    int i = 0;
+    int b = 0;
+    int idx = 0;
+
+    while (i < numCandidatos && b < lista.numBlocos) {
+        int alvo = candidatos[i];
+
+        // Salta blocos cujo último slot é menor que o candidato atual
+        while (b < lista.numBlocos && lista.blocos[b].ultimo < alvo) {
+            b++;
+        }
+        if (b == lista.numBlocos) {
+            break;
+        }
+
+        // Salta candidatos anteriores ao primeiro slot do bloco
+        const CabecalhoBloco& cabecalho = lista.blocos[b];
+        while (i < numCandidatos && candidatos[i] < cabecalho.primeiro) {
+            i++;
+        }
+
+        // Faixa de candidatos coberta pelo bloco: [i, fim)
+        int fim = i;
+        while (fim < numCandidatos && candidatos[fim] <= cabecalho.ultimo) {
+            fim++;
+        }
+
+        if (fim > i) {
+            if (cabecalho.bits == 0) {
+                // Bloco de slots consecutivos: todos os candidatos da faixa pertencem a ele
+                for (int j = i; j < fim; j++) {
+                    candidatos[idx++] = candidatos[j];
+                }
+            } else {
+                int tamanhoBloco = decodificarBloco(lista, b, bloco);
+                int numComuns = intersecaoDuasListas(candidatos + i, fim - i,
+                                                     bloco, tamanhoBloco, comuns);
+                for (int j = 0; j < numComuns; j++) {
+                    candidatos[idx++] = comuns[j];
+                }
+            }
+        }
+
+        i = fim;
+        b++;
+    }
+
+    return idx;
+}
+
+/**
+ * Primeiro bloco a partir de 'inicio' cujo último slot é >= alvo
+ * Busca exponencial seguida de busca binária. Retorna numBlocos se não houver.
+ */
+static int galoparBlocos(const ListaPostings& lista, int inicio, int alvo) {
+    if (inicio >= lista.numBlocos || lista.blocos[inicio].ultimo >= alvo) {
+        return inicio;
+    }
+
+    // Invariante: blocos[baixo].ultimo < alvo
+    int baixo = inicio;
+    int passo = 1;
+    while (baixo + passo < lista.numBlocos && lista.blocos[baixo + passo].ultimo < alvo) {
+        baixo += passo;
+        passo *= 2;
+    }
+    int alto = baixo + passo < lista.numBlocos ? baixo + passo : lista.numBlocos;
+
+    // blocos[baixo].ultimo < alvo e (alto == numBlocos ou blocos[alto].ultimo >= alvo)
+    while (alto - baixo > 1) {
+        int meio = baixo + (alto - baixo) / 2;
+        if (lista.blocos[meio].ultimo < alvo) {
+            baixo = meio;
+        } else {
+            alto = meio;
+        }
+    }
+    return alto;
+}
+
+/**
+ * Primeira posição a partir de 'inicio' com valor >= alvo em arr[0 .. n)
+ * Busca exponencial seguida de busca binária. Retorna n se não houver.
+ */
+static int galoparArray(const int* arr, int n, int inicio, int alvo) {
+    if (inicio >= n || arr[inicio] >= alvo) {
+        return inicio;
+    }
+
+    int baixo = inicio;
+    int passo = 1;
+    while (baixo + passo < n && arr[baixo + passo] < alvo) {
+        baixo += passo;
+        passo *= 2;
+    }
+    int alto = baixo + passo < n ? baixo + passo : n;
+
+    while (alto - baixo > 1) {
+        int meio = baixo + (alto - baixo) / 2;
+        if (arr[meio] < alvo) {
+            baixo = meio;
+        } else {
+            alto = meio;
+        }
+    }
+    return alto;
+}
+
+int intersecaoGalope(int* candidatos, int numCandidatos, const ListaPostings& lista) {
+    int bloco[TAMANHO_BLOCO_POSTINGS];
+    int tamanhoBloco = 0;
+    int blocoDecodificado = -1;
+    int pos = 0;
+    int b = 0;
+    int idx = 0;
+
+    for (int i = 0; i < numCandidatos; i++) {
+        int alvo = candidatos[i];
+
+        b = galoparBlocos(lista, b, alvo);
+        if (b == lista.numBlocos) {
+            break;
+        }
+        if (lista.blocos[b].primeiro > alvo) {
+            continue;
+        }
+
+        // Bloco de slots consecutivos: primeiro <= alvo <= ultimo basta
+        if (lista.blocos[b].bits == 0) {
+            candidatos[idx++] = alvo;
+            continue;
+        }
+
+        if (b != blocoDecodificado) {
+            tamanhoBloco = decodificarBloco(lista, b, bloco);
+            blocoDecodificado = b;
+            pos = 0;
+        }
+
+        pos = galoparArray(bloco, tamanhoBloco, pos, alvo);
+        if (bloco[pos] == alvo) {
+            candidatos[idx++] = alvo;
+        }
+    }
+
+    return idx;
+}
+
+/**
+ * Primeira posição a partir de 'inicio' com valor >= alvo em arr[0 .. n)
+ * (versão para os arrays de 16 bits dos containers Roaring)
+ */
+static int galoparValores(const uint16_t* arr, int n, int inicio, int alvo) {
+    if (inicio >= n || arr[inicio] >= alvo) {
+        return inicio;
+    }
+
+    int baixo = inicio;
+    int passo = 1;
+    while (baixo + passo < n && arr[baixo + passo] < alvo) {
+        baixo += passo;
+        passo *= 2;
+    }
+    int alto = baixo + passo < n ? baixo + passo : n;
+
+    while (alto - baixo > 1) {
+        int meio = baixo + (alto - baixo) / 2;
+        if (arr[meio] < alvo) {
+            baixo = meio;
+        } else {
+            alto = meio;
+        }
+    }
+    return alto;
+}
+
+int intersecaoComRoaring(int* candidatos, int numCandidatos, const ListaPostings& lista) {
+    int c = 0;
+    int pos = 0;
+    int idx = 0;
+
+    for (int i = 0; i < numCandidatos && c < lista.numContainers; i++) {
+        int alvo = candidatos[i];
+        int chave = alvo >> 16;
+
+        // Avança até o container dos 16 bits altos do candidato
+        if (lista.containers[c].chave < chave) {
+            while (c < lista.numContainers && lista.containers[c].chave < chave) {
+                c++;
+            }
+            pos = 0;
+            if (c == lista.numContainers) {
+                break;
+            }
+        }
+        const ContainerRoaring& container = lista.containers[c];
+        if (container.chave != chave) {
+            continue;
+        }
+
+        int baixo = alvo & 0xFFFF;
+        if (container.ehBitmap) {
+            uint64_t palavra = lista.bitmaps[container.deslocamento + (baixo >> 6)];
+            if ((palavra >> (baixo & 63)) & 1) {
+                candidatos[idx++] = alvo;
+            }
+        } else {
+            const uint16_t* valores = lista.valores + container.deslocamento;
+            pos = galoparValores(valores, container.cardinalidade, pos, baixo);
+            if (pos < container.cardinalidade && valores[pos] == baixo) {
+                candidatos[idx++] = alvo;
+            }
+        }
+    }
+
+    return idx;
+}
+
+/**
+ * Interseção de dois containers com a mesma chave; grava slots completos
+ */
+static int intersecaoContainers(const ListaPostings& a, const ContainerRoaring& ca,
+                                const ListaPostings& b, const ContainerRoaring& cb,
+                                int* resultado) {
+    int base = ca.chave << 16;
+    int n = 0;
+
+    if (ca.ehBitmap && cb.ehBitmap) {
+        // AND palavra a palavra e extração dos bits ligados
+        const uint64_t* pa = a.bitmaps + ca.deslocamento;
+        const uint64_t* pb = b.bitmaps + cb.deslocamento;
+        for (int w = 0; w < PALAVRAS_CONTAINER_BITMAP; w++) {
+            uint64_t palavra = pa[w] & pb[w];
+            while (palavra != 0) {
+                resultado[n++] = base | (w << 6) | __builtin_ctzll(palavra);
+                palavra &= palavra - 1;
+            }
+        }
+        return n;
+    }
+
+    if (ca.ehBitmap || cb.ehBitmap) {
+        // Array contra bitmap: testa cada valor do array
+        const ListaPostings& listaArray = ca.ehBitmap ? b : a;
+        const ContainerRoaring& array = ca.ehBitmap ? cb : ca;
+        const uint64_t* bitmap = ca.ehBitmap ? a.bitmaps + ca.deslocamento
+                                             : b.bitmaps + cb.deslocamento;
+        const uint16_t* valores = listaArray.valores + array.deslocamento;
+        for (int i = 0; i < array.cardinalidade; i++) {
+            int v = valores[i];
+            if ((bitmap[v >> 6] >> (v & 63)) & 1) {
+                resultado[n++] = base | v;
+            }
+        }
+        return n;
+    }
+
+    // Array contra array: merge
+    const uint16_t* va = a.valores + ca.deslocamento;
+    const uint16_t* vb = b.valores + cb.deslocamento;
+    int i = 0, j = 0;
+    while (i < ca.cardinalidade && j < cb.cardinalidade) {
+        if (va[i] == vb[j]) {
+            resultado[n++] = base | va[i];
+            i++;
+            j++;
+        } else if (va[i] < vb[j]) {
+            i++;
+        } else {
+            j++;
+        }
+    }
+    return n;
+}
+
+int intersecaoRoaring(const ListaPostings& a, const ListaPostings& b, int* resultado) {
+    int i = 0, j = 0;
+    int idx = 0;
+
+    while (i < a.numContainers && j < b.numContainers) {
+        int chaveA = a.containers[i].chave;
+        int chaveB = b.containers[j].chave;
+        if (chaveA == chaveB) {
+            idx += intersecaoContainers(a, a.containers[i], b, b.containers[j], resultado + idx);
+            i++;
+            j++;
+        } else if (chaveA < chaveB) {
+            i++;
+        } else {
+            j++;
+        }
+    }
+
+    return idx;
+}
+
+void ordenarListasPorTamanho(ListaPostings* listas, int numListas) {
+    // Insertion sort: poucas palavras por consulta
+    for (int i = 1; i < numListas; i++) {
+        ListaPostings chave = listas[i];
+        int j = i - 1;
+        while (j >= 0 && listas[j].tamanho > chave.tamanho) {
+            listas[j + 1] = listas[j];
+            j--;
+        }
+        listas[j + 1] = chave;
+    }
+}
+
+int intersectarListas(ListaPostings* listas, int numListas, BufferIntersecao& buffer) {
+    if (numListas <= 0) {
+        return 0;
+    }
+
+    ordenarListasPorTamanho(listas, numListas);
+
+    // Alguma palavra sem logradouros: interseção vazia
+    if (listas[0].tamanho == 0) {
+        return 0;
+    }
+
+    // A menor lista é descomprimida e conduz a interseção; se as duas menores
+    // são Roaring, o ponto de partida é o AND delas, sem descomprimir nenhuma
+    buffer.garantir(listas[0].tamanho);
+    int* candidatos = buffer.getDados();
+    int numCandidatos;
+    int proxima;
+    if (numListas >= 2 && listas[0].ehRoaring() && listas[1].ehRoaring()) {
+        numCandidatos = intersecaoRoaring(listas[0], listas[1], candidatos);
+        proxima = 2;
+    } else {
+        decodificarLista(listas[0], candidatos);
+        numCandidatos = listas[0].tamanho;
+        proxima = 1;
+    }
+
+    return refinarCandidatos(candidatos, numCandidatos, listas + proxima, numListas - proxima);
+}
+
+int refinarCandidatos(int* candidatos, int numCandidatos,
+                      const ListaPostings* listas, int numListas) {
+    for (int i = 0; i < numListas && numCandidatos > 0; i++) {
+        if (listas[i].ehRoaring()) {
+            numCandidatos = intersecaoComRoaring(candidatos, numCandidatos, listas[i]);
+        } else if (listas[i].tamanho >= static_cast<long long>(numCandidatos) * LIMIAR_RAZAO_GALOPE) {
+            numCandidatos = intersecaoGalope(candidatos, numCandidatos, listas[i]);
+        } else {
+            numCandidatos = intersecaoMerge(candidatos, numCandidatos, listas[i]);
+        }
+    }
+
+    return numCandidatos;
+}
+
+int intersectarListasFaixa(const ListaPostings* listas, int numListas,
+                           int inicio, int fim, BufferIntersecao& buffer) {
+    if (numListas <= 0 || inicio >= fim || listas[0].tamanho == 0) {
+        return 0;
+    }
+
+    int largura = fim - inicio;
+    buffer.garantir(largura < listas[0].tamanho ? largura : listas[0].tamanho);
+    int* candidatos = buffer.getDados();
+    int numCandidatos = decodificarFaixa(listas[0], inicio, fim, candidatos);
+
+    // Poucos candidatos contra listas longas: pertinência por galope ou bitmap
+    for (int i = 1; i < numListas && numCandidatos > 0; i++) {
+        if (listas[i].ehRoaring()) {
+            numCandidatos = intersecaoComRoaring(candidatos, numCandidatos, listas[i]);
+        } else {
+            numCandidatos = intersecaoGalope(candidatos, numCandidatos, listas[i]);
+        }
+    }
+
+    return numCandidatos;
+}
\ No newline at end of file
@@ -0,0 +1,265 @@
+#include "intersecao.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define INTERSECAO_X86 1
+#endif
+
+// ============================================================================
+// Kernel escalar
+// ============================================================================
+
+int intersecaoDuasListasEscalar(const int* lista1, int tam1,
+                                const int* lista2, int tam2,
+                                int* resultado) {
+    int idx = 0;
+    int i1 = 0, i2 = 0;
+
+    // Algoritmo de interseção com duas listas ordenadas: O(n + m)
+    while (i1 < tam1 && i2 < tam2) {
+        if (lista1[i1] == lista2[i2]) {
+            resultado[idx++] = lista1[i1];
+            i1++;
+            i2++;
+        } else if (lista1[i1] < lista2[i2]) {
+            i1++;
+        } else {
+            i2++;
+        }
+    }
+
+    return idx;
+}
+
+#ifdef INTERSECAO_X86
+
+// ============================================================================
+// Tabelas de compactação (máscara de lanes -> permutação que as leva ao início)
+// ============================================================================
+
+static unsigned char tabelaSse[16][16];
+static int tabelaAvx2[256][8];
+
+static bool inicializarTabelas() {
+    for (int mascara = 0; mascara < 16; mascara++) {
+        int k = 0;
+        for (int lane = 0; lane < 4; lane++) {
+            if (mascara & (1 << lane)) {
+                for (int byte = 0; byte < 4; byte++) {
+                    tabelaSse[mascara][k * 4 + byte] = static_cast<unsigned char>(lane * 4 + byte);
+                }
+                k++;
+            }
+        }
+        for (; k < 4; k++) {
+            for (int byte = 0; byte < 4; byte++) {
+                tabelaSse[mascara][k * 4 + byte] = 0x80;
+            }
+        }
+    }
+
+    for (int mascara = 0; mascara < 256; mascara++) {
+        int k = 0;
+        for (int lane = 0; lane < 8; lane++) {
+            if (mascara & (1 << lane)) {
+                tabelaAvx2[mascara][k++] = lane;
+            }
+        }
+        for (; k < 8; k++) {
+            tabelaAvx2[mascara][k] = 0;
+        }
+    }
+    return true;
+}
+
+static const bool tabelasProntas = inicializarTabelas();
+
+// ============================================================================
+// Kernel SSE4.2: blocos de 4 x 4, comparando todas as rotações
+// ============================================================================
+
+__attribute__((target("sse4.2,popcnt")))
+int intersecaoDuasListasSse(const int* lista1, int tam1,
+                            const int* lista2, int tam2,
+                            int* resultado) {
+    int idx = 0;
+    int i1 = 0, i2 = 0;
+
+    if (tam1 >= 4 && tam2 >= 4) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lista1));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lista2));
+
+        while (true) {
+            // Compara cada lane de va com as 4 lanes de vb (vb e suas 3 rotações)
+            __m128i cmp = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi32(va, vb),
+                             _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1)))),
+                _mm_or_si128(_mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))),
+                             _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3)))));
+            int mascara = _mm_movemask_ps(_mm_castsi128_ps(cmp));
+
+            // Compacta as lanes coincidentes de va no início e grava
+            __m128i controle = _mm_loadu_si128(reinterpret_cast<const __m128i*>(tabelaSse[mascara]));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(resultado + idx),
+                             _mm_shuffle_epi8(va, controle));
+            idx += _mm_popcnt_u32(mascara);
+
+            int maior1 = lista1[i1 + 3];
+            int maior2 = lista2[i2 + 3];
+            if (maior1 <= maior2) {
+                i1 += 4;
+                if (i1 + 4 > tam1) {
+                    if (maior1 == maior2) i2 += 4;
+                    break;
+                }
+                va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lista1 + i1));
+            }
+            if (maior2 <= maior1) {
+                i2 += 4;
+                if (i2 + 4 > tam2) {
+                    break;
+                }
+                vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lista2 + i2));
+            }
+        }
+    }
+
+    return idx + intersecaoDuasListasEscalar(lista1 + i1, tam1 - i1,
+                                             lista2 + i2, tam2 - i2,
+                                             resultado + idx);
+}
+
+// ============================================================================
+// Kernel AVX2: blocos de 8 x 8, comparando todas as rotações
+// ============================================================================
+
+__attribute__((target("avx2,popcnt")))
+int intersecaoDuasListasAvx2(const int* lista1, int tam1,
+                             const int* lista2, int tam2,
+                             int* resultado) {
+    int idx = 0;
+    int i1 = 0, i2 = 0;
+
+    if (tam1 >= 8 && tam2 >= 8) {
+        const __m256i rot1 = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+        const __m256i rot2 = _mm256_setr_epi32(2, 3, 4, 5, 6, 7, 0, 1);
+        const __m256i rot3 = _mm256_setr_epi32(3, 4, 5, 6, 7, 0, 1, 2);
+        const __m256i rot4 = _mm256_setr_epi32(4, 5, 6, 7, 0, 1, 2, 3);
+        const __m256i rot5 = _mm256_setr_epi32(5, 6, 7, 0, 1, 2, 3, 4);
+        const __m256i rot6 = _mm256_setr_epi32(6, 7, 0, 1, 2, 3, 4, 5);
+        const __m256i rot7 = _mm256_setr_epi32(7, 0, 1, 2, 3, 4, 5, 6);
+
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lista1));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lista2));
+
+        while (true) {
+            __m256i c01 = _mm256_or_si256(
+                _mm256_cmpeq_epi32(va, vb),
+                _mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb, rot1)));
+            __m256i c23 = _mm256_or_si256(
+                _mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb, rot2)),
+                _mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb, rot3)));
+            __m256i c45 = _mm256_or_si256(
+                _mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb, rot4)),
+                _mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb, rot5)));
+            __m256i c67 = _mm256_or_si256(
+                _mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb, rot6)),
+                _mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(vb, rot7)));
+            __m256i cmp = _mm256_or_si256(_mm256_or_si256(c01, c23), _mm256_or_si256(c45, c67));
+            int mascara = _mm256_movemask_ps(_mm256_castsi256_ps(cmp));
+
+            __m256i permutacao = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(tabelaAvx2[mascara]));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(resultado + idx),
+                                _mm256_permutevar8x32_epi32(va, permutacao));
+            idx += _mm_popcnt_u32(mascara);
+
+            int maior1 = lista1[i1 + 7];
+            int maior2 = lista2[i2 + 7];
+            if (maior1 <= maior2) {
+                i1 += 8;
+                if (i1 + 8 > tam1) {
+                    if (maior1 == maior2) i2 += 8;
+                    break;
+                }
+                va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lista1 + i1));
+            }
+            if (maior2 <= maior1) {
+                i2 += 8;
+                if (i2 + 8 > tam2) {
+                    break;
+                }
+                vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lista2 + i2));
+            }
+        }
+    }
+
+    return idx + intersecaoDuasListasEscalar(lista1 + i1, tam1 - i1,
+                                             lista2 + i2, tam2 - i2,
+                                             resultado + idx);
+}
+
+KernelIntersecao detectarKernelIntersecao() {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) {
+        return KERNEL_AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt")) {
+        return KERNEL_SSE;
+    }
+    return KERNEL_ESCALAR;
+}
+
+#else
+
+int intersecaoDuasListasSse(const int* lista1, int tam1,
+                            const int* lista2, int tam2,
+                            int* resultado) {
+    return intersecaoDuasListasEscalar(lista1, tam1, lista2, tam2, resultado);
+}
+
+int intersecaoDuasListasAvx2(const int* lista1, int tam1,
+                             const int* lista2, int tam2,
+                             int* resultado) {
+    return intersecaoDuasListasEscalar(lista1, tam1, lista2, tam2, resultado);
+}
+
+KernelIntersecao detectarKernelIntersecao() {
+    return KERNEL_ESCALAR;
+}
+
+#endif
+
+// ============================================================================
+// Despacho em tempo de execução
+// ============================================================================
+
+typedef int (*FuncaoIntersecao)(const int*, int, const int*, int, int*);
+
+static FuncaoIntersecao funcaoParaKernel(KernelIntersecao kernel) {
+    switch (kernel) {
+        case KERNEL_AVX2:
+            return intersecaoDuasListasAvx2;
+        case KERNEL_SSE:
+            return intersecaoDuasListasSse;
+        default:
+            return intersecaoDuasListasEscalar;
+    }
+}
+
+static KernelIntersecao kernelAtivo = detectarKernelIntersecao();
+static FuncaoIntersecao funcaoAtiva = funcaoParaKernel(kernelAtivo);
+
+KernelIntersecao getKernelIntersecao() {
+    return kernelAtivo;
+}
+
+void setKernelIntersecao(KernelIntersecao kernel) {
+    kernelAtivo = kernel;
+    funcaoAtiva = funcaoParaKernel(kernel);
+}
+
+int intersecaoDuasListas(const int* lista1, int tam1,
+                         const int* lista2, int tam2,
+                         int* resultado) {
+    return funcaoAtiva(lista1, tam1, lista2, tam2, resultado);
+}
\ No newline at end of file
@@ -0,0 +1,204 @@
+#include "leitor_entrada.hpp"
+#include "utils.hpp"
+#include <cstring>
+#include <cerrno>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ============================================================================
+// Funções sobre VisaoTexto
+// ============================================================================
+
+static bool ehEspaco(char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+VisaoTexto aparar(VisaoTexto texto) {
+    const char* inicio = texto.dados;
+    const char* fim = texto.dados + texto.tamanho;
+    while (inicio < fim && ehEspaco(*inicio)) {
+        inicio++;
+    }
+    while (fim > inicio && ehEspaco(fim[-1])) {
+        fim--;
+    }
+    return VisaoTexto(inicio, static_cast<int>(fim - inicio));
+}
+
+bool proximoCampo(VisaoTexto& resto, char delim, VisaoTexto& campo) {
+    if (resto.dados == nullptr) {
+        return false;
+    }
+
+    const char* separador = static_cast<const char*>(std::memchr(resto.dados, delim, resto.tamanho));
+    if (separador == nullptr) {
+        campo = resto;
+        resto = VisaoTexto();
+        return true;
+    }
+
+    int tamanhoCampo = static_cast<int>(separador - resto.dados);
+    campo = VisaoTexto(resto.dados, tamanhoCampo);
+    resto = VisaoTexto(separador + 1, resto.tamanho - tamanhoCampo - 1);
+    return true;
+}
+
+int dividirCampos(VisaoTexto linha, char delim, VisaoTexto* campos, int maxCampos) {
+    int numCampos = 0;
+    VisaoTexto campo;
+    while (proximoCampo(linha, delim, campo)) {
+        if (numCampos < maxCampos) {
+            campos[numCampos] = campo;
+        }
+        numCampos++;
+    }
+    return numCampos;
+}
+
+bool interpretarEndereco(VisaoTexto linha, CamposEndereco& endereco,
+                         ContadoresCarga* contadores) {
+    linha = aparar(linha);
+    if (linha.vazia()) {
+        if (contadores != nullptr) {
+            contadores->linhasVazias++;
+        }
+        return false;
+    }
+
+    VisaoTexto campos[NUM_CAMPOS_ENDERECO];
+    if (dividirCampos(linha, ';', campos, NUM_CAMPOS_ENDERECO) != NUM_CAMPOS_ENDERECO) {
+        if (contadores != nullptr) {
+            contadores->camposIncorretos++;
+        }
+        return false;
+    }
+
+    endereco.idLog = aparar(campos[CAMPO_ID_LOGRADOURO]);
+    endereco.nome = aparar(campos[CAMPO_NOME_LOGRADOURO]);
+
+    VisaoTexto lat = aparar(campos[CAMPO_LATITUDE]);
+    VisaoTexto lon = aparar(campos[CAMPO_LONGITUDE]);
+    if (!converterInteiro(endereco.idLog.dados, endereco.idLog.tamanho, endereco.id) ||
+        !converterDouble(lat.dados, lat.tamanho, endereco.lat) ||
+        !converterDouble(lon.dados, lon.tamanho, endereco.lon)) {
+        if (contadores != nullptr) {
+            contadores->numerosInvalidos++;
+        }
+        return false;
+    }
+    return true;
+}
+
+bool contaComoEndereco(VisaoTexto linha) {
+    return dividirCampos(aparar(linha), ';', nullptr, 0) == NUM_CAMPOS_ENDERECO;
+}
+
+// ============================================================================
+// LeitorEntrada - Implementação
+// ============================================================================
+
+LeitorEntrada::LeitorEntrada(int descritor)
+    : descritor(descritor), mapeado(nullptr), tamanhoMapeado(0),
+      buffer(nullptr), capacidade(0), atual(nullptr), fim(nullptr), fimArquivo(false) {
+    // Arquivo regular: mapeia tudo e lê a partir da posição corrente
+    struct stat info;
+    off_t posicao = lseek(descritor, 0, SEEK_CUR);
+    if (fstat(descritor, &info) == 0 && S_ISREG(info.st_mode) && posicao >= 0 &&
+        info.st_size > posicao) {
+        void* base = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE,
+                          descritor, 0);
+        if (base != MAP_FAILED) {
+            madvise(base, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+            mapeado = static_cast<char*>(base);
+            tamanhoMapeado = static_cast<size_t>(info.st_size);
+            atual = mapeado + posicao;
+            fim = mapeado + tamanhoMapeado;
+            fimArquivo = true;
+            return;
+        }
+    }
+
+    capacidade = TAMANHO_BLOCO_LEITURA;
+    buffer = new char[capacidade];
+    atual = buffer;
+    fim = buffer;
+}
+
+LeitorEntrada::~LeitorEntrada() {
+    if (mapeado != nullptr) {
+        munmap(mapeado, tamanhoMapeado);
+    }
+    delete[] buffer;
+}
+
+bool LeitorEntrada::recarregar() {
+    if (fimArquivo) {
+        return false;
+    }
+
+    int pendente = static_cast<int>(fim - atual);
+    if (pendente == capacidade) {
+        // Linha maior que o buffer inteiro
+        char* maior = new char[capacidade * 2];
+        std::memcpy(maior, atual, pendente);
+        delete[] buffer;
+        buffer = maior;
+        capacidade *= 2;
+    } else if (pendente > 0) {
+        std::memmove(buffer, atual, pendente);
+    }
+    atual = buffer;
+    fim = buffer + pendente;
+
+    while (true) {
+        ssize_t lidos = read(descritor, buffer + pendente, capacidade - pendente);
+        if (lidos < 0 && errno == EINTR) {
+            continue;
+        }
+        if (lidos <= 0) {
+            fimArquivo = true;
+            return false;
+        }
+        fim += lidos;
+        return true;
+    }
+}
+
+bool LeitorEntrada::proximaLinha(VisaoTexto& linha) {
+    // 'jaProcurado' evita reprocurar o '\n' nos bytes já examinados
+    int jaProcurado = 0;
+    while (true) {
+        const char* inicioBusca = atual + jaProcurado;
+        const char* quebra = static_cast<const char*>(
+            std::memchr(inicioBusca, '\n', fim - inicioBusca));
+        if (quebra != nullptr) {
+            linha = VisaoTexto(atual, static_cast<int>(quebra - atual));
+            atual = quebra + 1;
+            return true;
+        }
+
+        jaProcurado = static_cast<int>(fim - atual);
+        if (!recarregar()) {
+            break;
+        }
+    }
+
+    // Última linha sem '\n'
+    if (atual < fim) {
+        linha = VisaoTexto(atual, static_cast<int>(fim - atual));
+        atual = fim;
+        return true;
+    }
+    return false;
+}
+
+bool LeitorEntrada::proximaLinhaNaoVazia(VisaoTexto& linha) {
+    while (proximaLinha(linha)) {
+        linha = aparar(linha);
+        if (!linha.vazia()) {
+            return true;
+        }
+    }
+    return false;
+}
\ No newline at end of file
@@ -5,173 +5,629 @@
 #include "utils.hpp"
 #include "dinamico_array.hpp"
 #include "mapa.hpp"
+#include "tabela_logradouros.hpp"
+#include "pool_trabalho.hpp"
+#include "snapshot.hpp"
+#include "leitor_entrada.hpp"
+#include "escritor_saida.hpp"
+#include "cache_consultas.hpp"
+#include "instrumentacao.hpp"
 #include <iostream>
-
-int main() {
-    int N, M, R;
-    
-    std::cin >> N;
-    std::cin.ignore();
-
-    // Mapa para armazenar logradouros únicos durante leitura
-    Mapa<std::string, Logradouro*> logradourosMap;
-    
-    // Índice invertido de palavras -> logradouros
-    Palavra* indiceAVL = new Palavra();
-
-    // ========================================================================
-    // FASE DE CONSTRUÇÃO: Leitura e construção dos TADs incrementalmente
-    // ========================================================================
-
-    for (int i = 0; i < N; i++) {
-        std::string linha;
-        std::getline(std::cin, linha);
-        linha = trim(linha);
-
-        if (linha.empty()) {
-            i--;
-            continue;
+#include <cstring>
+#include <cstdlib>
+#include <thread>
+#include <unistd.h>
+
+// Consultas por lote do pool: unidade de roubo de trabalho e de reordenação
+static const int TAMANHO_LOTE_CONSULTAS = 16;
+
+/**
+ * Consulta lida da entrada e, depois de executada, a posição dos seus
+ * resultados no buffer do lote
+ */
+struct ConsultaLida {
+    int idConsulta;
+    std::string texto;
+    double latOrigem;
+    double lonOrigem;
+    int inicioResultados;
+    int numResultados;
+
+    ConsultaLida()
+        : idConsulta(0), latOrigem(0.0), lonOrigem(0.0), inicioResultados(0), numResultados(0) {}
+};
+
+/**
+ * Dados compartilhados (somente leitura) pelas threads de consulta
+ */
+struct ContextoConsultas {
+    const Palavra* indice;
+    const TabelaLogradouros* tabela;
+    ConsultaLida* consultas;
+    int maxRespostas;
+    AreaTrabalhoConsulta* areas;    // Uma por trabalhador
+    DinamicoArray<Candidato>** resultadosPorLote;  // Com threads: um buffer por lote
+    CacheConsultas* cache;          // nullptr sem cache
+};
+
+/**
+ * Executa a consulta 'tarefa' com a área de trabalho 'area'
+ * Os resultados ficam na área e valem até a próxima consulta com ela.
+ */
+static const Candidato* consultar(ContextoConsultas* ctx, int tarefa,
+                                  AreaTrabalhoConsulta& area) {
+    ConsultaLida& lida = ctx->consultas[tarefa];
+
+    Consulta consulta(lida.idConsulta, lida.texto, lida.latOrigem, lida.lonOrigem,
+                      ctx->maxRespostas);
+    if (ctx->cache != nullptr) {
+        return ctx->cache->executar(consulta, ctx->indice, ctx->tabela,
+                                    lida.numResultados, area);
+    }
+    return consulta.executar(ctx->indice, ctx->tabela,
+                             lida.latOrigem, lida.lonOrigem,
+                             lida.numResultados, area);
+}
+
+/**
+ * Tarefa do pool: executa a consulta 'tarefa' com a área do trabalhador e
+ * copia os resultados para o buffer do lote, lido na impressão
+ * Cada lote é executado por um único trabalhador, em ordem.
+ */
+static void executarConsulta(int tarefa, int trabalhador, void* contexto) {
+    ContextoConsultas* ctx = static_cast<ContextoConsultas*>(contexto);
+    ConsultaLida& lida = ctx->consultas[tarefa];
+    const Candidato* resultados = consultar(ctx, tarefa, ctx->areas[trabalhador]);
+
+    DinamicoArray<Candidato>*& buffer = ctx->resultadosPorLote[tarefa / TAMANHO_LOTE_CONSULTAS];
+    if (buffer == nullptr) {
+        buffer = new DinamicoArray<Candidato>();
+    }
+    lida.inicioResultados = buffer->size();
+    for (int j = 0; j < lida.numResultados; j++) {
+        buffer->push_back(resultados[j]);
+    }
+}
+
+/**
+ * Escreve os resultados de uma consulta na saída
+ * Cada resultado é a linha "IdLog;nome\n" já pronta na tabela.
+ */
+static void imprimirConsulta(const ConsultaLida& lida, const Candidato* resultados,
+                             const TabelaLogradouros* tabela, EscritorSaida& saida) {
+    saida.escreverInteiro(lida.idConsulta);
+    saida.escreverCaractere(';');
+    saida.escreverInteiro(lida.numResultados);
+    saida.escreverCaractere('\n');
+
+    for (int j = 0; j < lida.numResultados; j++) {
+        int tamanho = 0;
+        const char* linha = tabela->getLinhaSaida(resultados[j].slot, tamanho);
+        saida.escrever(linha, tamanho);
+    }
+}
+
+/**
+ * Lê até 'maxValores' inteiros separados por espaços no início da linha
+ * Retorna quantos foram lidos
+ */
+static int lerInteiros(VisaoTexto linha, int* valores, int maxValores) {
+    const char* p = linha.dados;
+    const char* fim = linha.dados + linha.tamanho;
+    int lidos = 0;
+    while (lidos < maxValores) {
+        while (p < fim && (*p == ' ' || *p == '\t')) {
+            p++;
         }
-
-        int numCampos = 0;
-        std::string* campos = dividirString(linha, ';', numCampos);
-
-        if (numCampos != 10) {
-            delete[] campos;
-            i--;
-            continue;
+        const char* inicio = p;
+        if (p < fim && (*p == '-' || *p == '+')) {
+            p++;
         }
-
-        std::string idEnd = trim(campos[0]);
-        std::string idLog = trim(campos[1]);
-        std::string tipoLog = trim(campos[2]);
-        std::string log = trim(campos[3]);
-        
-        double lat = 0.0, lon = 0.0;
-        try {
-            lat = stringParaDouble(trim(campos[8]));
-            lon = stringParaDouble(trim(campos[9]));
-        } catch (...) {
-            delete[] campos;
-            i--;
-            continue;
+        const char* digitos = p;
+        while (p < fim && *p >= '0' && *p <= '9') {
+            p++;
+        }
+        if (p == digitos) {
+            break;
+        }
+        if (!converterInteiro(inicio, static_cast<int>(p - inicio), valores[lidos])) {
+            break;
         }
+        lidos++;
+    }
+    return lidos;
+}
+
+/**
+ * Lê 'quantidade' inteiros da entrada, que podem estar em linhas seguidas
+ * Os que faltarem no fim da entrada ficam 0.
+ */
+static void lerInteirosEntrada(LeitorEntrada& leitor, int* valores, int quantidade) {
+    int lidos = 0;
+    VisaoTexto linha;
+    while (lidos < quantidade && leitor.proximaLinhaNaoVazia(linha)) {
+        int naLinha = lerInteiros(linha, valores + lidos, quantidade - lidos);
+        if (naLinha == 0) {
+            break;
+        }
+        lidos += naLinha;
+    }
+    for (int i = lidos; i < quantidade; i++) {
+        valores[i] = 0;
+    }
+}
+
+/**
+ * Com um snapshot, a entrada pode começar direto em "M R" ou ser o arquivo
+ * completo; nesse caso, a seção de endereços (N e as N linhas) é pulada
+ */
+static void lerCabecalhoConsultas(LeitorEntrada& leitor, int& M, int& R) {
+    M = 0;
+    R = 0;
+    VisaoTexto linha;
+    if (!leitor.proximaLinhaNaoVazia(linha)) {
+        return;
+    }
 
-        Logradouro* log_ptr = logradourosMap.buscar(idLog) != nullptr ? 
-                              *logradourosMap.buscar(idLog) : nullptr;
+    int valores[2];
+    int lidos = lerInteiros(linha, valores, 2);
+    if (lidos == 0) {
+        return;
+    }
+    if (lidos == 2) {
+        M = valores[0];
+        R = valores[1];
+        return;
+    }
 
-        if (log_ptr == nullptr) {
-            Logradouro* novo = new Logradouro(idLog, log, lat, lon, 1);
-            logradourosMap.inserir(idLog, novo);
+    CamposEndereco endereco;
+    for (int i = 0; i < valores[0] && leitor.proximaLinha(linha); i++) {
+        if (!interpretarEndereco(linha, endereco) && !contaComoEndereco(linha)) {
+            i--;
+        }
+    }
+    lerInteirosEntrada(leitor, valores, 2);
+    M = valores[0];
+    R = valores[1];
+}
+
+/**
+ * Converte o valor de uma opção inteira não negativa (ex.: --cache N);
+ * retorna false, com a mensagem na saída de erro, se ele é inválido
+ */
+static bool lerOpcaoInteira(const char* opcao, const char* valor, int& destino) {
+    if (!converterInteiro(valor, static_cast<int>(std::strlen(valor)), destino) || destino < 0) {
+        std::cerr << "Valor invalido para " << opcao << ": " << valor << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Soma à instrumentação total a acumulada nas consultas de uma área de
+ * trabalho (sem INSTRUMENTACAO não há o que somar)
+ */
+static void acumularInstrumentacao(Instrumentacao& total, const AreaTrabalhoConsulta& area) {
+#ifdef INSTRUMENTACAO
+    total.acumular(area.instrumentacao);
+#else
+    (void)total;
+    (void)area;
+#endif
+}
+
+/**
+ * Escreve a instrumentação na saída de erro (caminho "-") ou em JSON no
+ * arquivo dado; retorna false se o arquivo não puder ser gravado
+ */
+static bool despejarInstrumentacao(const char* caminho, Instrumentacao& instrumentacao,
+                                   const ContadoresCarga& contadores) {
+    instrumentacao.contadores[CONTADOR_LINHAS_REJEITADAS] = contadores.getRejeitadas();
+    if (std::strcmp(caminho, "-") == 0) {
+        std::cerr << "Instrumentacao:" << std::endl;
+        instrumentacao.escreverTexto(std::cerr);
+        return true;
+    }
+    if (!instrumentacao.escreverJson(caminho)) {
+        std::cerr << "Nao foi possivel gravar a instrumentacao em " << caminho << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Libera o índice, a tabela e os logradouros construídos a partir da entrada
+ */
+static void liberarConstrucao(Palavra* indice, TabelaLogradouros* tabela,
+                              DinamicoArray<Logradouro*>& logradouros) {
+    delete indice;
+    delete tabela;
+    for (int i = 0; i < logradouros.size(); i++) {
+        delete logradouros[i];
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int N = 0, M = 0, R = 0;
+
+    // Opções de linha de comando
+    //   --dicionario avl|hash   estrutura do dicionário de termos (padrão: avl)
+    //   --threads N             threads de consulta (padrão: 1; 0 = todos os núcleos)
+    //   --build-snapshot ARQ    constrói o índice, grava o snapshot em ARQ e termina
+    //   --snapshot ARQ          carrega o índice do snapshot em vez de construí-lo
+    //   --cache N               cache de resultados com até N entradas (padrão: sem cache)
+    //   --cache-passo G         lado da grade de origens do cache, em graus (padrão: 0.001)
+    //   --cache-estrito         chave do cache com a origem exata
+    //   --cache-mb M            limite de memória do cache em MiB (padrão: 64)
+    //   --cache-intersecoes N   cache de até N interseções de combinações frequentes de termos
+    //   --cache-intersecoes-mb M  limite de memória desse cache em MiB (padrão: 128)
+    //   --instrumentacao ARQ    tempos por fase e contadores em JSON no arquivo ARQ
+    //                           ("-": texto na saída de erro); requer make INSTRUMENTACAO=1
+    BackendDicionario backendDicionario = DICIONARIO_AVL;
+    int numThreads = 1;
+    const char* caminhoGravacao = nullptr;
+    const char* caminhoSnapshot = nullptr;
+    int entradasCache = 0;
+    double passoCache = 0.001;
+    int megabytesCache = 64;
+    int entradasCacheIntersecoes = 0;
+    int megabytesCacheIntersecoes = 128;
+    const char* caminhoInstrumentacao = nullptr;
+    for (int a = 1; a < argc; a++) {
+        if (std::strcmp(argv[a], "--dicionario") == 0 && a + 1 < argc) {
+            a++;
+            if (std::strcmp(argv[a], "hash") == 0) {
+                backendDicionario = DICIONARIO_HASH;
+            } else if (std::strcmp(argv[a], "avl") == 0) {
+                backendDicionario = DICIONARIO_AVL;
+            } else {
+                std::cerr << "Dicionario desconhecido: " << argv[a] << std::endl;
+                return 1;
+            }
+        } else if (std::strcmp(argv[a], "--threads") == 0 && a + 1 < argc) {
+            a++;
+            char* fim = nullptr;
+            long valor = std::strtol(argv[a], &fim, 10);
+            if (fim == argv[a] || *fim != '\0' || valor < 0 || valor > 4096) {
+                std::cerr << "Numero de threads invalido: " << argv[a] << std::endl;
+                return 1;
+            }
+            numThreads = static_cast<int>(valor);
+            if (numThreads == 0) {
+                numThreads = static_cast<int>(std::thread::hardware_concurrency());
+                if (numThreads <= 0) {
+                    numThreads = 1;
+                }
+            }
+        } else if (std::strcmp(argv[a], "--build-snapshot") == 0 && a + 1 < argc) {
+            caminhoGravacao = argv[++a];
+        } else if (std::strcmp(argv[a], "--snapshot") == 0 && a + 1 < argc) {
+            caminhoSnapshot = argv[++a];
+        } else if (std::strcmp(argv[a], "--cache") == 0 && a + 1 < argc) {
+            if (!lerOpcaoInteira(argv[a], argv[a + 1], entradasCache)) {
+                return 1;
+            }
+            a++;
+        } else if (std::strcmp(argv[a], "--cache-mb") == 0 && a + 1 < argc) {
+            if (!lerOpcaoInteira(argv[a], argv[a + 1], megabytesCache)) {
+                return 1;
+            }
+            a++;
+        } else if (std::strcmp(argv[a], "--cache-passo") == 0 && a + 1 < argc) {
+            a++;
+            if (!converterDouble(argv[a], static_cast<int>(std::strlen(argv[a])), passoCache) ||
+                !(passoCache > 0.0)) {
+                std::cerr << "Passo de cache invalido: " << argv[a] << std::endl;
+                return 1;
+            }
+        } else if (std::strcmp(argv[a], "--cache-estrito") == 0) {
+            passoCache = 0.0;
+        } else if (std::strcmp(argv[a], "--cache-intersecoes") == 0 && a + 1 < argc) {
+            if (!lerOpcaoInteira(argv[a], argv[a + 1], entradasCacheIntersecoes)) {
+                return 1;
+            }
+            a++;
+        } else if (std::strcmp(argv[a], "--cache-intersecoes-mb") == 0 && a + 1 < argc) {
+            if (!lerOpcaoInteira(argv[a], argv[a + 1], megabytesCacheIntersecoes)) {
+                return 1;
+            }
+            a++;
+        } else if (std::strcmp(argv[a], "--instrumentacao") == 0 && a + 1 < argc) {
+            caminhoInstrumentacao = argv[++a];
+            if (!INSTRUMENTACAO_ATIVA) {
+                std::cerr << "--instrumentacao requer compilar com make INSTRUMENTACAO=1" << std::endl;
+                return 1;
+            }
         } else {
-            log_ptr->atualizarMedias(lat, lon);
+            std::cerr << "Uso: " << argv[0]
+                      << " [--dicionario avl|hash] [--threads N]"
+                      << " [--build-snapshot ARQ | --snapshot ARQ]"
+                      << " [--cache N [--cache-passo G | --cache-estrito] [--cache-mb M]]"
+                      << " [--cache-intersecoes N [--cache-intersecoes-mb M]]"
+                      << " [--instrumentacao ARQ|-]"
+                      << " < entrada" << std::endl;
+            return 1;
         }
+    }
+    if (caminhoGravacao != nullptr && caminhoSnapshot != nullptr) {
+        std::cerr << "--build-snapshot e --snapshot sao exclusivos" << std::endl;
+        return 1;
+    }
 
-        int numPalavras = 0;
-        std::string* palavras = dividirString(log, ' ', numPalavras);
+    // Índice e tabela usados pelas consultas: construídos agora ou mapeados do snapshot
+    const Palavra* indice = nullptr;
+    const TabelaLogradouros* tabela = nullptr;
+    Palavra* indiceAVL = nullptr;
+    TabelaLogradouros* tabelaLogradouros = nullptr;
+    DinamicoArray<Logradouro*> logradourosArray;
+    Snapshot snapshot;
+    LeitorEntrada leitor(STDIN_FILENO);
+    ContadoresCarga contadores;
+    Instrumentacao instrumentacao;      // Construção e soma das consultas de todas as threads
+
+    if (caminhoSnapshot != nullptr) {
+        std::string erro;
+        if (!snapshot.abrir(caminhoSnapshot, erro)) {
+            std::cerr << "Snapshot " << caminhoSnapshot << ": " << erro << std::endl;
+            return 1;
+        }
+        indice = snapshot.getIndice();
+        tabela = snapshot.getTabela();
+        lerCabecalhoConsultas(leitor, M, R);
+    } else {
+        INSTR_ESCOPO(&instrumentacao);
+        lerInteirosEntrada(leitor, &N, 1);
+
+        // Mapa para armazenar logradouros únicos durante leitura
+        Mapa<std::string, Logradouro*> logradourosMap;
+
+        // Índice invertido de palavras -> logradouros
+        // Construído em lote: os pares (termo, IdLog) são coletados na leitura
+        // e ordenados de uma só vez ao congelar o índice
+        indiceAVL = new Palavra(CONSTRUCAO_EM_LOTE, backendDicionario);
+
+        // ====================================================================
+        // FASE DE CONSTRUÇÃO: Leitura e construção dos TADs incrementalmente
+        // ====================================================================
+
+        // Os campos são visões das linhas do leitor: só o IdLog (chave do
+        // mapa) e o nome de logradouros novos são copiados
+        VisaoTexto linha;
+        CamposEndereco endereco;
+        std::string chave;
+        for (int i = 0; i < N; i++) {
+            INSTR_INICIO_FASE(inicioLeitura);
+            if (!leitor.proximaLinha(linha)) {
+                break;
+            }
 
-        if (palavras != nullptr) {
-            for (int j = 0; j < numPalavras; j++) {
-                std::string palavra = trim(palavras[j]);
-                if (!palavra.empty()) {
-                    try {
-                        int idLogInt = stringParaInt(idLog);
-                        indiceAVL->adicionarLogradouro(palavra, idLogInt);
-                    } catch (...) {
-                    }
+            bool valida = interpretarEndereco(linha, endereco, &contadores);
+            INSTR_FIM_FASE(FASE_LEITURA, inicioLeitura);
+            if (!valida) {
+                // A de 10 campos com números inválidos é uma das N (senão o
+                // cabeçalho "M R" seria lido como endereço); as demais não
+                if (!contaComoEndereco(linha)) {
+                    i--;
+                }
+                continue;
+            }
+            INSTR_CONTAR(CONTADOR_LINHAS_LIDAS, 1);
+
+            INSTR_INICIO_FASE(inicioAgregacao);
+            chave.assign(endereco.idLog.dados, endereco.idLog.tamanho);
+            bool novo = false;
+            Logradouro*& logradouro = logradourosMap.obterOuInserir(chave, novo);
+
+            if (novo) {
+                logradouro = new Logradouro(chave, endereco.nome.paraString(),
+                                            endereco.lat, endereco.lon, 1);
+            } else {
+                logradouro->atualizarMedias(endereco.lat, endereco.lon);
+            }
+            INSTR_FIM_FASE(FASE_AGREGACAO, inicioAgregacao);
+
+            INSTR_INICIO_FASE(inicioIndexacao);
+            VisaoTexto resto = endereco.nome;
+            VisaoTexto palavra;
+            while (proximoCampo(resto, ' ', palavra)) {
+                palavra = aparar(palavra);
+                if (!palavra.vazia()) {
+                    indiceAVL->adicionarLogradouro(palavra.dados, palavra.tamanho, endereco.id);
                 }
             }
-            delete[] palavras;
+            INSTR_FIM_FASE(FASE_INDEXACAO, inicioIndexacao);
         }
 
-        delete[] campos;
-    }
+        if (caminhoGravacao == nullptr) {
+            int valores[2];
+            lerInteirosEntrada(leitor, valores, 2);
+            M = valores[0];
+            R = valores[1];
+        }
 
-    std::cin >> M >> R;
-    std::cin.ignore();
+        // Converte mapa de logradouros para array, percorrendo-o em ordem
+        INSTR_INICIO_FASE(inicioCongelamento);
+        logradourosArray.reserve(logradourosMap.tamanho());
+        for (Mapa<std::string, Logradouro*>::Iterador it = logradourosMap.iterar();
+             it.valido(); it.avancar()) {
+            logradourosArray.push_back(it.valor());
+        }
 
-    // Converte mapa de logradouros para array e coleta pares
-    int numLogradouros = 0;
-    ParChaveValor<std::string, Logradouro*>* pares = logradourosMap.coletarTodos(numLogradouros);
+        // Tabela densa IdLog -> logradouro, construída uma única vez
+        tabelaLogradouros = new TabelaLogradouros(logradourosArray.data(), logradourosArray.size());
 
-    DinamicoArray<Logradouro*> logradourosArray;
-    for (int i = 0; i < numLogradouros; i++) {
-        logradourosArray.push_back(pares[i].valor);
+        // Congela o índice em formato CSR sobre os slots da tabela
+        indiceAVL->congelar(tabelaLogradouros);
+        INSTR_FIM_FASE(FASE_CONGELAMENTO, inicioCongelamento);
+
+        indice = indiceAVL;
+        tabela = tabelaLogradouros;
     }
 
-    if (pares != nullptr) {
-        delete[] pares;
+    // Só gravação do snapshot: nenhuma consulta é lida
+    if (caminhoGravacao != nullptr) {
+        std::string erro;
+        bool gravado = gravarSnapshot(caminhoGravacao, indice, tabela, erro);
+        if (!gravado) {
+            std::cerr << "Snapshot " << caminhoGravacao << ": " << erro << std::endl;
+        }
+        if (caminhoInstrumentacao != nullptr &&
+            !despejarInstrumentacao(caminhoInstrumentacao, instrumentacao, contadores)) {
+            gravado = false;
+        }
+        liberarConstrucao(indiceAVL, tabelaLogradouros, logradourosArray);
+        return gravado ? 0 : 1;
     }
 
     // ========================================================================
     // FASE DE CONSULTAS: Processa as M consultas
     // ========================================================================
 
-    std::cout << M << std::endl;
-    for (int i = 0; i < M; i++) {
-        std::string linha;
-        std::getline(std::cin, linha);
-        linha = trim(linha);
-
-        if (linha.empty()) {
-            i--;
+    // As consultas são lidas antes de executar: a execução pode ser paralela,
+    // mas a saída segue sempre a ordem de entrada
+    ConsultaLida* consultas = new ConsultaLida[M > 0 ? M : 1];
+    int numConsultas = 0;
+
+    // Toda a saída passa por um buffer único, escrito em blocos grandes
+    EscritorSaida saida(STDOUT_FILENO);
+    saida.escreverInteiro(M);
+    saida.escreverCaractere('\n');
+    VisaoTexto linha;
+    VisaoTexto campos[4];
+    while (numConsultas < M && leitor.proximaLinhaNaoVazia(linha)) {
+        if (dividirCampos(linha, ';', campos, 4) != 4) {
+            contadores.camposIncorretos++;
+            contadores.consultasRejeitadas++;
             continue;
         }
 
-        int numCampos = 0;
-        std::string* campos = dividirString(linha, ';', numCampos);
-
-        if (numCampos != 4) {
-            delete[] campos;
-            i--;
+        ConsultaLida& lida = consultas[numConsultas];
+        VisaoTexto id = aparar(campos[0]);
+        VisaoTexto lat = aparar(campos[2]);
+        VisaoTexto lon = aparar(campos[3]);
+        if (!converterInteiro(id.dados, id.tamanho, lida.idConsulta) ||
+            !converterDouble(lat.dados, lat.tamanho, lida.latOrigem) ||
+            !converterDouble(lon.dados, lon.tamanho, lida.lonOrigem)) {
+            contadores.numerosInvalidos++;
+            contadores.consultasRejeitadas++;
             continue;
         }
+        lida.texto = aparar(campos[1]).paraString();
+        numConsultas++;
+    }
 
-        int idConsulta = 0;
-        double latOrigem = 0.0, lonOrigem = 0.0;
+    // Linhas descartadas são informadas na saída de erro, sem alterar a saída
+    if (contadores.getRejeitadas() > 0) {
+        std::cerr << "Linhas descartadas: " << contadores.getRejeitadas()
+                  << " (campos incorretos: " << contadores.camposIncorretos
+                  << ", numeros invalidos: " << contadores.numerosInvalidos
+                  << ", consultas: " << contadores.consultasRejeitadas << ")" << std::endl;
+    }
 
-        try {
-            idConsulta = stringParaInt(trim(campos[0]));
-            latOrigem = stringParaDouble(trim(campos[2]));
-            lonOrigem = stringParaDouble(trim(campos[3]));
-        } catch (...) {
-            delete[] campos;
-            i--;
-            continue;
+    ContextoConsultas contexto;
+    contexto.indice = indice;
+    contexto.tabela = tabela;
+    contexto.consultas = consultas;
+    contexto.maxRespostas = R;
+    contexto.resultadosPorLote = nullptr;
+    contexto.cache = entradasCache > 0
+                         ? new CacheConsultas(entradasCache, static_cast<long long>(megabytesCache) << 20,
+                                              passoCache)
+                         : nullptr;
+    CacheIntersecoes* cacheIntersecoes =
+        entradasCacheIntersecoes > 0
+            ? new CacheIntersecoes(entradasCacheIntersecoes,
+                                   static_cast<long long>(megabytesCacheIntersecoes) << 20)
+            : nullptr;
+
+    if (numThreads <= 1) {
+        // Buffers reaproveitados por todas as consultas
+        AreaTrabalhoConsulta areaTrabalho;
+        areaTrabalho.cacheIntersecoes = cacheIntersecoes;
+        contexto.areas = &areaTrabalho;
+        // Cada consulta é impressa direto da área, antes da próxima
+        for (int i = 0; i < numConsultas; i++) {
+            const Candidato* resultados = consultar(&contexto, i, areaTrabalho);
+            imprimirConsulta(consultas[i], resultados, tabela, saida);
         }
-
-        std::string consultaTexto = trim(campos[1]);
-
-        Consulta consulta(idConsulta, consultaTexto, latOrigem, lonOrigem, R);
-
-        int numResultados = 0;
-        Candidato* resultados = consulta.executar(indiceAVL, 
-                                                  logradourosArray.data(), 
-                                                  logradourosArray.size(), 
-                                                  latOrigem, lonOrigem,
-                                                  numResultados);
-
-        std::cout << idConsulta << ";" << numResultados << std::endl;
-
-        if (resultados != nullptr) {
-            for (int j = 0; j < numResultados; j++) {
-                std::cout << resultados[j].idLog << ";" << resultados[j].nome << std::endl;
+        acumularInstrumentacao(instrumentacao, areaTrabalho);
+    } else {
+        // Uma área de trabalho por thread; o índice e a tabela são só lidos
+        contexto.areas = new AreaTrabalhoConsulta[numThreads];
+        for (int t = 0; t < numThreads; t++) {
+            contexto.areas[t].cacheIntersecoes = cacheIntersecoes;
+        }
+        PoolTrabalho pool(numThreads);
+        int numLotes = (numConsultas + TAMANHO_LOTE_CONSULTAS - 1) / TAMANHO_LOTE_CONSULTAS;
+        contexto.resultadosPorLote = new DinamicoArray<Candidato>*[numLotes > 0 ? numLotes : 1];
+        for (int lote = 0; lote < numLotes; lote++) {
+            contexto.resultadosPorLote[lote] = nullptr;
+        }
+        pool.iniciar(numConsultas, TAMANHO_LOTE_CONSULTAS, executarConsulta, &contexto);
+
+        // Buffer de reordenação: imprime os lotes na ordem de entrada, à
+        // medida que ficam prontos
+        for (int lote = 0; lote < pool.getNumLotes(); lote++) {
+            pool.aguardarLote(lote);
+            int inicio = lote * TAMANHO_LOTE_CONSULTAS;
+            int fim = inicio + TAMANHO_LOTE_CONSULTAS < numConsultas ? inicio + TAMANHO_LOTE_CONSULTAS
+                                                                     : numConsultas;
+            DinamicoArray<Candidato>* buffer = contexto.resultadosPorLote[lote];
+            for (int i = inicio; i < fim; i++) {
+                imprimirConsulta(consultas[i], buffer->data() + consultas[i].inicioResultados,
+                                 tabela, saida);
             }
-            delete[] resultados;
+            delete buffer;
+            contexto.resultadosPorLote[lote] = nullptr;
+        }
+        pool.aguardarTodos();
+        for (int t = 0; t < numThreads; t++) {
+            acumularInstrumentacao(instrumentacao, contexto.areas[t]);
         }
+        delete[] contexto.resultadosPorLote;
+        delete[] contexto.areas;
+    }
+
+    delete[] consultas;
+
+    if (contexto.cache != nullptr) {
+        EstatisticasCache estatisticas = contexto.cache->getEstatisticas();
+        std::cerr << "Cache: acertos=" << estatisticas.acertos
+                  << " faltas=" << estatisticas.faltas
+                  << " recusas=" << estatisticas.recusas
+                  << " remocoes=" << estatisticas.remocoes
+                  << " entradas=" << contexto.cache->getNumEntradas()
+                  << " bytes=" << contexto.cache->getBytesUsados() << std::endl;
+        delete contexto.cache;
+    }
 
-        delete[] campos;
+    if (cacheIntersecoes != nullptr) {
+        EstatisticasCacheIntersecoes estatisticas = cacheIntersecoes->getEstatisticas();
+        std::cerr << "Cache de intersecoes: acertos=" << estatisticas.acertos
+                  << " reaproveitamentos=" << estatisticas.reaproveitamentos
+                  << " faltas=" << estatisticas.faltas
+                  << " admissoes=" << estatisticas.admissoes
+                  << " remocoes=" << estatisticas.remocoes
+                  << " entradas=" << cacheIntersecoes->getNumEntradas()
+                  << " bytes=" << cacheIntersecoes->getBytesUsados() << std::endl;
+        delete cacheIntersecoes;
+    }
+
+    int codigoSaida = 0;
+    if (!saida.descarregar()) {
+        std::cerr << "Erro ao escrever a saida" << std::endl;
+        codigoSaida = 1;
+    }
+    if (caminhoInstrumentacao != nullptr &&
+        !despejarInstrumentacao(caminhoInstrumentacao, instrumentacao, contadores)) {
+        codigoSaida = 1;
     }
 
     // ========================================================================
     // Liberação de memória
     // ========================================================================
 
-    delete indiceAVL;
-
-    for (int i = 0; i < logradourosArray.size(); i++) {
-        delete logradourosArray[i];
-    }
+    liberarConstrucao(indiceAVL, tabelaLogradouros, logradourosArray);
 
-    return 0;
+    return codigoSaida;
 }
\ No newline at end of file
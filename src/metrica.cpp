@@ -0,0 +1,48 @@
+#include "metrica.hpp"
+#include "utils.hpp"
+#include <cmath>
+
+double MetricaEuclidiana::distancia(double lat1, double lon1, double lat2, double lon2) {
+    return calcularDistancia(lat1, lon1, lat2, lon2);
+}
+
+void MetricaGeodesica::vetorUnitario(double lat, double lon, double* vetor) {
+    double phi = lat * GRAUS_PARA_RADIANOS;
+    double lambda = lon * GRAUS_PARA_RADIANOS;
+    double cosPhi = std::cos(phi);
+    vetor[0] = cosPhi * std::cos(lambda);
+    vetor[1] = cosPhi * std::sin(lambda);
+    vetor[2] = std::sin(phi);
+}
+
+double MetricaGeodesica::distancia(double lat1, double lon1, double lat2, double lon2) {
+    double u[3];
+    double v[3];
+    vetorUnitario(lat1, lon1, u);
+    vetorUnitario(lat2, lon2, v);
+    // Mesma conta dos kernels de distância: ((dx² + dy²) + dz²)
+    double dx = v[0] - u[0];
+    double dy = v[1] - u[1];
+    double dz = v[2] - u[2];
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+double MetricaGeodesica::cordaDoAngulo(double graus) {
+    if (!(graus > 0.0)) {
+        return 0.0;
+    }
+    if (graus > 180.0) {
+        graus = 180.0;
+    }
+    return 2.0 * std::sin(0.5 * graus * GRAUS_PARA_RADIANOS);
+}
+
+OrigemMetrica::OrigemMetrica(double lat, double lon) : lat(lat), lon(lon) {
+    if (Metrica::GEODESICA) {
+        MetricaGeodesica::vetorUnitario(lat, lon, vetor);
+    } else {
+        vetor[0] = 0.0;
+        vetor[1] = 0.0;
+        vetor[2] = 0.0;
+    }
+}
\ No newline at end of file
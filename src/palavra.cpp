@@ -4,11 +4,13 @@
 // ListaInteiros - Implementação
 // ============================================================================
 
-ListaInteiros::ListaInteiros() : inicio(nullptr), tamanho(0) {
+ListaInteiros::ListaInteiros(ArenaTipada<NodoListaInt>* arena)
+    : inicio(nullptr), tamanho(0), arena(arena) {
 }
 
 ListaInteiros::~ListaInteiros() {
-    NodoListaInt* atual = inicio;
+    // Nós da arena são liberados por ela
+    NodoListaInt* atual = arena == nullptr ? inicio : nullptr;
     while (atual != nullptr) {
         NodoListaInt* temp = atual;
         atual = atual->prox;
@@ -18,6 +20,13 @@ ListaInteiros::~ListaInteiros() {
     tamanho = 0;
 }
 
+NodoListaInt* ListaInteiros::novoNodo(int valor) {
+    if (arena != nullptr) {
+        return arena->criar(valor);
+    }
+    return new NodoListaInt(valor);
+}
+
 void ListaInteiros::inserir(int valor) {
     // Evita duplicatas
     if (contem(valor)) {
@@ -26,7 +35,7 @@ void ListaInteiros::inserir(int valor) {
 
     // Se lista vazia ou valor é menor que o primeiro
     if (inicio == nullptr || valor < inicio->valor) {
-        NodoListaInt* novo = new NodoListaInt(valor);
+        NodoListaInt* novo = novoNodo(valor);
         novo->prox = inicio;
         inicio = novo;
         tamanho++;
@@ -39,7 +48,7 @@ void ListaInteiros::inserir(int valor) {
         atual = atual->prox;
     }
 
-    NodoListaInt* novo = new NodoListaInt(valor);
+    NodoListaInt* novo = novoNodo(valor);
     novo->prox = atual->prox;
     atual->prox = novo;
     tamanho++;
@@ -83,12 +92,50 @@ int* ListaInteiros::toArray() const {
 // Palavra (Árvore AVL) - Implementação
 // ============================================================================
 
-Palavra::Palavra() : raiz(nullptr), numPalavras(0) {
+Palavra::Palavra(ModoConstrucao modo, BackendDicionario backend)
+    : raiz(nullptr), numPalavras(0), modo(modo), backend(backend), dicionarioHash(nullptr),
+      pares(nullptr),
+      blocos(nullptr), inicioBlocos(nullptr), contagens(nullptr), dados(nullptr),
+      numDados(0),
+      containers(nullptr), inicioContainers(nullptr), bitmaps(nullptr), numPalavrasBitmap(0),
+      valores(nullptr), numValores(0), congelado(false), donoDosPostings(true) {
+    if (modo == CONSTRUCAO_EM_LOTE) {
+        pares = new DinamicoArray<ParTermoLogradouro>();
+    }
+    if (backend == DICIONARIO_HASH) {
+        dicionarioHash = new DicionarioHash();
+    }
+}
+
+Palavra::Palavra(const DadosPostings& dadosExternos, DicionarioHash* dicionario)
+    : raiz(nullptr), numPalavras(dadosExternos.numPalavras),
+      modo(CONSTRUCAO_EM_LOTE), backend(DICIONARIO_HASH), dicionarioHash(dicionario),
+      pares(nullptr),
+      blocos(dadosExternos.blocos), inicioBlocos(dadosExternos.inicioBlocos),
+      contagens(dadosExternos.contagens), dados(dadosExternos.dados),
+      numDados(dadosExternos.numDados),
+      containers(dadosExternos.containers), inicioContainers(dadosExternos.inicioContainers),
+      bitmaps(dadosExternos.bitmaps), numPalavrasBitmap(dadosExternos.numPalavrasBitmap),
+      valores(dadosExternos.valores), numValores(dadosExternos.numValores),
+      congelado(true), donoDosPostings(false) {
 }
 
 Palavra::~Palavra() {
-    desalocarRec(raiz);
+    // Nós da AVL e listas do modo incremental são liberados pelas arenas
     raiz = nullptr;
+    delete dicionarioHash;
+    delete pares;
+    if (!donoDosPostings) {
+        return;
+    }
+    delete[] blocos;
+    delete[] inicioBlocos;
+    delete[] contagens;
+    delete[] dados;
+    delete[] containers;
+    delete[] inicioContainers;
+    delete[] bitmaps;
+    delete[] valores;
 }
 
 int Palavra::altura(NodoAVL* nodo) const {
@@ -143,8 +190,7 @@ NodoAVL* Palavra::rotacaoDireitaEsquerda(NodoAVL* nodo) {
 
 NodoAVL* Palavra::inserirRec(NodoAVL* nodo, const std::string& palavra) {
     if (nodo == nullptr) {
-        numPalavras++;
-        return new NodoAVL(palavra);
+        return arenaNodos.criar(palavra, numPalavras++);
     }
 
     if (palavra < nodo->palavra) {
@@ -198,32 +244,62 @@ NodoAVL* Palavra::buscarRec(NodoAVL* nodo, const std::string& palavra) const {
     }
 }
 
-void Palavra::desalocarRec(NodoAVL* nodo) {
+int Palavra::obterIdTermo(const std::string& palavra) {
+    if (backend == DICIONARIO_HASH) {
+        int id = dicionarioHash->obterOuInserir(palavra);
+        numPalavras = dicionarioHash->getNumTermos();
+        return id;
+    }
+
+    NodoAVL* nodo = buscarRec(raiz, palavra);
     if (nodo == nullptr) {
-        return;
+        // Palavra não existe, inserir e recuperar o novo nodo
+        raiz = inserirRec(raiz, palavra);
+        nodo = buscarRec(raiz, palavra);
     }
-    desalocarRec(nodo->esq);
-    desalocarRec(nodo->dir);
-    delete nodo;
+    return nodo->idTermo;
 }
 
-ListaInteiros* Palavra::obterPalavra(const std::string& palavra) {
+int Palavra::obterIdTermo(const char* palavra, int tamanho) {
+    if (backend == DICIONARIO_HASH) {
+        int id = dicionarioHash->obterOuInserir(palavra, tamanho);
+        numPalavras = dicionarioHash->getNumTermos();
+        return id;
+    }
+    return obterIdTermo(std::string(palavra, tamanho));
+}
+
+int Palavra::buscarIdTermo(const std::string& palavra) const {
+    if (backend == DICIONARIO_HASH) {
+        return dicionarioHash->buscar(palavra);
+    }
+
     NodoAVL* nodo = buscarRec(raiz, palavra);
-    
-    if (nodo != nullptr) {
-        return nodo->logradouros;
+    return nodo != nullptr ? nodo->idTermo : -1;
+}
+
+ListaInteiros* Palavra::obterPalavra(const std::string& palavra) {
+    // Índice montado sobre memória externa: o dicionário é somente leitura
+    if (!donoDosPostings) {
+        return nullptr;
     }
 
-    // Palavra não existe, inserir e retornar
-    raiz = inserirRec(raiz, palavra);
-    nodo = buscarRec(raiz, palavra);
-    return nodo->logradouros;
+    int id = obterIdTermo(palavra);
+
+    // A lista só é criada no primeiro uso (o modo em lote não a utiliza)
+    if (listas.size() <= id) {
+        listas.resize(id + 1);
+    }
+    if (listas[id] == nullptr) {
+        listas[id] = arenaListas.criar(&arenaPostings);
+    }
+    return listas[id];
 }
 
 ListaInteiros* Palavra::buscar(const std::string& palavra) const {
-    NodoAVL* nodo = buscarRec(raiz, palavra);
-    if (nodo != nullptr) {
-        return nodo->logradouros;
+    int id = buscarIdTermo(palavra);
+    if (id >= 0 && id < listas.size()) {
+        return listas[id];
     }
     return nullptr;
 }
@@ -233,8 +309,559 @@ int Palavra::getNumPalavras() const {
 }
 
 void Palavra::adicionarLogradouro(const std::string& palavra, int idLog) {
+    if (congelado) {
+        return;
+    }
+
+    if (modo == CONSTRUCAO_EM_LOTE) {
+        pares->push_back(ParTermoLogradouro(obterIdTermo(palavra), idLog));
+        return;
+    }
+
     ListaInteiros* lista = obterPalavra(palavra);
     if (lista != nullptr) {
         lista->inserir(idLog);
     }
+}
+
+void Palavra::adicionarLogradouro(const char* palavra, int tamanho, int idLog) {
+    if (congelado) {
+        return;
+    }
+
+    if (modo == CONSTRUCAO_EM_LOTE) {
+        pares->push_back(ParTermoLogradouro(obterIdTermo(palavra, tamanho), idLog));
+        return;
+    }
+
+    adicionarLogradouro(std::string(palavra, tamanho), idLog);
+}
+
+/**
+ * Uma passada estável de radix sort (LSD) pelo campo idLog, considerando
+ * os bits [deslocamento, deslocamento + BITS_DIGITO)
+ */
+static const int BITS_DIGITO = 11;
+static const int BALDES_DIGITO = 1 << BITS_DIGITO;
+
+static void passadaRadix(const ParTermoLogradouro* origem, ParTermoLogradouro* destino,
+                         int n, int deslocamento, int* contagem) {
+    for (int b = 0; b < BALDES_DIGITO; b++) {
+        contagem[b] = 0;
+    }
+    for (int i = 0; i < n; i++) {
+        contagem[(origem[i].idLog >> deslocamento) & (BALDES_DIGITO - 1)]++;
+    }
+    int soma = 0;
+    for (int b = 0; b < BALDES_DIGITO; b++) {
+        int c = contagem[b];
+        contagem[b] = soma;
+        soma += c;
+    }
+    for (int i = 0; i < n; i++) {
+        destino[contagem[(origem[i].idLog >> deslocamento) & (BALDES_DIGITO - 1)]++] = origem[i];
+    }
+}
+
+void Palavra::congelar(const TabelaLogradouros* tabela) {
+    if (congelado) {
+        return;
+    }
+
+    DinamicoArray<ParTermoLogradouro>* entrada = pares;
+    if (entrada == nullptr) {
+        // Modo incremental: os pares vêm das listas de cada termo
+        entrada = new DinamicoArray<ParTermoLogradouro>();
+        int totalPares = 0;
+        for (int t = 0; t < listas.size(); t++) {
+            totalPares += listas[t] != nullptr ? listas[t]->getTamanho() : 0;
+        }
+        entrada->reserve(totalPares);
+        for (int t = 0; t < listas.size(); t++) {
+            NodoListaInt* atual = listas[t] != nullptr ? listas[t]->getInicio() : nullptr;
+            while (atual != nullptr) {
+                entrada->push_back(ParTermoLogradouro(t, atual->valor));
+                atual = atual->prox;
+            }
+        }
+    }
+
+    // Converte IdLog -> slot, descartando logradouros ausentes da tabela
+    // (daqui em diante o campo idLog dos pares guarda o slot)
+    int n = 0;
+    int numSlots = tabela != nullptr ? tabela->getTamanho() : 0;
+    ParTermoLogradouro* a = new ParTermoLogradouro[entrada->size() > 0 ? entrada->size() : 1];
+    for (int i = 0; i < entrada->size(); i++) {
+        int slot = tabela != nullptr ? tabela->buscarSlot((*entrada)[i].idLog) : -1;
+        if (slot >= 0) {
+            a[n++] = ParTermoLogradouro((*entrada)[i].idTermo, slot);
+        }
+    }
+    delete entrada;
+    pares = nullptr;
+
+    // Radix sort LSD pelo slot: uma passada por dígito de 11 bits
+    ParTermoLogradouro* b = new ParTermoLogradouro[n > 0 ? n : 1];
+    int* contagem = new int[BALDES_DIGITO];
+    int bitsSlot = 0;
+    while (bitsSlot < 31 && ((numSlots - 1) >> bitsSlot) > 0) {
+        bitsSlot++;
+    }
+    for (int deslocamento = 0; deslocamento < bitsSlot; deslocamento += BITS_DIGITO) {
+        passadaRadix(a, b, n, deslocamento, contagem);
+        ParTermoLogradouro* temp = a;
+        a = b;
+        b = temp;
+    }
+    delete[] contagem;
+    delete[] b;
+
+    // Ordenação estável por termo (counting sort), que já produz os offsets CSR
+    int* offsets = new int[numPalavras + 1];
+    for (int t = 0; t <= numPalavras; t++) {
+        offsets[t] = 0;
+    }
+    for (int i = 0; i < n; i++) {
+        offsets[a[i].idTermo + 1]++;
+    }
+    for (int t = 0; t < numPalavras; t++) {
+        offsets[t + 1] += offsets[t];
+    }
+
+    int* posicao = new int[numPalavras > 0 ? numPalavras : 1];
+    for (int t = 0; t < numPalavras; t++) {
+        posicao[t] = offsets[t];
+    }
+    int* postings = new int[n > 0 ? n : 1];
+    for (int i = 0; i < n; i++) {
+        postings[posicao[a[i].idTermo]++] = a[i].idLog;
+    }
+    delete[] posicao;
+    delete[] a;
+
+    // Remove duplicatas (adjacentes dentro de cada termo), compactando o array
+    int escrita = 0;
+    int inicioTermo = 0;
+    for (int t = 0; t < numPalavras; t++) {
+        int fimTermo = offsets[t + 1];
+        offsets[t] = escrita;
+        for (int i = inicioTermo; i < fimTermo; i++) {
+            if (escrita == offsets[t] || postings[i] != postings[escrita - 1]) {
+                postings[escrita++] = postings[i];
+            }
+        }
+        inicioTermo = fimTermo;
+    }
+    offsets[numPalavras] = escrita;
+
+    comprimirPostings(offsets, postings, numSlots);
+    delete[] offsets;
+    delete[] postings;
+
+    congelado = true;
+}
+
+/**
+ * Número de bits necessários para representar v
+ */
+static int larguraBits(uint32_t v) {
+    int bits = 0;
+    while (v != 0) {
+        bits++;
+        v >>= 1;
+    }
+    return bits;
+}
+
+/**
+ * Largura em bits do maior delta (slot[j] - slot[j-1] - 1) em slots[inicio .. fim)
+ */
+static int larguraBitsBloco(const int* slots, int inicio, int fim) {
+    uint32_t maiorDelta = 0;
+    for (int j = inicio + 1; j < fim; j++) {
+        maiorDelta |= static_cast<uint32_t>(slots[j] - slots[j - 1] - 1);
+    }
+    return larguraBits(maiorDelta);
+}
+
+/**
+ * Retorna true se a lista de 'contagem' slots (de 'numSlots' no total) é
+ * densa o bastante para ser guardada em containers Roaring
+ */
+static bool listaDensa(int contagem, int numSlots) {
+    return contagem >= TAMANHO_MINIMO_BITMAP &&
+           static_cast<long long>(contagem) * DIVISOR_DENSIDADE_BITMAP >= numSlots;
+}
+
+void Palavra::comprimirPostings(const int* offsets, const int* slots, int numSlots) {
+    // Primeira passada: conta blocos, containers e palavras de dados necessárias
+    inicioBlocos = new int[numPalavras + 1];
+    inicioContainers = new int[numPalavras + 1];
+    contagens = new int[numPalavras > 0 ? numPalavras : 1];
+    int numBlocos = 0;
+    int numContainers = 0;
+    long long totalDados = 0;
+    numPalavrasBitmap = 0;
+    numValores = 0;
+    for (int t = 0; t < numPalavras; t++) {
+        inicioBlocos[t] = numBlocos;
+        inicioContainers[t] = numContainers;
+        contagens[t] = offsets[t + 1] - offsets[t];
+
+        if (listaDensa(contagens[t], numSlots)) {
+            for (int i = offsets[t]; i < offsets[t + 1];) {
+                int chave = slots[i] >> 16;
+                int fim = i;
+                while (fim < offsets[t + 1] && (slots[fim] >> 16) == chave) {
+                    fim++;
+                }
+                if (fim - i > LIMIAR_CONTAINER_ARRAY) {
+                    numPalavrasBitmap += PALAVRAS_CONTAINER_BITMAP;
+                } else {
+                    numValores += fim - i;
+                }
+                numContainers++;
+                i = fim;
+            }
+            continue;
+        }
+
+        for (int i = offsets[t]; i < offsets[t + 1]; i += TAMANHO_BLOCO_POSTINGS) {
+            int fim = i + TAMANHO_BLOCO_POSTINGS < offsets[t + 1] ? i + TAMANHO_BLOCO_POSTINGS
+                                                                 : offsets[t + 1];
+            int bits = larguraBitsBloco(slots, i, fim);
+            totalDados += (static_cast<long long>(fim - i - 1) * bits + 31) / 32;
+            numBlocos++;
+        }
+    }
+    inicioBlocos[numPalavras] = numBlocos;
+    inicioContainers[numPalavras] = numContainers;
+
+    // Uma palavra extra no final permite ler sempre 64 bits ao descomprimir
+    numDados = static_cast<int>(totalDados) + 1;
+    blocos = new CabecalhoBloco[numBlocos > 0 ? numBlocos : 1];
+    dados = new uint32_t[numDados];
+    for (int i = 0; i < numDados; i++) {
+        dados[i] = 0;
+    }
+
+    containers = new ContainerRoaring[numContainers > 0 ? numContainers : 1];
+    bitmaps = new uint64_t[numPalavrasBitmap > 0 ? numPalavrasBitmap : 1];
+    valores = new uint16_t[numValores > 0 ? numValores : 1];
+    for (int i = 0; i < numPalavrasBitmap; i++) {
+        bitmaps[i] = 0;
+    }
+
+    // Segunda passada: codifica os deltas de cada bloco ou preenche os containers
+    int b = 0;
+    int deslocamento = 0;
+    int c = 0;
+    int deslocamentoBitmap = 0;
+    int deslocamentoValores = 0;
+    for (int t = 0; t < numPalavras; t++) {
+        if (listaDensa(contagens[t], numSlots)) {
+            for (int i = offsets[t]; i < offsets[t + 1];) {
+                int chave = slots[i] >> 16;
+                int fim = i;
+                while (fim < offsets[t + 1] && (slots[fim] >> 16) == chave) {
+                    fim++;
+                }
+
+                containers[c].chave = chave;
+                containers[c].cardinalidade = fim - i;
+                containers[c].ehBitmap = fim - i > LIMIAR_CONTAINER_ARRAY ? 1 : 0;
+                if (containers[c].ehBitmap) {
+                    containers[c].deslocamento = deslocamentoBitmap;
+                    for (int j = i; j < fim; j++) {
+                        int baixo = slots[j] & 0xFFFF;
+                        bitmaps[deslocamentoBitmap + (baixo >> 6)] |= static_cast<uint64_t>(1) << (baixo & 63);
+                    }
+                    deslocamentoBitmap += PALAVRAS_CONTAINER_BITMAP;
+                } else {
+                    containers[c].deslocamento = deslocamentoValores;
+                    for (int j = i; j < fim; j++) {
+                        valores[deslocamentoValores++] = static_cast<uint16_t>(slots[j] & 0xFFFF);
+                    }
+                }
+                c++;
+                i = fim;
+            }
+            continue;
+        }
+
+        for (int i = offsets[t]; i < offsets[t + 1]; i += TAMANHO_BLOCO_POSTINGS) {
+            int fim = i + TAMANHO_BLOCO_POSTINGS < offsets[t + 1] ? i + TAMANHO_BLOCO_POSTINGS
+                                                                 : offsets[t + 1];
+            int bits = larguraBitsBloco(slots, i, fim);
+
+            blocos[b].primeiro = slots[i];
+            blocos[b].ultimo = slots[fim - 1];
+            blocos[b].deslocamento = deslocamento;
+            blocos[b].bits = bits;
+
+            if (bits > 0) {
+                long long posicaoBit = 0;
+                for (int j = i + 1; j < fim; j++) {
+                    uint64_t delta = static_cast<uint32_t>(slots[j] - slots[j - 1] - 1);
+                    int palavra = deslocamento + static_cast<int>(posicaoBit >> 5);
+                    int desloc = static_cast<int>(posicaoBit & 31);
+                    uint64_t deslocado = delta << desloc;
+                    dados[palavra] |= static_cast<uint32_t>(deslocado);
+                    if (desloc + bits > 32) {
+                        dados[palavra + 1] |= static_cast<uint32_t>(deslocado >> 32);
+                    }
+                    posicaoBit += bits;
+                }
+            }
+
+            deslocamento += static_cast<int>((static_cast<long long>(fim - i - 1) * bits + 31) / 32);
+            b++;
+        }
+    }
+}
+
+int decodificarBloco(const ListaPostings& lista, int b, int* saida) {
+    const CabecalhoBloco& cabecalho = lista.blocos[b];
+    int n = lista.tamanhoBloco(b);
+    int bits = cabecalho.bits;
+    int valor = cabecalho.primeiro;
+    saida[0] = valor;
+
+    if (bits == 0) {
+        // Slots consecutivos
+        for (int i = 1; i < n; i++) {
+            saida[i] = ++valor;
+        }
+        return n;
+    }
+
+    const uint32_t* dados = lista.dados + cabecalho.deslocamento;
+    uint64_t mascara = (static_cast<uint64_t>(1) << bits) - 1;
+    int posicaoBit = 0;
+    for (int i = 1; i < n; i++) {
+        int palavra = posicaoBit >> 5;
+        uint64_t janela = static_cast<uint64_t>(dados[palavra]) |
+                          (static_cast<uint64_t>(dados[palavra + 1]) << 32);
+        uint32_t delta = static_cast<uint32_t>((janela >> (posicaoBit & 31)) & mascara);
+        valor += static_cast<int>(delta) + 1;
+        saida[i] = valor;
+        posicaoBit += bits;
+    }
+    return n;
+}
+
+int decodificarContainer(const ListaPostings& lista, int c, int* saida) {
+    const ContainerRoaring& container = lista.containers[c];
+    int base = container.chave << 16;
+
+    if (!container.ehBitmap) {
+        const uint16_t* valores = lista.valores + container.deslocamento;
+        for (int i = 0; i < container.cardinalidade; i++) {
+            saida[i] = base | valores[i];
+        }
+        return container.cardinalidade;
+    }
+
+    // Extrai os bits ligados palavra a palavra (ctz + limpa o bit mais baixo)
+    const uint64_t* palavras = lista.bitmaps + container.deslocamento;
+    int n = 0;
+    for (int w = 0; w < PALAVRAS_CONTAINER_BITMAP; w++) {
+        uint64_t palavra = palavras[w];
+        while (palavra != 0) {
+            saida[n++] = base | (w << 6) | __builtin_ctzll(palavra);
+            palavra &= palavra - 1;
+        }
+    }
+    return n;
+}
+
+void decodificarLista(const ListaPostings& lista, int* saida) {
+    for (int c = 0; c < lista.numContainers; c++) {
+        saida += decodificarContainer(lista, c, saida);
+    }
+    for (int b = 0; b < lista.numBlocos; b++) {
+        saida += decodificarBloco(lista, b, saida);
+    }
+}
+
+/**
+ * Slots de um container Roaring na faixa [inicio, fim)
+ */
+static int decodificarContainerFaixa(const ListaPostings& lista, int c,
+                                     int inicio, int fim, int* saida) {
+    const ContainerRoaring& container = lista.containers[c];
+    int base = container.chave << 16;
+    int baixo = inicio > base ? inicio - base : 0;
+    int alto = fim - base < 65536 ? fim - base : 65536;
+    int n = 0;
+
+    if (!container.ehBitmap) {
+        const uint16_t* valores = lista.valores + container.deslocamento;
+        int esq = 0;
+        int dir = container.cardinalidade;
+        while (esq < dir) {
+            int meio = esq + (dir - esq) / 2;
+            if (valores[meio] < baixo) {
+                esq = meio + 1;
+            } else {
+                dir = meio;
+            }
+        }
+        for (int i = esq; i < container.cardinalidade && valores[i] < alto; i++) {
+            saida[n++] = base | valores[i];
+        }
+        return n;
+    }
+
+    // Só as palavras do bitmap que cobrem [baixo, alto), mascarando as pontas
+    const uint64_t* palavras = lista.bitmaps + container.deslocamento;
+    for (int w = baixo >> 6; w <= (alto - 1) >> 6; w++) {
+        uint64_t palavra = palavras[w];
+        if (w == baixo >> 6) {
+            palavra &= ~static_cast<uint64_t>(0) << (baixo & 63);
+        }
+        if (w == (alto - 1) >> 6 && (alto & 63) != 0) {
+            palavra &= (static_cast<uint64_t>(1) << (alto & 63)) - 1;
+        }
+        while (palavra != 0) {
+            saida[n++] = base | (w << 6) | __builtin_ctzll(palavra);
+            palavra &= palavra - 1;
+        }
+    }
+    return n;
+}
+
+int decodificarFaixa(const ListaPostings& lista, int inicio, int fim, int* saida) {
+    int n = 0;
+    if (inicio >= fim) {
+        return 0;
+    }
+
+    if (lista.ehRoaring()) {
+        // Primeiro container cuja chave alcança a faixa
+        int chaveInicio = inicio >> 16;
+        int esq = 0;
+        int dir = lista.numContainers;
+        while (esq < dir) {
+            int meio = esq + (dir - esq) / 2;
+            if (lista.containers[meio].chave < chaveInicio) {
+                esq = meio + 1;
+            } else {
+                dir = meio;
+            }
+        }
+        for (int c = esq; c < lista.numContainers && (lista.containers[c].chave << 16) < fim; c++) {
+            n += decodificarContainerFaixa(lista, c, inicio, fim, saida + n);
+        }
+        return n;
+    }
+
+    // Primeiro bloco cujo último slot alcança a faixa
+    int esq = 0;
+    int dir = lista.numBlocos;
+    while (esq < dir) {
+        int meio = esq + (dir - esq) / 2;
+        if (lista.blocos[meio].ultimo < inicio) {
+            esq = meio + 1;
+        } else {
+            dir = meio;
+        }
+    }
+
+    int bloco[TAMANHO_BLOCO_POSTINGS];
+    for (int b = esq; b < lista.numBlocos && lista.blocos[b].primeiro < fim; b++) {
+        const CabecalhoBloco& cabecalho = lista.blocos[b];
+        if (cabecalho.bits == 0) {
+            // Slots consecutivos: a interseção com a faixa é um intervalo
+            int de = cabecalho.primeiro > inicio ? cabecalho.primeiro : inicio;
+            int ate = cabecalho.ultimo < fim - 1 ? cabecalho.ultimo : fim - 1;
+            for (int v = de; v <= ate; v++) {
+                saida[n++] = v;
+            }
+            continue;
+        }
+        int tamanhoBloco = decodificarBloco(lista, b, bloco);
+        for (int i = 0; i < tamanhoBloco; i++) {
+            if (bloco[i] >= inicio && bloco[i] < fim) {
+                saida[n++] = bloco[i];
+            }
+        }
+    }
+    return n;
+}
+
+bool Palavra::estaCongelado() const {
+    return congelado;
+}
+
+ListaPostings Palavra::buscarPostings(const std::string& palavra) const {
+    if (!congelado) {
+        return ListaPostings();
+    }
+
+    return getPostings(buscarIdTermo(palavra));
+}
+
+ListaPostings Palavra::getPostings(int t) const {
+    if (!congelado || t < 0 || t >= numPalavras) {
+        return ListaPostings();
+    }
+
+    ListaPostings lista(blocos + inicioBlocos[t], dados,
+                        inicioBlocos[t + 1] - inicioBlocos[t], contagens[t]);
+    lista.containers = containers + inicioContainers[t];
+    lista.bitmaps = bitmaps;
+    lista.valores = valores;
+    lista.numContainers = inicioContainers[t + 1] - inicioContainers[t];
+    return lista;
+}
+
+long long Palavra::getMemoriaPostings() const {
+    if (!congelado) {
+        return 0;
+    }
+    return static_cast<long long>(inicioBlocos[numPalavras]) * sizeof(CabecalhoBloco) +
+           static_cast<long long>(numPalavras + 1) * sizeof(int) +
+           static_cast<long long>(numPalavras) * sizeof(int) +
+           static_cast<long long>(numDados) * sizeof(uint32_t) +
+           static_cast<long long>(inicioContainers[numPalavras]) * sizeof(ContainerRoaring) +
+           static_cast<long long>(numPalavras + 1) * sizeof(int) +
+           static_cast<long long>(numPalavrasBitmap) * sizeof(uint64_t) +
+           static_cast<long long>(numValores) * sizeof(uint16_t);
+}
+
+void Palavra::exportarPostings(DadosPostings& saida) const {
+    saida.numPalavras = numPalavras;
+    saida.blocos = blocos;
+    saida.inicioBlocos = inicioBlocos;
+    saida.contagens = contagens;
+    saida.dados = dados;
+    saida.numDados = numDados;
+    saida.containers = containers;
+    saida.inicioContainers = inicioContainers;
+    saida.bitmaps = bitmaps;
+    saida.numPalavrasBitmap = numPalavrasBitmap;
+    saida.valores = valores;
+    saida.numValores = numValores;
+}
+
+void Palavra::coletarTermosRec(NodoAVL* nodo, std::string* textos) const {
+    if (nodo == nullptr) {
+        return;
+    }
+    coletarTermosRec(nodo->esq, textos);
+    textos[nodo->idTermo] = nodo->palavra;
+    coletarTermosRec(nodo->dir, textos);
+}
+
+std::string* Palavra::coletarTermos() const {
+    std::string* textos = new std::string[numPalavras > 0 ? numPalavras : 1];
+    if (backend == DICIONARIO_HASH) {
+        for (int id = 0; id < numPalavras; id++) {
+            textos[id] = dicionarioHash->getTexto(id);
+        }
+    } else {
+        coletarTermosRec(raiz, textos);
+    }
+    return textos;
 }
\ No newline at end of file
@@ -0,0 +1,153 @@
+#include "pool_trabalho.hpp"
+
+// ============================================================================
+// PoolTrabalho - Implementação
+// ============================================================================
+
+PoolTrabalho::PoolTrabalho(int numTrabalhadores)
+    : numTrabalhadores(numTrabalhadores > 0 ? numTrabalhadores : 1),
+      threads(nullptr), filas(nullptr),
+      funcao(nullptr), contexto(nullptr), numTarefas(0), tamanhoLote(1), numLotes(0),
+      geracao(0), encerrar(false), loteConcluido(nullptr), lotesConcluidos(0) {
+    filas = new FilaLotes[this->numTrabalhadores];
+    threads = new std::thread[this->numTrabalhadores];
+    for (int w = 0; w < this->numTrabalhadores; w++) {
+        threads[w] = std::thread(&PoolTrabalho::executarTrabalhador, this, w);
+    }
+}
+
+PoolTrabalho::~PoolTrabalho() {
+    {
+        std::lock_guard<std::mutex> guarda(trava);
+        encerrar = true;
+    }
+    condTrabalho.notify_all();
+    for (int w = 0; w < numTrabalhadores; w++) {
+        threads[w].join();
+    }
+
+    for (int w = 0; w < numTrabalhadores; w++) {
+        delete[] filas[w].lotes;
+    }
+    delete[] filas;
+    delete[] threads;
+    delete[] loteConcluido;
+}
+
+void PoolTrabalho::executarTrabalhador(int trabalhador) {
+    int geracaoVista = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> guarda(trava);
+            while (!encerrar && geracao == geracaoVista) {
+                condTrabalho.wait(guarda);
+            }
+            if (encerrar) {
+                return;
+            }
+            geracaoVista = geracao;
+        }
+
+        int lote;
+        while ((lote = obterLote(trabalhador)) >= 0) {
+            executarLote(lote, trabalhador);
+        }
+    }
+}
+
+int PoolTrabalho::obterLote(int trabalhador) {
+    // Própria fila: pelo início, mantendo a ordem de entrada
+    {
+        FilaLotes& fila = filas[trabalhador];
+        std::lock_guard<std::mutex> guarda(fila.trava);
+        if (fila.inicio < fila.fim) {
+            return fila.lotes[fila.inicio++];
+        }
+    }
+
+    // Roubo: pelo fim da fila das vítimas, em rodízio a partir do vizinho
+    for (int k = 1; k < numTrabalhadores; k++) {
+        FilaLotes& fila = filas[(trabalhador + k) % numTrabalhadores];
+        std::lock_guard<std::mutex> guarda(fila.trava);
+        if (fila.inicio < fila.fim) {
+            return fila.lotes[--fila.fim];
+        }
+    }
+    return -1;
+}
+
+void PoolTrabalho::executarLote(int lote, int trabalhador) {
+    int inicio = lote * tamanhoLote;
+    int fim = inicio + tamanhoLote < numTarefas ? inicio + tamanhoLote : numTarefas;
+    for (int t = inicio; t < fim; t++) {
+        funcao(t, trabalhador, contexto);
+    }
+
+    {
+        std::lock_guard<std::mutex> guarda(trava);
+        loteConcluido[lote] = true;
+        lotesConcluidos++;
+    }
+    condConclusao.notify_all();
+}
+
+void PoolTrabalho::iniciar(int numTarefas, int tamanhoLote, FuncaoTarefa funcao, void* contexto) {
+    this->funcao = funcao;
+    this->contexto = contexto;
+    this->numTarefas = numTarefas > 0 ? numTarefas : 0;
+    this->tamanhoLote = tamanhoLote > 0 ? tamanhoLote : 1;
+    numLotes = (this->numTarefas + this->tamanhoLote - 1) / this->tamanhoLote;
+
+    delete[] loteConcluido;
+    loteConcluido = new bool[numLotes > 0 ? numLotes : 1];
+    for (int l = 0; l < numLotes; l++) {
+        loteConcluido[l] = false;
+    }
+    lotesConcluidos = 0;
+
+    // Distribuição em rodízio: o trabalhador w recebe os lotes w, w + n, w + 2n, ...
+    for (int w = 0; w < numTrabalhadores; w++) {
+        FilaLotes& fila = filas[w];
+        std::lock_guard<std::mutex> guarda(fila.trava);
+        delete[] fila.lotes;
+        int quantidade = w < numLotes ? (numLotes - w + numTrabalhadores - 1) / numTrabalhadores : 0;
+        fila.lotes = new int[quantidade > 0 ? quantidade : 1];
+        for (int i = 0; i < quantidade; i++) {
+            fila.lotes[i] = w + i * numTrabalhadores;
+        }
+        fila.inicio = 0;
+        fila.fim = quantidade;
+    }
+
+    {
+        std::lock_guard<std::mutex> guarda(trava);
+        geracao++;
+    }
+    condTrabalho.notify_all();
+}
+
+void PoolTrabalho::aguardarLote(int lote) {
+    std::unique_lock<std::mutex> guarda(trava);
+    while (!loteConcluido[lote]) {
+        condConclusao.wait(guarda);
+    }
+}
+
+void PoolTrabalho::aguardarTodos() {
+    std::unique_lock<std::mutex> guarda(trava);
+    while (lotesConcluidos < numLotes) {
+        condConclusao.wait(guarda);
+    }
+}
+
+int PoolTrabalho::getLote(int tarefa) const {
+    return tarefa / tamanhoLote;
+}
+
+int PoolTrabalho::getNumLotes() const {
+    return numLotes;
+}
+
+int PoolTrabalho::getNumTrabalhadores() const {
+    return numTrabalhadores;
+}
\ No newline at end of file
@@ -0,0 +1,422 @@
+#include "snapshot.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char ASSINATURA_SNAPSHOT[8] = {'T', 'P', '3', 'S', 'N', 'A', 'P', '\0'};
+
+// ============================================================================
+// Checksum
+// ============================================================================
+
+/**
+ * Checksum de 64 bits sobre palavras de 8 bytes (n múltiplo de 8)
+ * Quatro acumuladores independentes para não serializar as multiplicações
+ */
+static uint64_t calcularChecksum(const unsigned char* dados, uint64_t n) {
+    const uint64_t primo = 0x9E3779B97F4A7C15ull;
+    uint64_t h[4] = {0x243F6A8885A308D3ull, 0x13198A2E03707344ull,
+                     0xA4093822299F31D0ull, 0x082EFA98EC4E6C89ull};
+    uint64_t i = 0;
+    for (; i + 32 <= n; i += 32) {
+        for (int k = 0; k < 4; k++) {
+            uint64_t palavra;
+            std::memcpy(&palavra, dados + i + 8 * k, 8);
+            h[k] = (h[k] ^ palavra) * primo;
+            h[k] ^= h[k] >> 29;
+        }
+    }
+    for (; i + 8 <= n; i += 8) {
+        uint64_t palavra;
+        std::memcpy(&palavra, dados + i, 8);
+        h[0] = (h[0] ^ palavra) * primo;
+        h[0] ^= h[0] >> 29;
+    }
+
+    uint64_t resultado = n;
+    for (int k = 0; k < 4; k++) {
+        resultado = (resultado ^ h[k]) * primo;
+        resultado ^= resultado >> 32;
+    }
+    return resultado;
+}
+
+// ============================================================================
+// Gravação
+// ============================================================================
+
+/**
+ * Arquivo de saída em memória: cabeçalho + seções alinhadas
+ */
+struct ImagemSnapshot {
+    unsigned char* bytes;
+    uint64_t tamanho;
+    uint64_t capacidade;
+    CabecalhoSnapshot cabecalho;
+
+    ImagemSnapshot() : bytes(nullptr), tamanho(0), capacidade(0) {
+        std::memset(&cabecalho, 0, sizeof(cabecalho));
+    }
+
+    ~ImagemSnapshot() {
+        delete[] bytes;
+    }
+
+    void garantir(uint64_t n) {
+        if (n <= capacidade) {
+            return;
+        }
+        uint64_t novaCapacidade = capacidade == 0 ? 4096 : capacidade;
+        while (novaCapacidade < n) {
+            novaCapacidade *= 2;
+        }
+        unsigned char* novos = new unsigned char[novaCapacidade];
+        if (tamanho > 0) {
+            std::memcpy(novos, bytes, tamanho);
+        }
+        delete[] bytes;
+        bytes = novos;
+        capacidade = novaCapacidade;
+    }
+
+    /**
+     * Acrescenta zeros até o próximo múltiplo do alinhamento
+     */
+    void alinhar() {
+        uint64_t alinhado = (tamanho + ALINHAMENTO_SECAO_SNAPSHOT - 1) /
+                            ALINHAMENTO_SECAO_SNAPSHOT * ALINHAMENTO_SECAO_SNAPSHOT;
+        garantir(alinhado);
+        std::memset(bytes + tamanho, 0, alinhado - tamanho);
+        tamanho = alinhado;
+    }
+
+    void adicionarSecao(SecaoSnapshot secao, const void* dados, uint64_t numBytes) {
+        alinhar();
+        cabecalho.secoes[secao].deslocamento = tamanho;
+        cabecalho.secoes[secao].tamanho = numBytes;
+        garantir(tamanho + numBytes);
+        if (numBytes > 0) {
+            std::memcpy(bytes + tamanho, dados, numBytes);
+        }
+        tamanho += numBytes;
+    }
+};
+
+bool gravarSnapshot(const char* caminho, const Palavra* indice,
+                    const TabelaLogradouros* tabela, std::string& erro) {
+    if (indice == nullptr || tabela == nullptr || !indice->estaCongelado()) {
+        erro = "o indice precisa estar congelado";
+        return false;
+    }
+
+    DadosPostings postings;
+    indice->exportarPostings(postings);
+    DadosTabelaLogradouros dadosTabela;
+    tabela->exportar(dadosTabela);
+
+    // O dicionário do snapshot é sempre a tabela de dispersão: reinserir os
+    // termos em ordem de id preserva os ids usados pelas listas de postings
+    DicionarioHash dicionario(postings.numPalavras * 2);
+    std::string* termos = indice->coletarTermos();
+    for (int id = 0; id < postings.numPalavras; id++) {
+        dicionario.obterOuInserir(termos[id]);
+    }
+    delete[] termos;
+    DadosDicionario dadosDicionario;
+    dicionario.exportar(dadosDicionario);
+
+    ImagemSnapshot imagem;
+    imagem.garantir(sizeof(CabecalhoSnapshot));
+    imagem.tamanho = sizeof(CabecalhoSnapshot);
+
+    int numPalavras = postings.numPalavras;
+    int numBlocos = postings.inicioBlocos[numPalavras];
+    int numContainers = postings.inicioContainers[numPalavras];
+    imagem.adicionarSecao(SECAO_BLOCOS, postings.blocos,
+                          static_cast<uint64_t>(numBlocos) * sizeof(CabecalhoBloco));
+    imagem.adicionarSecao(SECAO_INICIO_BLOCOS, postings.inicioBlocos,
+                          static_cast<uint64_t>(numPalavras + 1) * sizeof(int));
+    imagem.adicionarSecao(SECAO_CONTAGENS, postings.contagens,
+                          static_cast<uint64_t>(numPalavras) * sizeof(int));
+    imagem.adicionarSecao(SECAO_DADOS, postings.dados,
+                          static_cast<uint64_t>(postings.numDados) * sizeof(uint32_t));
+    imagem.adicionarSecao(SECAO_CONTAINERS, postings.containers,
+                          static_cast<uint64_t>(numContainers) * sizeof(ContainerRoaring));
+    imagem.adicionarSecao(SECAO_INICIO_CONTAINERS, postings.inicioContainers,
+                          static_cast<uint64_t>(numPalavras + 1) * sizeof(int));
+    imagem.adicionarSecao(SECAO_BITMAPS, postings.bitmaps,
+                          static_cast<uint64_t>(postings.numPalavrasBitmap) * sizeof(uint64_t));
+    imagem.adicionarSecao(SECAO_VALORES, postings.valores,
+                          static_cast<uint64_t>(postings.numValores) * sizeof(uint16_t));
+
+    imagem.adicionarSecao(SECAO_SLOTS_DICIONARIO, dadosDicionario.slots,
+                          static_cast<uint64_t>(dadosDicionario.capacidade) * sizeof(SlotDicionario));
+    imagem.adicionarSecao(SECAO_TEXTOS_TERMOS, dadosDicionario.textos,
+                          static_cast<uint64_t>(dadosDicionario.tamanhoTextos));
+    imagem.adicionarSecao(SECAO_INICIO_TERMOS, dadosDicionario.inicioTexto,
+                          static_cast<uint64_t>(numPalavras + 1) * sizeof(int));
+
+    int n = dadosTabela.numLogradouros;
+    int numCelulas = dadosTabela.linhasGrade * dadosTabela.colunasGrade;
+    imagem.adicionarSecao(SECAO_IDS, dadosTabela.ids, static_cast<uint64_t>(n) * sizeof(int));
+    imagem.adicionarSecao(SECAO_LATITUDES, dadosTabela.latitudes,
+                          static_cast<uint64_t>(n) * sizeof(double));
+    imagem.adicionarSecao(SECAO_LONGITUDES, dadosTabela.longitudes,
+                          static_cast<uint64_t>(n) * sizeof(double));
+    imagem.adicionarSecao(SECAO_LINHAS_SAIDA, dadosTabela.linhasSaida,
+                          static_cast<uint64_t>(dadosTabela.tamanhoLinhas));
+    imagem.adicionarSecao(SECAO_INICIO_LINHAS, dadosTabela.inicioLinha,
+                          static_cast<uint64_t>(n + 1) * sizeof(int));
+    imagem.adicionarSecao(SECAO_SLOT_POR_ID, dadosTabela.slotPorId,
+                          dadosTabela.slotPorId != nullptr
+                              ? static_cast<uint64_t>(dadosTabela.faixaIds) * sizeof(int) : 0);
+    imagem.adicionarSecao(SECAO_IDS_ORDENADOS, dadosTabela.idsOrdenados,
+                          dadosTabela.idsOrdenados != nullptr
+                              ? static_cast<uint64_t>(n) * sizeof(int) : 0);
+    imagem.adicionarSecao(SECAO_SLOTS_ORDENADOS, dadosTabela.slotsOrdenados,
+                          dadosTabela.slotsOrdenados != nullptr
+                              ? static_cast<uint64_t>(n) * sizeof(int) : 0);
+    imagem.adicionarSecao(SECAO_INICIO_CELULA, dadosTabela.inicioCelula,
+                          static_cast<uint64_t>(numCelulas + 2) * sizeof(int));
+    imagem.alinhar();
+
+    // Cabeçalho: escalares, tamanho e checksum do corpo
+    CabecalhoSnapshot& cabecalho = imagem.cabecalho;
+    std::memcpy(cabecalho.assinatura, ASSINATURA_SNAPSHOT, sizeof(cabecalho.assinatura));
+    cabecalho.versao = VERSAO_SNAPSHOT;
+    cabecalho.marcadorOrdem = MARCADOR_ORDEM_SNAPSHOT;
+    cabecalho.tamanhoArquivo = imagem.tamanho;
+    cabecalho.numPalavras = numPalavras;
+    cabecalho.numDados = postings.numDados;
+    cabecalho.numPalavrasBitmap = postings.numPalavrasBitmap;
+    cabecalho.numValores = postings.numValores;
+    cabecalho.capacidadeDicionario = dadosDicionario.capacidade;
+    cabecalho.tamanhoTextosTermos = dadosDicionario.tamanhoTextos;
+    cabecalho.numLogradouros = n;
+    cabecalho.tamanhoLinhas = dadosTabela.tamanhoLinhas;
+    cabecalho.idMinimo = dadosTabela.idMinimo;
+    cabecalho.faixaIds = dadosTabela.slotPorId != nullptr ? dadosTabela.faixaIds : 0;
+    cabecalho.linhasGrade = dadosTabela.linhasGrade;
+    cabecalho.colunasGrade = dadosTabela.colunasGrade;
+    cabecalho.latMinima = dadosTabela.latMinima;
+    cabecalho.lonMinima = dadosTabela.lonMinima;
+    cabecalho.ladoCelula = dadosTabela.ladoCelula;
+    cabecalho.folgaLimite = dadosTabela.folgaLimite;
+    cabecalho.checksum = calcularChecksum(imagem.bytes + sizeof(CabecalhoSnapshot),
+                                          imagem.tamanho - sizeof(CabecalhoSnapshot));
+    std::memcpy(imagem.bytes, &cabecalho, sizeof(CabecalhoSnapshot));
+
+    // Grava num arquivo temporário e renomeia: leitores nunca veem um snapshot pela metade
+    std::string temporario = std::string(caminho) + ".tmp";
+    FILE* arquivo = std::fopen(temporario.c_str(), "wb");
+    if (arquivo == nullptr) {
+        erro = "nao foi possivel criar " + temporario;
+        return false;
+    }
+    bool ok = std::fwrite(imagem.bytes, 1, imagem.tamanho, arquivo) == imagem.tamanho;
+    ok = std::fclose(arquivo) == 0 && ok;
+    if (!ok || std::rename(temporario.c_str(), caminho) != 0) {
+        std::remove(temporario.c_str());
+        erro = std::string("falha ao gravar ") + caminho;
+        return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// Snapshot - Implementação
+// ============================================================================
+
+Snapshot::Snapshot() : base(nullptr), tamanho(0), indice(nullptr), tabela(nullptr) {
+}
+
+Snapshot::~Snapshot() {
+    delete indice;
+    delete tabela;
+    if (base != nullptr) {
+        munmap(base, tamanho);
+    }
+}
+
+/**
+ * Confere se a seção cabe no arquivo, está alinhada e tem o tamanho esperado
+ */
+static bool secaoValida(const CabecalhoSnapshot& cabecalho, SecaoSnapshot secao,
+                        uint64_t tamanhoEsperado) {
+    const DescritorSecao& d = cabecalho.secoes[secao];
+    return d.tamanho == tamanhoEsperado &&
+           d.deslocamento % ALINHAMENTO_SECAO_SNAPSHOT == 0 &&
+           d.deslocamento >= sizeof(CabecalhoSnapshot) &&
+           d.deslocamento <= cabecalho.tamanhoArquivo &&
+           d.tamanho <= cabecalho.tamanhoArquivo - d.deslocamento;
+}
+
+bool Snapshot::abrir(const char* caminho, std::string& erro) {
+    erro.clear();
+    if (base != nullptr) {
+        erro = "snapshot ja aberto";
+        return false;
+    }
+
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) {
+        erro = std::string("nao foi possivel abrir ") + caminho;
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(CabecalhoSnapshot))) {
+        close(fd);
+        erro = "arquivo de snapshot truncado";
+        return false;
+    }
+
+    uint64_t tamanhoArquivo = static_cast<uint64_t>(info.st_size);
+    void* mapa = mmap(nullptr, tamanhoArquivo, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapa == MAP_FAILED) {
+        erro = "falha no mmap do snapshot";
+        return false;
+    }
+    base = mapa;
+    tamanho = tamanhoArquivo;
+
+    unsigned char* bytes = static_cast<unsigned char*>(base);
+    const CabecalhoSnapshot& c = *reinterpret_cast<const CabecalhoSnapshot*>(bytes);
+
+    // Identificação e compatibilidade
+    if (std::memcmp(c.assinatura, ASSINATURA_SNAPSHOT, sizeof(c.assinatura)) != 0) {
+        erro = "arquivo nao e um snapshot";
+    } else if (c.versao != VERSAO_SNAPSHOT) {
+        erro = "versao de snapshot incompativel";
+    } else if (c.marcadorOrdem != MARCADOR_ORDEM_SNAPSHOT) {
+        erro = "snapshot gerado com outra ordem de bytes";
+    } else if (c.tamanhoArquivo != tamanhoArquivo) {
+        erro = "tamanho do snapshot nao confere";
+    } else if (c.numPalavras < 0 || c.numLogradouros < 0 || c.numDados < 1 ||
+               c.numPalavrasBitmap < 0 || c.numValores < 0 || c.tamanhoTextosTermos < 0 ||
+               c.tamanhoLinhas < 0 || c.faixaIds < 0 || c.linhasGrade < 1 || c.colunasGrade < 1 ||
+               c.capacidadeDicionario < 1 ||
+               (c.capacidadeDicionario & (c.capacidadeDicionario - 1)) != 0) {
+        erro = "cabecalho do snapshot invalido";
+    }
+    if (!erro.empty()) {
+        munmap(base, tamanho);
+        base = nullptr;
+        return false;
+    }
+
+    // Limites e tamanhos das seções que não dependem do conteúdo
+    uint64_t p = static_cast<uint64_t>(c.numPalavras);
+    uint64_t n = static_cast<uint64_t>(c.numLogradouros);
+    uint64_t celulas = static_cast<uint64_t>(c.linhasGrade) * static_cast<uint64_t>(c.colunasGrade);
+    bool direto = c.secoes[SECAO_SLOT_POR_ID].tamanho > 0;
+    bool ok = secaoValida(c, SECAO_INICIO_BLOCOS, (p + 1) * sizeof(int)) &&
+              secaoValida(c, SECAO_CONTAGENS, p * sizeof(int)) &&
+              secaoValida(c, SECAO_DADOS, static_cast<uint64_t>(c.numDados) * sizeof(uint32_t)) &&
+              secaoValida(c, SECAO_INICIO_CONTAINERS, (p + 1) * sizeof(int)) &&
+              secaoValida(c, SECAO_BITMAPS,
+                          static_cast<uint64_t>(c.numPalavrasBitmap) * sizeof(uint64_t)) &&
+              secaoValida(c, SECAO_VALORES, static_cast<uint64_t>(c.numValores) * sizeof(uint16_t)) &&
+              secaoValida(c, SECAO_SLOTS_DICIONARIO,
+                          static_cast<uint64_t>(c.capacidadeDicionario) * sizeof(SlotDicionario)) &&
+              secaoValida(c, SECAO_TEXTOS_TERMOS, static_cast<uint64_t>(c.tamanhoTextosTermos)) &&
+              secaoValida(c, SECAO_INICIO_TERMOS, (p + 1) * sizeof(int)) &&
+              secaoValida(c, SECAO_IDS, n * sizeof(int)) &&
+              secaoValida(c, SECAO_LATITUDES, n * sizeof(double)) &&
+              secaoValida(c, SECAO_LONGITUDES, n * sizeof(double)) &&
+              secaoValida(c, SECAO_LINHAS_SAIDA, static_cast<uint64_t>(c.tamanhoLinhas)) &&
+              secaoValida(c, SECAO_INICIO_LINHAS, (n + 1) * sizeof(int)) &&
+              secaoValida(c, SECAO_SLOT_POR_ID,
+                          direto ? static_cast<uint64_t>(c.faixaIds) * sizeof(int) : 0) &&
+              secaoValida(c, SECAO_IDS_ORDENADOS, direto ? 0 : n * sizeof(int)) &&
+              secaoValida(c, SECAO_SLOTS_ORDENADOS, direto ? 0 : n * sizeof(int)) &&
+              secaoValida(c, SECAO_INICIO_CELULA, (celulas + 2) * sizeof(int));
+
+    // Checksum do corpo: detecta arquivos corrompidos antes de qualquer uso
+    if (!ok) {
+        erro = "secoes do snapshot invalidas";
+    } else if (calcularChecksum(bytes + sizeof(CabecalhoSnapshot),
+                                tamanhoArquivo - sizeof(CabecalhoSnapshot)) != c.checksum) {
+        erro = "checksum do snapshot nao confere";
+    }
+    if (erro.empty()) {
+        // Com o checksum conferido, valem as contagens gravadas nos offsets
+        const int* inicioBlocos = reinterpret_cast<const int*>(bytes + c.secoes[SECAO_INICIO_BLOCOS].deslocamento);
+        const int* inicioContainers =
+            reinterpret_cast<const int*>(bytes + c.secoes[SECAO_INICIO_CONTAINERS].deslocamento);
+        if (inicioBlocos[p] < 0 || inicioContainers[p] < 0 ||
+            !secaoValida(c, SECAO_BLOCOS, static_cast<uint64_t>(inicioBlocos[p]) * sizeof(CabecalhoBloco)) ||
+            !secaoValida(c, SECAO_CONTAINERS,
+                         static_cast<uint64_t>(inicioContainers[p]) * sizeof(ContainerRoaring))) {
+            erro = "secoes do snapshot invalidas";
+        }
+    }
+    if (!erro.empty()) {
+        munmap(base, tamanho);
+        base = nullptr;
+        return false;
+    }
+
+    // Monta os TADs sobre as páginas mapeadas
+    DadosPostings postings;
+    postings.numPalavras = c.numPalavras;
+    postings.blocos = reinterpret_cast<CabecalhoBloco*>(bytes + c.secoes[SECAO_BLOCOS].deslocamento);
+    postings.inicioBlocos = reinterpret_cast<int*>(bytes + c.secoes[SECAO_INICIO_BLOCOS].deslocamento);
+    postings.contagens = reinterpret_cast<int*>(bytes + c.secoes[SECAO_CONTAGENS].deslocamento);
+    postings.dados = reinterpret_cast<uint32_t*>(bytes + c.secoes[SECAO_DADOS].deslocamento);
+    postings.numDados = c.numDados;
+    postings.containers = reinterpret_cast<ContainerRoaring*>(bytes + c.secoes[SECAO_CONTAINERS].deslocamento);
+    postings.inicioContainers =
+        reinterpret_cast<int*>(bytes + c.secoes[SECAO_INICIO_CONTAINERS].deslocamento);
+    postings.bitmaps = reinterpret_cast<uint64_t*>(bytes + c.secoes[SECAO_BITMAPS].deslocamento);
+    postings.numPalavrasBitmap = c.numPalavrasBitmap;
+    postings.valores = reinterpret_cast<uint16_t*>(bytes + c.secoes[SECAO_VALORES].deslocamento);
+    postings.numValores = c.numValores;
+
+    DadosDicionario dicionario;
+    dicionario.slots = reinterpret_cast<SlotDicionario*>(bytes + c.secoes[SECAO_SLOTS_DICIONARIO].deslocamento);
+    dicionario.capacidade = c.capacidadeDicionario;
+    dicionario.numTermos = c.numPalavras;
+    dicionario.textos = reinterpret_cast<char*>(bytes + c.secoes[SECAO_TEXTOS_TERMOS].deslocamento);
+    dicionario.tamanhoTextos = c.tamanhoTextosTermos;
+    dicionario.inicioTexto = reinterpret_cast<int*>(bytes + c.secoes[SECAO_INICIO_TERMOS].deslocamento);
+
+    DadosTabelaLogradouros dadosTabela;
+    dadosTabela.numLogradouros = c.numLogradouros;
+    dadosTabela.ids = reinterpret_cast<int*>(bytes + c.secoes[SECAO_IDS].deslocamento);
+    dadosTabela.latitudes = reinterpret_cast<double*>(bytes + c.secoes[SECAO_LATITUDES].deslocamento);
+    dadosTabela.longitudes = reinterpret_cast<double*>(bytes + c.secoes[SECAO_LONGITUDES].deslocamento);
+    dadosTabela.linhasSaida = reinterpret_cast<char*>(bytes + c.secoes[SECAO_LINHAS_SAIDA].deslocamento);
+    dadosTabela.tamanhoLinhas = c.tamanhoLinhas;
+    dadosTabela.inicioLinha = reinterpret_cast<int*>(bytes + c.secoes[SECAO_INICIO_LINHAS].deslocamento);
+    dadosTabela.slotPorId =
+        direto ? reinterpret_cast<int*>(bytes + c.secoes[SECAO_SLOT_POR_ID].deslocamento) : nullptr;
+    dadosTabela.idMinimo = c.idMinimo;
+    dadosTabela.faixaIds = c.faixaIds;
+    dadosTabela.idsOrdenados =
+        direto ? nullptr : reinterpret_cast<int*>(bytes + c.secoes[SECAO_IDS_ORDENADOS].deslocamento);
+    dadosTabela.slotsOrdenados =
+        direto ? nullptr : reinterpret_cast<int*>(bytes + c.secoes[SECAO_SLOTS_ORDENADOS].deslocamento);
+    dadosTabela.latMinima = c.latMinima;
+    dadosTabela.lonMinima = c.lonMinima;
+    dadosTabela.ladoCelula = c.ladoCelula;
+    dadosTabela.folgaLimite = c.folgaLimite;
+    dadosTabela.linhasGrade = c.linhasGrade;
+    dadosTabela.colunasGrade = c.colunasGrade;
+    dadosTabela.inicioCelula = reinterpret_cast<int*>(bytes + c.secoes[SECAO_INICIO_CELULA].deslocamento);
+
+    indice = new Palavra(postings, new DicionarioHash(dicionario));
+    tabela = new TabelaLogradouros(dadosTabela);
+    return true;
+}
+
+const Palavra* Snapshot::getIndice() const {
+    return indice;
+}
+
+const TabelaLogradouros* Snapshot::getTabela() const {
+    return tabela;
+}
\ No newline at end of file
@@ -0,0 +1,545 @@
+#include "tabela_logradouros.hpp"
+#include "utils.hpp"
+#include "metrica.hpp"
+#include "distancias.hpp"
+#include <cstdlib>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <new>
+
+/**
+ * Par (IdLog, posição original) usado para ordenar os logradouros
+ */
+struct EntradaIdLog {
+    int id;
+    int posicao;
+};
+
+/**
+ * Converte o IdLog com a mesma semântica de std::stoi, sem exceções
+ * Retorna false se a string não começa por um inteiro válido
+ */
+static bool converterIdLog(const std::string& str, int& valor) {
+    const char* inicio = str.c_str();
+    char* fim = nullptr;
+    errno = 0;
+    long convertido = std::strtol(inicio, &fim, 10);
+    if (fim == inicio || errno == ERANGE ||
+        convertido < INT_MIN || convertido > INT_MAX) {
+        return false;
+    }
+    valor = static_cast<int>(convertido);
+    return true;
+}
+
+/**
+ * Ordena as entradas por (id, posicao) com merge sort bottom-up
+ */
+static void ordenarEntradas(EntradaIdLog* entradas, int n) {
+    EntradaIdLog* aux = new EntradaIdLog[n];
+    EntradaIdLog* origem = entradas;
+    EntradaIdLog* destino = aux;
+
+    for (int largura = 1; largura < n; largura *= 2) {
+        for (int esq = 0; esq < n; esq += 2 * largura) {
+            int meio = esq + largura < n ? esq + largura : n;
+            int dir = esq + 2 * largura < n ? esq + 2 * largura : n;
+            int i = esq, j = meio, k = esq;
+            while (i < meio && j < dir) {
+                if (origem[j].id < origem[i].id) {
+                    destino[k++] = origem[j++];
+                } else {
+                    destino[k++] = origem[i++];
+                }
+            }
+            while (i < meio) destino[k++] = origem[i++];
+            while (j < dir) destino[k++] = origem[j++];
+        }
+        EntradaIdLog* temp = origem;
+        origem = destino;
+        destino = temp;
+    }
+
+    if (origem != entradas) {
+        for (int i = 0; i < n; i++) {
+            entradas[i] = origem[i];
+        }
+    }
+    delete[] aux;
+}
+
+/**
+ * Margem para erros de arredondamento nos limites em corda (métrica geodésica)
+ */
+static const double FOLGA_CORDA = 1e-12;
+
+/**
+ * Cotas inferiores de sen(x), para x >= 0, e de cos(x), para qualquer x,
+ * pelos truncamentos das séries de Taylor (nunca negativas)
+ */
+static double senoInferior(double x) {
+    double cota = x - x * x * x / 6.0;
+    return cota > 0.0 ? cota : 0.0;
+}
+
+static double cossenoInferior(double x) {
+    double x2 = x * x;
+    double cota = 1.0 - x2 / 2.0 + x2 * x2 / 24.0 - x2 * x2 * x2 / 720.0;
+    return cota > 0.0 ? cota : 0.0;
+}
+
+/**
+ * Array de coordenadas alinhado a ALINHAMENTO_COORDENADAS (liberado com free)
+ */
+static double* alocarCoordenadas(int n) {
+    void* memoria = nullptr;
+    size_t bytes = static_cast<size_t>(n > 0 ? n : 1) * sizeof(double);
+    if (posix_memalign(&memoria, ALINHAMENTO_COORDENADAS, bytes) != 0) {
+        throw std::bad_alloc();
+    }
+    return static_cast<double*>(memoria);
+}
+
+TabelaLogradouros::TabelaLogradouros(Logradouro** logradourosArray, int tamanhoArray)
+    : logradouros(nullptr), ids(nullptr), numLogradouros(0),
+      latitudes(nullptr), longitudes(nullptr), linhasSaida(nullptr), tamanhoLinhas(0),
+      inicioLinha(nullptr), vetores(nullptr), podaGeodesica(false), donaDosArrays(true),
+      slotPorId(nullptr), idMinimo(0), faixaIds(0),
+      idsOrdenados(nullptr), slotsOrdenados(nullptr),
+      latMinima(0.0), lonMinima(0.0), ladoCelula(1.0), folgaLimite(0.0),
+      linhasGrade(1), colunasGrade(1), inicioCelula(nullptr) {
+    if (logradourosArray == nullptr || tamanhoArray < 0) {
+        tamanhoArray = 0;
+    }
+
+    // Converte cada IdLog uma única vez
+    EntradaIdLog* entradas = new EntradaIdLog[tamanhoArray > 0 ? tamanhoArray : 1];
+    int numValidos = 0;
+    for (int i = 0; i < tamanhoArray; i++) {
+        int id = 0;
+        if (logradourosArray[i] != nullptr &&
+            converterIdLog(logradourosArray[i]->getIdLog(), id)) {
+            entradas[numValidos].id = id;
+            entradas[numValidos].posicao = i;
+            numValidos++;
+        }
+    }
+
+    // Ordena por IdLog (estável: em caso de repetição, o primeiro do array vem antes)
+    ordenarEntradas(entradas, numValidos);
+
+    logradouros = new Logradouro*[numValidos > 0 ? numValidos : 1];
+    ids = new int[numValidos > 0 ? numValidos : 1];
+    for (int i = 0; i < numValidos; i++) {
+        if (numLogradouros > 0 && ids[numLogradouros - 1] == entradas[i].id) {
+            continue; // IdLog repetido: mantém o primeiro
+        }
+        ids[numLogradouros] = entradas[i].id;
+        logradouros[numLogradouros] = logradourosArray[entradas[i].posicao];
+        numLogradouros++;
+    }
+    delete[] entradas;
+
+    if (numLogradouros == 0) {
+        inicioCelula = new int[2];
+        inicioCelula[0] = 0;
+        inicioCelula[1] = 0;
+        montarArraysPorSlot();
+        return;
+    }
+
+    // Os IdLogs ainda estão em ordem crescente: guarda os extremos antes de
+    // reordenar os slots pela grade
+    int primeiroId = ids[0];
+    long long faixa = static_cast<long long>(ids[numLogradouros - 1]) - primeiroId + 1;
+    bool enderecamentoDireto = faixa <= 4LL * numLogradouros + 1024;
+    if (!enderecamentoDireto) {
+        idsOrdenados = new int[numLogradouros];
+        for (int i = 0; i < numLogradouros; i++) {
+            idsOrdenados[i] = ids[i];
+        }
+    }
+
+    particionarPorGrade();
+    montarArraysPorSlot();
+
+    if (!enderecamentoDireto) {
+        // Busca binária sobre idsOrdenados, que guarda o slot de cada IdLog
+        slotsOrdenados = new int[numLogradouros];
+        for (int slot = 0; slot < numLogradouros; slot++) {
+            int baixo = 0;
+            int alto = numLogradouros - 1;
+            while (baixo < alto) {
+                int meio = baixo + (alto - baixo) / 2;
+                if (idsOrdenados[meio] < ids[slot]) {
+                    baixo = meio + 1;
+                } else {
+                    alto = meio;
+                }
+            }
+            slotsOrdenados[baixo] = slot;
+        }
+    }
+
+    // Endereçamento direto quando a faixa de IdLogs é compacta
+    if (enderecamentoDireto) {
+        idMinimo = primeiroId;
+        faixaIds = static_cast<int>(faixa);
+        slotPorId = new int[faixaIds];
+        for (int i = 0; i < faixaIds; i++) {
+            slotPorId[i] = -1;
+        }
+        for (int slot = 0; slot < numLogradouros; slot++) {
+            slotPorId[ids[slot] - idMinimo] = slot;
+        }
+    }
+}
+
+TabelaLogradouros::TabelaLogradouros(const DadosTabelaLogradouros& dadosExternos)
+    : logradouros(nullptr), ids(dadosExternos.ids), numLogradouros(dadosExternos.numLogradouros),
+      latitudes(dadosExternos.latitudes), longitudes(dadosExternos.longitudes),
+      linhasSaida(dadosExternos.linhasSaida), tamanhoLinhas(dadosExternos.tamanhoLinhas),
+      inicioLinha(dadosExternos.inicioLinha), vetores(nullptr), podaGeodesica(false),
+      donaDosArrays(false),
+      slotPorId(dadosExternos.slotPorId), idMinimo(dadosExternos.idMinimo),
+      faixaIds(dadosExternos.faixaIds),
+      idsOrdenados(dadosExternos.idsOrdenados), slotsOrdenados(dadosExternos.slotsOrdenados),
+      latMinima(dadosExternos.latMinima), lonMinima(dadosExternos.lonMinima),
+      ladoCelula(dadosExternos.ladoCelula), folgaLimite(dadosExternos.folgaLimite),
+      linhasGrade(dadosExternos.linhasGrade), colunasGrade(dadosExternos.colunasGrade),
+      inicioCelula(dadosExternos.inicioCelula) {
+    montarVetoresUnitarios();
+}
+
+TabelaLogradouros::~TabelaLogradouros() {
+    std::free(vetores);
+    if (!donaDosArrays) {
+        return;
+    }
+    std::free(latitudes);
+    std::free(longitudes);
+    delete[] linhasSaida;
+    delete[] inicioLinha;
+    delete[] logradouros;
+    delete[] ids;
+    delete[] slotPorId;
+    delete[] idsOrdenados;
+    delete[] slotsOrdenados;
+    delete[] inicioCelula;
+}
+
+void TabelaLogradouros::montarArraysPorSlot() {
+    latitudes = alocarCoordenadas(numLogradouros);
+    longitudes = alocarCoordenadas(numLogradouros);
+    inicioLinha = new int[numLogradouros + 1];
+
+    // Cada linha é "IdLog;nome\n"; o IdLog tem no máximo TAMANHO_MAXIMO_INTEIRO caracteres
+    char id[TAMANHO_MAXIMO_INTEIRO];
+    tamanhoLinhas = 0;
+    for (int slot = 0; slot < numLogradouros; slot++) {
+        latitudes[slot] = logradouros[slot]->getLatMedia();
+        longitudes[slot] = logradouros[slot]->getLonMedia();
+        inicioLinha[slot] = tamanhoLinhas;
+        tamanhoLinhas += formatarInteiro(ids[slot], id) + 1 +
+                         static_cast<int>(logradouros[slot]->getNome().size()) + 1;
+    }
+    inicioLinha[numLogradouros] = tamanhoLinhas;
+
+    linhasSaida = new char[tamanhoLinhas > 0 ? tamanhoLinhas : 1];
+    for (int slot = 0; slot < numLogradouros; slot++) {
+        char* destino = linhasSaida + inicioLinha[slot];
+        destino += formatarInteiro(ids[slot], destino);
+        *destino++ = ';';
+        const std::string& nome = logradouros[slot]->getNome();
+        destino += nome.copy(destino, nome.size());
+        *destino = '\n';
+    }
+    montarVetoresUnitarios();
+}
+
+void TabelaLogradouros::montarVetoresUnitarios() {
+    if (!Metrica::GEODESICA) {
+        return;
+    }
+    vetores = alocarCoordenadas(numLogradouros * COMPONENTES_VETOR);
+
+    // Os limites de grande círculo da grade supõem latitudes em [-90, 90] e
+    // uma grade que não dá a volta no globo (até 180 graus de longitude)
+    podaGeodesica = colunasGrade * ladoCelula <= 180.0;
+    for (int slot = 0; slot < numLogradouros; slot++) {
+        double* vetor = vetores + static_cast<long long>(slot) * COMPONENTES_VETOR;
+        MetricaGeodesica::vetorUnitario(latitudes[slot], longitudes[slot], vetor);
+        vetor[3] = 0.0;
+        if (std::fabs(latitudes[slot]) > 90.0 && std::isfinite(longitudes[slot])) {
+            podaGeodesica = false;
+        }
+    }
+}
+
+void TabelaLogradouros::particionarPorGrade() {
+    // Caixa envolvente dos centros de gravidade com coordenadas finitas
+    int numFinitos = 0;
+    double latMaxima = 0.0;
+    double lonMaxima = 0.0;
+    for (int i = 0; i < numLogradouros; i++) {
+        double lat = logradouros[i]->getLatMedia();
+        double lon = logradouros[i]->getLonMedia();
+        if (!std::isfinite(lat) || !std::isfinite(lon)) {
+            continue;
+        }
+        if (numFinitos == 0 || lat < latMinima) latMinima = lat;
+        if (numFinitos == 0 || lat > latMaxima) latMaxima = lat;
+        if (numFinitos == 0 || lon < lonMinima) lonMinima = lon;
+        if (numFinitos == 0 || lon > lonMaxima) lonMaxima = lon;
+        numFinitos++;
+    }
+
+    // Células quadradas, cerca de LOGRADOUROS_POR_CELULA por célula
+    // (um eixo degenerado conta como uma única faixa de células)
+    int alvoCelulas = numFinitos / LOGRADOUROS_POR_CELULA;
+    if (alvoCelulas < 1) {
+        alvoCelulas = 1;
+    }
+    double extensaoLat = latMaxima - latMinima;
+    double extensaoLon = lonMaxima - lonMinima;
+    double extensao = extensaoLat > extensaoLon ? extensaoLat : extensaoLon;
+    if (extensao > 0.0 && std::isfinite(extensao)) {
+        double minimo = extensao / alvoCelulas;
+        double ladoLat = extensaoLat > minimo ? extensaoLat : minimo;
+        double ladoLon = extensaoLon > minimo ? extensaoLon : minimo;
+        ladoCelula = std::sqrt(ladoLat * ladoLon / alvoCelulas);
+        double linhas = std::floor(extensaoLat / ladoCelula) + 1;
+        double colunas = std::floor(extensaoLon / ladoCelula) + 1;
+        linhasGrade = linhas < alvoCelulas + 1 ? static_cast<int>(linhas) : alvoCelulas + 1;
+        colunasGrade = colunas < alvoCelulas + 1 ? static_cast<int>(colunas) : alvoCelulas + 1;
+    }
+    folgaLimite = 1e-12 * (1.0 + std::fabs(latMinima) + std::fabs(latMaxima) +
+                           std::fabs(lonMinima) + std::fabs(lonMaxima));
+
+    // Célula de cada slot; a faixa extra (numCelulas) recebe os não finitos
+    int numCelulas = linhasGrade * colunasGrade;
+    int* celulaDoSlot = new int[numLogradouros];
+    inicioCelula = new int[numCelulas + 2];
+    for (int c = 0; c < numCelulas + 2; c++) {
+        inicioCelula[c] = 0;
+    }
+    for (int i = 0; i < numLogradouros; i++) {
+        double lat = logradouros[i]->getLatMedia();
+        double lon = logradouros[i]->getLonMedia();
+        if (std::isfinite(lat) && std::isfinite(lon)) {
+            int linha, coluna;
+            localizarCelula(lat, lon, linha, coluna);
+            celulaDoSlot[i] = linha * colunasGrade + coluna;
+        } else {
+            celulaDoSlot[i] = numCelulas;
+        }
+        inicioCelula[celulaDoSlot[i] + 1]++;
+    }
+    for (int c = 0; c <= numCelulas; c++) {
+        inicioCelula[c + 1] += inicioCelula[c];
+    }
+
+    // Counting sort estável por célula: dentro da célula, segue a ordem de IdLog
+    Logradouro** novosLogradouros = new Logradouro*[numLogradouros];
+    int* novosIds = new int[numLogradouros];
+    int* posicao = new int[numCelulas + 1];
+    for (int c = 0; c <= numCelulas; c++) {
+        posicao[c] = inicioCelula[c];
+    }
+    for (int i = 0; i < numLogradouros; i++) {
+        int destino = posicao[celulaDoSlot[i]]++;
+        novosLogradouros[destino] = logradouros[i];
+        novosIds[destino] = ids[i];
+    }
+    delete[] posicao;
+    delete[] celulaDoSlot;
+    delete[] logradouros;
+    delete[] ids;
+    logradouros = novosLogradouros;
+    ids = novosIds;
+}
+
+int TabelaLogradouros::buscarSlotBinaria(int idLog) const {
+    int baixo = 0;
+    int alto = numLogradouros - 1;
+    while (baixo <= alto) {
+        int meio = baixo + (alto - baixo) / 2;
+        if (idsOrdenados[meio] == idLog) {
+            return slotsOrdenados[meio];
+        } else if (idsOrdenados[meio] < idLog) {
+            baixo = meio + 1;
+        } else {
+            alto = meio - 1;
+        }
+    }
+    return -1;
+}
+
+int TabelaLogradouros::buscarSlot(int idLog) const {
+    if (slotPorId != nullptr) {
+        long long deslocamento = static_cast<long long>(idLog) - idMinimo;
+        if (deslocamento < 0 || deslocamento >= faixaIds) {
+            return -1;
+        }
+        return slotPorId[deslocamento];
+    }
+    return buscarSlotBinaria(idLog);
+}
+
+Logradouro* TabelaLogradouros::buscar(int idLog) const {
+    int slot = buscarSlot(idLog);
+    return slot < 0 || logradouros == nullptr ? nullptr : logradouros[slot];
+}
+
+Logradouro* TabelaLogradouros::getLogradouro(int slot) const {
+    return logradouros != nullptr ? logradouros[slot] : nullptr;
+}
+
+int TabelaLogradouros::getIdLog(int slot) const {
+    return ids[slot];
+}
+
+double TabelaLogradouros::getLatitude(int slot) const {
+    return latitudes[slot];
+}
+
+double TabelaLogradouros::getLongitude(int slot) const {
+    return longitudes[slot];
+}
+
+const double* TabelaLogradouros::getLatitudes() const {
+    return latitudes;
+}
+
+const double* TabelaLogradouros::getLongitudes() const {
+    return longitudes;
+}
+
+const double* TabelaLogradouros::getVetores() const {
+    return vetores;
+}
+
+std::string TabelaLogradouros::getNome(int slot) const {
+    // O nome fica entre o ';' depois do IdLog e o '\n' final
+    const char* linha = linhasSaida + inicioLinha[slot];
+    const char* fim = linhasSaida + inicioLinha[slot + 1] - 1;
+    const char* nome = static_cast<const char*>(std::memchr(linha, ';', fim - linha)) + 1;
+    return std::string(nome, fim - nome);
+}
+
+const char* TabelaLogradouros::getLinhaSaida(int slot, int& tamanho) const {
+    tamanho = inicioLinha[slot + 1] - inicioLinha[slot];
+    return linhasSaida + inicioLinha[slot];
+}
+
+void TabelaLogradouros::exportar(DadosTabelaLogradouros& saida) const {
+    saida.numLogradouros = numLogradouros;
+    saida.ids = ids;
+    saida.latitudes = latitudes;
+    saida.longitudes = longitudes;
+    saida.linhasSaida = linhasSaida;
+    saida.tamanhoLinhas = tamanhoLinhas;
+    saida.inicioLinha = inicioLinha;
+    saida.slotPorId = slotPorId;
+    saida.idMinimo = idMinimo;
+    saida.faixaIds = faixaIds;
+    saida.idsOrdenados = idsOrdenados;
+    saida.slotsOrdenados = slotsOrdenados;
+    saida.latMinima = latMinima;
+    saida.lonMinima = lonMinima;
+    saida.ladoCelula = ladoCelula;
+    saida.folgaLimite = folgaLimite;
+    saida.linhasGrade = linhasGrade;
+    saida.colunasGrade = colunasGrade;
+    saida.inicioCelula = inicioCelula;
+}
+
+int TabelaLogradouros::getTamanho() const {
+    return numLogradouros;
+}
+
+int TabelaLogradouros::getLinhasGrade() const {
+    return linhasGrade;
+}
+
+int TabelaLogradouros::getColunasGrade() const {
+    return colunasGrade;
+}
+
+int TabelaLogradouros::getNumCelulas() const {
+    return linhasGrade * colunasGrade;
+}
+
+int TabelaLogradouros::getInicioCelula(int celula) const {
+    return inicioCelula[celula];
+}
+
+void TabelaLogradouros::localizarCelula(double lat, double lon, int& linha, int& coluna) const {
+    double l = (lat - latMinima) / ladoCelula;
+    double c = (lon - lonMinima) / ladoCelula;
+
+    // Negativos e NaN vão para a primeira linha/coluna
+    if (!(l > 0.0)) l = 0.0;
+    if (!(c > 0.0)) c = 0.0;
+    linha = l < linhasGrade - 1 ? static_cast<int>(l) : linhasGrade - 1;
+    coluna = c < colunasGrade - 1 ? static_cast<int>(c) : colunasGrade - 1;
+}
+
+double TabelaLogradouros::distanciaMinimaForaDoQuadro(double lat, double lon,
+                                                       int linha, int coluna, int raio) const {
+    // Cada lado do quadro com células além dele limita a distância pelo
+    // afastamento em uma só coordenada (|dLat| e |dLon| nunca excedem a distância)
+    double minimo = -1.0;
+    double limites[4];
+    bool latitude[4];
+    int numLimites = 0;
+
+    if (linha + raio + 1 < linhasGrade) {
+        latitude[numLimites] = true;
+        limites[numLimites++] = latMinima + (linha + raio + 1) * ladoCelula - lat;
+    }
+    if (linha - raio - 1 >= 0) {
+        latitude[numLimites] = true;
+        limites[numLimites++] = lat - (latMinima + (linha - raio) * ladoCelula);
+    }
+    if (coluna + raio + 1 < colunasGrade) {
+        latitude[numLimites] = false;
+        limites[numLimites++] = lonMinima + (coluna + raio + 1) * ladoCelula - lon;
+    }
+    if (coluna - raio - 1 >= 0) {
+        latitude[numLimites] = false;
+        limites[numLimites++] = lon - (lonMinima + (coluna - raio) * ladoCelula);
+    }
+
+    // Métrica geodésica: um afastamento de d graus em latitude é um ângulo
+    // central de ao menos d; além do meridiano a d graus de longitude, o
+    // ângulo é ao menos a distância até esse meridiano, asen(cos(lat) sen(d)),
+    // que por sua vez é ao menos cos(lat) sen(d). Os limites usam cotas
+    // inferiores polinomiais de seno e cosseno, sem trigonometria por anel
+    bool geodesica = Metrica::GEODESICA;
+    bool podar = !geodesica || (podaGeodesica && std::fabs(lat) <= 90.0);
+    double cossenoLat = geodesica ? cossenoInferior(lat * GRAUS_PARA_RADIANOS) : 1.0;
+
+    for (int i = 0; i < numLimites; i++) {
+        double limite = limites[i] - folgaLimite;
+        if (!(limite > 0.0) || !podar) {
+            limite = 0.0;
+        } else if (geodesica) {
+            double angulo = limite * GRAUS_PARA_RADIANOS;
+            if (!latitude[i]) {
+                angulo = cossenoLat * senoInferior(angulo);
+            }
+            // corda = 2 sen(angulo / 2)
+            limite = 2.0 * senoInferior(0.5 * angulo) - FOLGA_CORDA;
+            if (!(limite > 0.0)) {
+                limite = 0.0;
+            }
+        }
+        if (minimo < 0.0 || limite < minimo) {
+            minimo = limite;
+        }
+    }
+    return minimo;
+}
\ No newline at end of file
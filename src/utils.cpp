@@ -1,4 +1,8 @@
 #include "utils.hpp"
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <climits>
 
 double calcularDistancia(double lat1, double lon1, double lat2, double lon2) {
     double deltaLat = lat2 - lat1;
@@ -64,6 +68,197 @@ std::string trim(const std::string& str) {
     return str.substr(inicio, fim - inicio + 1);
 }
 
+bool converterInteiro(const char* str, int tamanho, int& valor) {
+    int i = 0;
+    bool negativo = false;
+    if (i < tamanho && (str[i] == '-' || str[i] == '+')) {
+        negativo = str[i] == '-';
+        i++;
+    }
+    if (i == tamanho) {
+        return false;
+    }
+
+    // Zeros à esquerda não contam para o limite de dígitos
+    while (i < tamanho - 1 && str[i] == '0') {
+        i++;
+    }
+    if (tamanho - i > 10) {
+        return false;
+    }
+
+    // Até 10 dígitos cabem em 64 bits sem verificação dentro do laço
+    uint64_t acumulado = 0;
+    for (; i < tamanho; i++) {
+        unsigned digito = static_cast<unsigned>(static_cast<unsigned char>(str[i])) - '0';
+        if (digito > 9) {
+            return false;
+        }
+        acumulado = acumulado * 10 + digito;
+    }
+
+    uint64_t limite = negativo ? static_cast<uint64_t>(INT_MAX) + 1 : static_cast<uint64_t>(INT_MAX);
+    if (acumulado > limite) {
+        return false;
+    }
+    valor = negativo ? static_cast<int>(-static_cast<int64_t>(acumulado)) : static_cast<int>(acumulado);
+    return true;
+}
+
+// Potências de 10 representáveis exatamente em double
+static const double POTENCIAS_EXATAS_10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+static const int EXPOENTE_EXATO_MAXIMO = 22;
+static const uint64_t MANTISSA_EXATA_MAXIMA = 1ULL << 53;
+static const int DIGITOS_MANTISSA_MAXIMOS = 19;
+
+bool converterDouble(const char* str, int tamanho, double& valor) {
+    int i = 0;
+    bool negativo = false;
+    if (i < tamanho && (str[i] == '-' || str[i] == '+')) {
+        negativo = str[i] == '-';
+        i++;
+    }
+
+    // Mantissa decimal inteira (até 19 dígitos significativos) e expoente
+    uint64_t mantissa = 0;
+    int digitos = 0;
+    int expoente = 0;
+    bool truncado = false;
+    bool algumDigito = false;
+
+    for (; i < tamanho; i++) {
+        unsigned digito = static_cast<unsigned>(static_cast<unsigned char>(str[i])) - '0';
+        if (digito > 9) {
+            break;
+        }
+        algumDigito = true;
+        if (digitos < DIGITOS_MANTISSA_MAXIMOS) {
+            mantissa = mantissa * 10 + digito;
+            digitos += mantissa != 0;
+        } else {
+            expoente++;
+            truncado |= digito != 0;
+        }
+    }
+
+    if (i < tamanho && str[i] == '.') {
+        i++;
+        for (; i < tamanho; i++) {
+            unsigned digito = static_cast<unsigned>(static_cast<unsigned char>(str[i])) - '0';
+            if (digito > 9) {
+                break;
+            }
+            algumDigito = true;
+            if (digitos < DIGITOS_MANTISSA_MAXIMOS) {
+                mantissa = mantissa * 10 + digito;
+                digitos += mantissa != 0;
+                expoente--;
+            } else {
+                truncado |= digito != 0;
+            }
+        }
+    }
+
+    if (!algumDigito) {
+        return false;
+    }
+
+    if (i < tamanho && (str[i] == 'e' || str[i] == 'E')) {
+        i++;
+        bool expoenteNegativo = false;
+        if (i < tamanho && (str[i] == '-' || str[i] == '+')) {
+            expoenteNegativo = str[i] == '-';
+            i++;
+        }
+        if (i == tamanho) {
+            return false;
+        }
+        int expoenteLido = 0;
+        for (; i < tamanho; i++) {
+            unsigned digito = static_cast<unsigned>(static_cast<unsigned char>(str[i])) - '0';
+            if (digito > 9) {
+                return false;
+            }
+            // Além disso o resultado já é 0 ou infinito
+            if (expoenteLido < 100000) {
+                expoenteLido = expoenteLido * 10 + static_cast<int>(digito);
+            }
+        }
+        expoente += expoenteNegativo ? -expoenteLido : expoenteLido;
+    }
+
+    if (i != tamanho) {
+        return false;
+    }
+
+    // Caminho rápido (Clinger): mantissa e 10^|expoente| exatos em double,
+    // então uma única multiplicação ou divisão já arredonda corretamente
+    if (!truncado && mantissa <= MANTISSA_EXATA_MAXIMA &&
+        expoente >= -EXPOENTE_EXATO_MAXIMO && expoente <= EXPOENTE_EXATO_MAXIMO) {
+        double resultado = static_cast<double>(mantissa);
+        if (expoente < 0) {
+            resultado /= POTENCIAS_EXATAS_10[-expoente];
+        } else {
+            resultado *= POTENCIAS_EXATAS_10[expoente];
+        }
+        valor = negativo ? -resultado : resultado;
+        return true;
+    }
+
+    // Demais casos (raros nas coordenadas): strtod sobre uma cópia terminada
+    // em '\0', já validada acima
+    char local[64];
+    std::string longa;
+    const char* texto = local;
+    if (tamanho < static_cast<int>(sizeof(local))) {
+        std::memcpy(local, str, tamanho);
+        local[tamanho] = '\0';
+    } else {
+        longa.assign(str, tamanho);
+        texto = longa.c_str();
+    }
+    valor = std::strtod(texto, nullptr);
+    return true;
+}
+
+// Pares de dígitos "00".."99": formata dois dígitos por divisão
+static const char PARES_DIGITOS[] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+int formatarInteiro(int valor, char* destino) {
+    char* inicio = destino;
+    uint32_t absoluto = static_cast<uint32_t>(valor);
+    if (valor < 0) {
+        *destino++ = '-';
+        absoluto = 0u - absoluto;
+    }
+
+    // Escreve de trás para frente num buffer local e copia
+    char digitos[10];
+    int posicao = 10;
+    while (absoluto >= 100) {
+        uint32_t par = (absoluto % 100) * 2;
+        absoluto /= 100;
+        digitos[--posicao] = PARES_DIGITOS[par + 1];
+        digitos[--posicao] = PARES_DIGITOS[par];
+    }
+    if (absoluto >= 10) {
+        digitos[--posicao] = PARES_DIGITOS[absoluto * 2 + 1];
+        digitos[--posicao] = PARES_DIGITOS[absoluto * 2];
+    } else {
+        digitos[--posicao] = static_cast<char>('0' + absoluto);
+    }
+
+    std::memcpy(destino, digitos + posicao, 10 - posicao);
+    destino += 10 - posicao;
+    return static_cast<int>(destino - inicio);
+}
+
 int stringParaInt(const std::string& str) {
     int resultado = 0;
     int sinal = 1;
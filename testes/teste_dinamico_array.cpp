@@ -0,0 +1,265 @@
+/**
+ * Testes do DinamicoArray
+ *
+ * Cobre reserve, resize e emplace_back, o crescimento por movimentação de
+ * tipos não triviais (o conteúdo das strings sobrevive e nada é copiado) e o
+ * caminho com realloc dos tipos trivialmente copiáveis.
+ *
+ * Uso: bin/teste_dinamico_array.out (código de saída 1 se algum falhar)
+ */
+
+#include "dinamico_array.hpp"
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+static int falhas = 0;
+
+/**
+ * Registra uma verificação; mostra a linha das que falham
+ */
+static void verificar(bool condicao, const char* descricao, int linha) {
+    if (!condicao) {
+        std::cerr << "FALHOU (linha " << linha << "): " << descricao << std::endl;
+        falhas++;
+    }
+}
+
+#define VERIFICAR(condicao) verificar((condicao), #condicao, __LINE__)
+
+/**
+ * Tipo não trivial que conta construções, cópias, movimentações e
+ * destruições, para conferir como o array trata os elementos
+ */
+struct Contado {
+    std::string texto;
+
+    static int vivos;
+    static int copias;
+    static int movimentos;
+
+    Contado() : texto("padrao") { vivos++; }
+    explicit Contado(const std::string& texto) : texto(texto) { vivos++; }
+    Contado(const Contado& outro) : texto(outro.texto) { vivos++; copias++; }
+    Contado(Contado&& outro) : texto(std::move(outro.texto)) { vivos++; movimentos++; }
+    ~Contado() { vivos--; }
+
+    static void zerar() {
+        copias = 0;
+        movimentos = 0;
+    }
+
+private:
+    Contado& operator=(const Contado&);
+};
+
+int Contado::vivos = 0;
+int Contado::copias = 0;
+int Contado::movimentos = 0;
+
+/**
+ * Tipo trivialmente copiável: cresce pelo caminho com realloc
+ */
+struct Ponto {
+    int id;
+    double lat;
+    double lon;
+};
+
+static_assert(std::is_trivially_copyable<Ponto>::value, "Ponto deve usar o caminho com realloc");
+static_assert(!std::is_trivially_copyable<Contado>::value, "Contado deve usar o caminho com movimentação");
+
+/**
+ * Texto longo o bastante para ficar fora do buffer interno da string
+ */
+static std::string textoDe(int i) {
+    return "logradouro numero " + std::to_string(i) + " com nome longo o bastante";
+}
+
+static void testarReserve() {
+    DinamicoArray<int> a;
+    VERIFICAR(a.size() == 0);
+    VERIFICAR(a.capacity() == 0);
+    VERIFICAR(a.empty());
+
+    a.reserve(100);
+    VERIFICAR(a.capacity() == 100);
+    VERIFICAR(a.size() == 0);
+
+    // Dentro da capacidade reservada não há realocação
+    int* antes = a.data();
+    for (int i = 0; i < 100; i++) {
+        a.push_back(i);
+    }
+    VERIFICAR(a.data() == antes);
+    VERIFICAR(a.capacity() == 100);
+
+    // Reservar menos que a capacidade não muda nada
+    a.reserve(10);
+    VERIFICAR(a.capacity() == 100);
+    VERIFICAR(a.size() == 100);
+    VERIFICAR(a[99] == 99);
+}
+
+static void testarResize() {
+    DinamicoArray<int> a;
+    a.resize(5);
+    VERIFICAR(a.size() == 5);
+    bool zerados = true;
+    for (int i = 0; i < 5; i++) {
+        zerados = zerados && a[i] == 0;
+    }
+    VERIFICAR(zerados);
+
+    for (int i = 0; i < 5; i++) {
+        a[i] = i + 1;
+    }
+    a.resize(2);
+    VERIFICAR(a.size() == 2);
+    VERIFICAR(a[0] == 1 && a[1] == 2);
+
+    a.resize(4);
+    VERIFICAR(a.size() == 4);
+    VERIFICAR(a[0] == 1 && a[1] == 2 && a[2] == 0 && a[3] == 0);
+
+    // resize(size() + 1) repetido cresce geometricamente
+    DinamicoArray<int> b;
+    int realocacoes = 0;
+    int capacidade = b.capacity();
+    for (int i = 0; i < 100000; i++) {
+        b.resize(b.size() + 1);
+        if (b.capacity() != capacidade) {
+            realocacoes++;
+            capacidade = b.capacity();
+        }
+    }
+    VERIFICAR(b.size() == 100000);
+    VERIFICAR(realocacoes < 40);
+
+    // Com tipo não trivial: posições novas recebem T() e as excedentes são
+    // destruídas
+    {
+        DinamicoArray<Contado> c;
+        c.resize(3);
+        VERIFICAR(Contado::vivos == 3);
+        VERIFICAR(c[2].texto == "padrao");
+        c.resize(1);
+        VERIFICAR(Contado::vivos == 1);
+        c.clear();
+        VERIFICAR(Contado::vivos == 0);
+        VERIFICAR(c.empty());
+    }
+    VERIFICAR(Contado::vivos == 0);
+}
+
+static void testarEmplaceBack() {
+    DinamicoArray<Contado> a;
+    Contado::zerar();
+    Contado& novo = a.emplace_back(textoDe(0));
+    VERIFICAR(&novo == &a[0]);
+    VERIFICAR(a[0].texto == textoDe(0));
+    // Construído no lugar: sem cópia
+    VERIFICAR(Contado::copias == 0);
+
+    // Argumento que referencia o próprio array, no momento em que ele cresce
+    DinamicoArray<std::string> b;
+    b.push_back(textoDe(1));
+    while (b.size() < b.capacity()) {
+        b.push_back(textoDe(b.size() + 1));
+    }
+    int capacidade = b.capacity();
+    b.emplace_back(b[0]);
+    VERIFICAR(b.capacity() > capacidade);
+    VERIFICAR(b[b.size() - 1] == textoDe(1));
+    VERIFICAR(b[0] == textoDe(1));
+}
+
+static void testarCrescimentoPorMovimentacao() {
+    const int n = 5000;
+    {
+        DinamicoArray<Contado> a;
+        for (int i = 0; i < n; i++) {
+            a.emplace_back(textoDe(i));
+        }
+        Contado::zerar();
+        a.reserve(4 * a.capacity());
+
+        // A realocação move cada elemento e não copia nenhum
+        VERIFICAR(Contado::copias == 0);
+        VERIFICAR(Contado::movimentos == n);
+        VERIFICAR(Contado::vivos == n);
+
+        bool intactos = true;
+        for (int i = 0; i < n; i++) {
+            intactos = intactos && a[i].texto == textoDe(i);
+        }
+        VERIFICAR(intactos);
+    }
+    VERIFICAR(Contado::vivos == 0);
+
+    // std::string direto, crescendo por várias duplicações
+    DinamicoArray<std::string> b;
+    for (int i = 0; i < n; i++) {
+        b.push_back(textoDe(i));
+    }
+    VERIFICAR(b.size() == n);
+    bool intactas = true;
+    for (int i = 0; i < n; i++) {
+        intactas = intactas && b[i] == textoDe(i);
+    }
+    VERIFICAR(intactas);
+}
+
+static void testarCrescimentoComRealloc() {
+    const int n = 100000;
+    DinamicoArray<Ponto> a;
+    int realocacoes = 0;
+    int capacidade = a.capacity();
+    for (int i = 0; i < n; i++) {
+        Ponto p = {i, -19.0 - i * 1e-6, -43.0 + i * 1e-6};
+        a.push_back(p);
+        if (a.capacity() != capacidade) {
+            realocacoes++;
+            capacidade = a.capacity();
+        }
+    }
+    VERIFICAR(a.size() == n);
+    VERIFICAR(realocacoes > 1);
+
+    // Os bytes copiados pelo realloc preservam cada elemento
+    bool intactos = true;
+    for (int i = 0; i < n; i++) {
+        intactos = intactos && a[i].id == i && a[i].lat == -19.0 - i * 1e-6 &&
+                   a[i].lon == -43.0 + i * 1e-6;
+    }
+    VERIFICAR(intactos);
+
+    // reserve e resize sobre um array com conteúdo também passam pelo realloc
+    a.reserve(3 * n);
+    a.resize(2 * n);
+    VERIFICAR(a.size() == 2 * n);
+    VERIFICAR(a[n - 1].id == n - 1);
+    VERIFICAR(a[n].id == 0 && a[2 * n - 1].lat == 0.0);
+
+    int soma = 0;
+    for (const Ponto& p : a) {
+        soma += p.id > 0 ? 1 : 0;
+    }
+    VERIFICAR(soma == n - 1);
+}
+
+int main() {
+    testarReserve();
+    testarResize();
+    testarEmplaceBack();
+    testarCrescimentoPorMovimentacao();
+    testarCrescimentoComRealloc();
+
+    if (falhas > 0) {
+        std::cerr << falhas << " verificacao(oes) falharam" << std::endl;
+        return 1;
+    }
+    std::cout << "teste_dinamico_array: OK" << std::endl;
+    return 0;
+}